@@ -31,6 +31,7 @@
 #include "asio/basic_deadline_timer.hpp"
 #include "asio/basic_file.hpp"
 #include "asio/basic_io_object.hpp"
+#include "asio/basic_periodic_timer.hpp"
 #include "asio/basic_random_access_file.hpp"
 #include "asio/basic_raw_socket.hpp"
 #include "asio/basic_readable_pipe.hpp"
@@ -92,6 +93,8 @@
 #include "asio/execution/relationship.hpp"
 #include "asio/executor.hpp"
 #include "asio/executor_work_guard.hpp"
+#include "asio/fair_executor.hpp"
+#include "asio/handler_arena.hpp"
 #include "asio/file_base.hpp"
 #include "asio/generic/basic_endpoint.hpp"
 #include "asio/generic/datagram_protocol.hpp"
@@ -100,6 +103,7 @@
 #include "asio/generic/stream_protocol.hpp"
 #include "asio/handler_continuation_hook.hpp"
 #include "asio/high_resolution_timer.hpp"
+#include "asio/inline_executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/io_context_strand.hpp"
 #include "asio/io_service.hpp"
@@ -138,8 +142,12 @@
 #include "asio/local/datagram_protocol.hpp"
 #include "asio/local/seq_packet_protocol.hpp"
 #include "asio/local/stream_protocol.hpp"
+#include "asio/memory_resource.hpp"
 #include "asio/multiple_exceptions.hpp"
+#include "asio/offload.hpp"
 #include "asio/packaged_task.hpp"
+#include "asio/periodic_timer.hpp"
+#include "asio/periodic_timer_base.hpp"
 #include "asio/placeholders.hpp"
 #include "asio/posix/basic_descriptor.hpp"
 #include "asio/posix/basic_stream_descriptor.hpp"
@@ -158,6 +166,7 @@
 #include "asio/recycling_allocator.hpp"
 #include "asio/redirect_error.hpp"
 #include "asio/registered_buffer.hpp"
+#include "asio/registered_buffer_pool.hpp"
 #include "asio/require.hpp"
 #include "asio/require_concept.hpp"
 #include "asio/serial_port.hpp"
@@ -175,6 +184,7 @@
 #include "asio/system_executor.hpp"
 #include "asio/system_timer.hpp"
 #include "asio/this_coro.hpp"
+#include "asio/this_thread_should_yield.hpp"
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
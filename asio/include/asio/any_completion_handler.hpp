@@ -114,6 +114,28 @@ public:
     d(this);
   }
 
+  template <typename S, typename H>
+  static any_completion_handler_impl* create_inline(
+      void* storage, S&& slot, H&& h)
+  {
+    return new (storage) any_completion_handler_impl(
+        static_cast<S&&>(slot), static_cast<H&&>(h));
+  }
+
+  void destroy_inline()
+  {
+    this->~any_completion_handler_impl();
+  }
+
+  any_completion_handler_impl* relocate_inline(void* storage)
+  {
+    any_completion_handler_impl* ptr = new (storage)
+      any_completion_handler_impl(
+          static_cast<any_completion_handler_impl&&>(*this));
+    this->~any_completion_handler_impl();
+    return ptr;
+  }
+
   any_completion_executor executor(
       const any_completion_executor& candidate) const noexcept
   {
@@ -190,6 +212,25 @@ public:
         static_cast<Args&&>(args)...);
   }
 
+  template <typename... Args>
+  void call_inline(Args&&... args)
+  {
+    // Destroy the stored handler once it has been moved from, even if the
+    // move throws.
+    struct on_exit
+    {
+      ~on_exit() { if (impl_) impl_->destroy_inline(); }
+      any_completion_handler_impl* impl_;
+    } destroy_on_exit = { this };
+
+    Handler handler(static_cast<Handler&&>(handler_));
+    destroy_on_exit.impl_ = 0;
+    destroy_inline();
+
+    static_cast<Handler&&>(handler)(
+        static_cast<Args&&>(args)...);
+  }
+
 private:
   Handler handler_;
 };
@@ -220,6 +261,14 @@ public:
         static_cast<Args&&>(args)...);
   }
 
+  template <typename Handler>
+  static void inline_impl(any_completion_handler_impl_base* impl,
+      Args... args)
+  {
+    static_cast<any_completion_handler_impl<Handler>*>(impl)->call_inline(
+        static_cast<Args&&>(args)...);
+  }
+
 private:
   type call_fn_;
 };
@@ -275,6 +324,12 @@ public:
     static_cast<any_completion_handler_impl<Handler>*>(impl)->destroy();
   }
 
+  template <typename Handler>
+  static void inline_impl(any_completion_handler_impl_base* impl)
+  {
+    static_cast<any_completion_handler_impl<Handler>*>(impl)->destroy_inline();
+  }
+
 private:
   type destroy_fn_;
 };
@@ -448,11 +503,113 @@ template <typename Handler, typename... Signatures>
 constexpr any_completion_handler_fn_table<Signatures...>
 any_completion_handler_fn_table_instance<Handler, Signatures...>::value;
 
+class any_completion_handler_relocate_fn
+{
+public:
+  using type = any_completion_handler_impl_base*(*)(
+      any_completion_handler_impl_base*, void*);
+
+  constexpr any_completion_handler_relocate_fn(type fn)
+    : relocate_fn_(fn)
+  {
+  }
+
+  bool is_inline() const noexcept
+  {
+    return relocate_fn_ != nullptr;
+  }
+
+  any_completion_handler_impl_base* relocate(
+      any_completion_handler_impl_base* impl, void* storage) const
+  {
+    return relocate_fn_(impl, storage);
+  }
+
+  template <typename Handler>
+  static any_completion_handler_impl_base* impl(
+      any_completion_handler_impl_base* impl, void* storage)
+  {
+    return static_cast<any_completion_handler_impl<Handler>*>(
+        impl)->relocate_inline(storage);
+  }
+
+private:
+  type relocate_fn_;
+};
+
+// The function table used by inline_any_completion_handler. A null relocate
+// function indicates that the target is held in allocated memory rather than
+// in the wrapper's inline storage.
+template <typename... Signatures>
+class any_completion_handler_inline_fn_table
+  : public any_completion_handler_fn_table<Signatures...>,
+    public any_completion_handler_relocate_fn
+{
+public:
+  template <typename... CallFns>
+  constexpr any_completion_handler_inline_fn_table(
+      any_completion_handler_relocate_fn::type relocate_fn,
+      any_completion_handler_destroy_fn::type destroy_fn,
+      any_completion_handler_executor_fn::type executor_fn,
+      any_completion_handler_immediate_executor_fn::type immediate_executor_fn,
+      any_completion_handler_allocate_fn::type allocate_fn,
+      any_completion_handler_deallocate_fn::type deallocate_fn,
+      CallFns... call_fns)
+    : any_completion_handler_fn_table<Signatures...>(destroy_fn, executor_fn,
+        immediate_executor_fn, allocate_fn, deallocate_fn, call_fns...),
+      any_completion_handler_relocate_fn(relocate_fn)
+  {
+  }
+};
+
+template <typename Handler, bool Inline, typename... Signatures>
+struct any_completion_handler_inline_fn_table_instance
+{
+  static constexpr any_completion_handler_inline_fn_table<Signatures...>
+    value = any_completion_handler_inline_fn_table<Signatures...>(
+        &any_completion_handler_relocate_fn::impl<Handler>,
+        &any_completion_handler_destroy_fn::inline_impl<Handler>,
+        &any_completion_handler_executor_fn::impl<Handler>,
+        &any_completion_handler_immediate_executor_fn::impl<Handler>,
+        &any_completion_handler_allocate_fn::impl<Handler>,
+        &any_completion_handler_deallocate_fn::impl<Handler>,
+        &any_completion_handler_call_fn<
+          Signatures>::template inline_impl<Handler>...);
+};
+
+template <typename Handler, typename... Signatures>
+struct any_completion_handler_inline_fn_table_instance<
+    Handler, false, Signatures...>
+{
+  static constexpr any_completion_handler_inline_fn_table<Signatures...>
+    value = any_completion_handler_inline_fn_table<Signatures...>(
+        nullptr,
+        &any_completion_handler_destroy_fn::impl<Handler>,
+        &any_completion_handler_executor_fn::impl<Handler>,
+        &any_completion_handler_immediate_executor_fn::impl<Handler>,
+        &any_completion_handler_allocate_fn::impl<Handler>,
+        &any_completion_handler_deallocate_fn::impl<Handler>,
+        &any_completion_handler_call_fn<Signatures>::template impl<Handler>...);
+};
+
+template <typename Handler, bool Inline, typename... Signatures>
+constexpr any_completion_handler_inline_fn_table<Signatures...>
+any_completion_handler_inline_fn_table_instance<
+  Handler, Inline, Signatures...>::value;
+
+template <typename Handler, typename... Signatures>
+constexpr any_completion_handler_inline_fn_table<Signatures...>
+any_completion_handler_inline_fn_table_instance<
+  Handler, false, Signatures...>::value;
+
 } // namespace detail
 
 template <typename... Signatures>
 class any_completion_handler;
 
+template <std::size_t InlineSize, typename... Signatures>
+class inline_any_completion_handler;
+
 /// An allocator type that forwards memory allocation operations through an
 /// instance of @c any_completion_handler.
 template <typename T, typename... Signatures>
@@ -462,6 +619,9 @@ private:
   template <typename...>
   friend class any_completion_handler;
 
+  template <std::size_t, typename...>
+  friend class inline_any_completion_handler;
+
   template <typename, typename...>
   friend class any_completion_handler_allocator;
 
@@ -475,6 +635,14 @@ private:
   {
   }
 
+  constexpr any_completion_handler_allocator(int,
+      const detail::any_completion_handler_fn_table<Signatures...>* fn_table,
+      detail::any_completion_handler_impl_base* impl) noexcept
+    : fn_table_(fn_table),
+      impl_(impl)
+  {
+  }
+
 public:
   /// The type of objects that may be allocated by the allocator.
   typedef T value_type;
@@ -542,6 +710,9 @@ private:
   template <typename...>
   friend class any_completion_handler;
 
+  template <std::size_t, typename...>
+  friend class inline_any_completion_handler;
+
   template <typename, typename...>
   friend class any_completion_handler_allocator;
 
@@ -555,6 +726,14 @@ private:
   {
   }
 
+  constexpr any_completion_handler_allocator(int,
+      const detail::any_completion_handler_fn_table<Signatures...>* fn_table,
+      detail::any_completion_handler_impl_base* impl) noexcept
+    : fn_table_(fn_table),
+      impl_(impl)
+  {
+  }
+
 public:
   /// @c void as no objects can be allocated through a proto-allocator.
   typedef void value_type;
@@ -815,6 +994,294 @@ struct associated_immediate_executor<
   }
 };
 
+/// Polymorphic wrapper for completion handlers, with inline storage for small
+/// targets.
+/**
+ * The @c inline_any_completion_handler class template provides the same
+ * interface as @c any_completion_handler. Unlike @c any_completion_handler,
+ * it stores its target within the wrapper object itself when the target fits
+ * within @c InlineSize bytes. Creating, moving and invoking such a wrapper
+ * performs no memory allocation. Larger targets are stored in memory obtained
+ * from the target's associated allocator, as for @c any_completion_handler.
+ *
+ * The storage required for a target includes the target's cancellation state,
+ * which is the size of a pointer. Moving a wrapper moves an inline target, so
+ * only targets whose move constructor does not throw are stored inline.
+ */
+template <std::size_t InlineSize, typename... Signatures>
+class inline_any_completion_handler
+{
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  template <typename, typename>
+  friend struct associated_executor;
+
+  template <typename, typename>
+  friend struct associated_immediate_executor;
+
+  template <typename Handler>
+  struct fits_inline
+    : integral_constant<bool,
+        sizeof(detail::any_completion_handler_impl<Handler>) <= InlineSize
+          && alignof(detail::any_completion_handler_impl<Handler>)
+            <= ASIO_DEFAULT_ALIGN
+          && is_nothrow_move_constructible<Handler>::value>
+  {
+  };
+
+  const detail::any_completion_handler_inline_fn_table<Signatures...>*
+    fn_table_;
+  detail::any_completion_handler_impl_base* impl_;
+  alignas(ASIO_DEFAULT_ALIGN) unsigned char
+    storage_[InlineSize > 0 ? InlineSize : 1];
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+public:
+  /// The associated allocator type.
+  using allocator_type = any_completion_handler_allocator<void, Signatures...>;
+
+  /// The associated cancellation slot type.
+  using cancellation_slot_type = cancellation_slot;
+
+  /// The number of bytes of inline storage.
+  static constexpr std::size_t inline_size = InlineSize;
+
+  /// Construct an @c inline_any_completion_handler in an empty state, without
+  /// a target object.
+  constexpr inline_any_completion_handler()
+    : fn_table_(nullptr),
+      impl_(nullptr)
+  {
+  }
+
+  /// Construct an @c inline_any_completion_handler in an empty state, without
+  /// a target object.
+  constexpr inline_any_completion_handler(nullptr_t)
+    : fn_table_(nullptr),
+      impl_(nullptr)
+  {
+  }
+
+  /// Construct an @c inline_any_completion_handler to contain the specified
+  /// target.
+  template <typename H, typename Handler = decay_t<H>>
+  inline_any_completion_handler(H&& h,
+      constraint_t<
+        !is_same<decay_t<H>, inline_any_completion_handler>::value
+      > = 0)
+    : fn_table_(
+        &detail::any_completion_handler_inline_fn_table_instance<Handler,
+          fits_inline<Handler>::value, Signatures...>::value),
+      impl_(create<Handler>(static_cast<H&&>(h),
+            integral_constant<bool, fits_inline<Handler>::value>()))
+  {
+  }
+
+  /// Move-construct an @c inline_any_completion_handler from another.
+  /**
+   * After the operation, the moved-from object @c other has no target.
+   */
+  inline_any_completion_handler(inline_any_completion_handler&& other) noexcept
+    : fn_table_(nullptr),
+      impl_(nullptr)
+  {
+    take(other);
+  }
+
+  /// Move-assign an @c inline_any_completion_handler from another.
+  /**
+   * After the operation, the moved-from object @c other has no target.
+   */
+  inline_any_completion_handler& operator=(
+      inline_any_completion_handler&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  /// Assignment operator that sets the polymorphic wrapper to the empty state.
+  inline_any_completion_handler& operator=(nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  /// Destructor.
+  ~inline_any_completion_handler()
+  {
+    reset();
+  }
+
+  /// Test if the polymorphic wrapper is empty.
+  constexpr explicit operator bool() const noexcept
+  {
+    return impl_ != nullptr;
+  }
+
+  /// Test if the polymorphic wrapper is non-empty.
+  constexpr bool operator!() const noexcept
+  {
+    return impl_ == nullptr;
+  }
+
+  /// Test if the target is held in the wrapper's inline storage.
+  bool is_inline() const noexcept
+  {
+    return impl_ != nullptr && fn_table_->is_inline();
+  }
+
+  /// Swap the content of an @c inline_any_completion_handler with another.
+  void swap(inline_any_completion_handler& other) noexcept
+  {
+    inline_any_completion_handler tmp(
+        static_cast<inline_any_completion_handler&&>(other));
+    other.take(*this);
+    take(tmp);
+  }
+
+  /// Get the associated allocator.
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_type(0, fn_table_, impl_);
+  }
+
+  /// Get the associated cancellation slot.
+  cancellation_slot_type get_cancellation_slot() const noexcept
+  {
+    return impl_ ? impl_->get_cancellation_slot() : cancellation_slot_type();
+  }
+
+  /// Function call operator.
+  /**
+   * Invokes target completion handler with the supplied arguments.
+   *
+   * This function may only be called once, as the target handler is moved from.
+   * The polymorphic wrapper is left in an empty state.
+   *
+   * Throws @c std::bad_function_call if the polymorphic wrapper is empty.
+   */
+  template <typename... Args>
+  auto operator()(Args&&... args)
+    -> decltype(fn_table_->call(impl_, static_cast<Args&&>(args)...))
+  {
+    if (detail::any_completion_handler_impl_base* impl = impl_)
+    {
+      impl_ = nullptr;
+      return fn_table_->call(impl, static_cast<Args&&>(args)...);
+    }
+    std::bad_function_call ex;
+    asio::detail::throw_exception(ex);
+  }
+
+  /// Equality operator.
+  friend constexpr bool operator==(
+      const inline_any_completion_handler& a, nullptr_t) noexcept
+  {
+    return a.impl_ == nullptr;
+  }
+
+  /// Equality operator.
+  friend constexpr bool operator==(
+      nullptr_t, const inline_any_completion_handler& b) noexcept
+  {
+    return nullptr == b.impl_;
+  }
+
+  /// Inequality operator.
+  friend constexpr bool operator!=(
+      const inline_any_completion_handler& a, nullptr_t) noexcept
+  {
+    return a.impl_ != nullptr;
+  }
+
+  /// Inequality operator.
+  friend constexpr bool operator!=(
+      nullptr_t, const inline_any_completion_handler& b) noexcept
+  {
+    return nullptr != b.impl_;
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  template <typename Handler, typename H>
+  detail::any_completion_handler_impl_base* create(H&& h, true_type)
+  {
+    return detail::any_completion_handler_impl<Handler>::create_inline(
+        storage_, (get_associated_cancellation_slot)(h), static_cast<H&&>(h));
+  }
+
+  template <typename Handler, typename H>
+  detail::any_completion_handler_impl_base* create(H&& h, false_type)
+  {
+    return detail::any_completion_handler_impl<Handler>::create(
+        (get_associated_cancellation_slot)(h), static_cast<H&&>(h));
+  }
+
+  // Destroy the target, if any.
+  void reset() noexcept
+  {
+    if (impl_)
+    {
+      fn_table_->destroy(impl_);
+      fn_table_ = nullptr;
+      impl_ = nullptr;
+    }
+  }
+
+  // Take the target from another wrapper. This wrapper must be empty.
+  void take(inline_any_completion_handler& other) noexcept
+  {
+    if (other.impl_)
+    {
+      fn_table_ = other.fn_table_;
+      impl_ = fn_table_->is_inline()
+        ? fn_table_->relocate(other.impl_, storage_)
+        : other.impl_;
+      other.fn_table_ = nullptr;
+      other.impl_ = nullptr;
+    }
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
+};
+
+template <std::size_t InlineSize, typename... Signatures, typename Candidate>
+struct associated_executor<
+    inline_any_completion_handler<InlineSize, Signatures...>, Candidate>
+{
+  using type = any_completion_executor;
+
+  static type get(
+      const inline_any_completion_handler<InlineSize, Signatures...>& handler,
+      const Candidate& candidate = Candidate()) noexcept
+  {
+    any_completion_executor any_candidate(std::nothrow, candidate);
+    return handler.fn_table_
+      ? handler.fn_table_->executor(handler.impl_, any_candidate)
+      : any_candidate;
+  }
+};
+
+template <std::size_t InlineSize, typename... Signatures, typename Candidate>
+struct associated_immediate_executor<
+    inline_any_completion_handler<InlineSize, Signatures...>, Candidate>
+{
+  using type = any_completion_executor;
+
+  static type get(
+      const inline_any_completion_handler<InlineSize, Signatures...>& handler,
+      const Candidate& candidate = Candidate()) noexcept
+  {
+    any_io_executor any_candidate(std::nothrow, candidate);
+    return handler.fn_table_
+      ? handler.fn_table_->immediate_executor(handler.impl_, any_candidate)
+      : any_candidate;
+  }
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
@@ -247,6 +247,40 @@ public:
   {
     return static_cast<const base_type&>(*this).prefer(p);
   }
+
+  /// Execute the function on the target executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * execution::execute customisation point.
+   *
+   * When the target is an io_context executor that tracks outstanding work,
+   * the type-erased function object is submitted to the target directly
+   * rather than through the target's function table.
+   */
+  template <typename Function>
+  void execute(Function&& f) const
+  {
+    if (target_ && target_fns_->blocking_execute == 0)
+    {
+      execute_function(function(
+            static_cast<Function&&>(f), std::allocator<void>()));
+    }
+    else
+      base_type::execute(static_cast<Function&&>(f));
+  }
+
+private:
+  // Submit a type-erased function object to a non-blocking target.
+  ASIO_DECL void execute_function(function&& f) const;
+
+  // Get the target if it has the specified type. The target's function table
+  // is compared, as this is cheaper than comparing type information.
+  template <typename Executor>
+  const Executor* fast_target() const noexcept
+  {
+    return target_fns_ == target_fns_table<Executor>(false)
+      ? static_cast<const Executor*>(target_) : 0;
+  }
 };
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -0,0 +1,644 @@
+//
+// basic_periodic_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_PERIODIC_TIMER_HPP
+#define ASIO_BASIC_PERIODIC_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "asio/any_io_executor.hpp"
+#include "asio/append.hpp"
+#include "asio/detail/arena_handler.hpp"
+#include "asio/detail/chrono_time_traits.hpp"
+#include "asio/detail/deadline_timer_service.hpp"
+#include "asio/detail/io_object_impl.hpp"
+#include "asio/detail/periodic_wait_slot.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/periodic_timer_base.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_BASIC_PERIODIC_TIMER_FWD_DECL)
+#define ASIO_BASIC_PERIODIC_TIMER_FWD_DECL
+
+// Forward declaration with defaulted arguments.
+template <typename Clock,
+    typename WaitTraits = asio::wait_traits<Clock>,
+    typename Executor = any_io_executor>
+class basic_periodic_timer;
+
+#endif // !defined(ASIO_BASIC_PERIODIC_TIMER_FWD_DECL)
+
+/// Provides periodic timer functionality.
+/**
+ * The basic_periodic_timer class template provides the ability to wait for
+ * successive ticks of a timer that fires once per period.
+ *
+ * Unlike basic_waitable_timer, the expiry time of each wait is computed by the
+ * timer itself. In fixed_rate mode the ticks occur at fixed points in time,
+ * one period apart, measured from the first tick. A handler that runs late
+ * therefore does not delay subsequent ticks. If one or more ticks have already
+ * passed by the time the next wait is started, the most recent of them
+ * completes immediately and the number of ticks that were skipped is passed to
+ * the completion handler. In fixed_delay mode each tick occurs one period
+ * after the wait for it was started, and no ticks are ever reported missed.
+ *
+ * When a tick fires, the timer stays in the timer queue and is moved to the
+ * time of the following tick. A wait that is started before that tick passes
+ * reuses the timer's place in the queue. The wait operation for each tick is
+ * held in a block of memory that the timer keeps from one tick to the next,
+ * so that in the steady state a tick requires no allocation. Memory is
+ * obtained from the completion handler's associated allocator, or from the
+ * timer's arena, only when that block is still in use by an earlier wait.
+ *
+ * Most applications will use the asio::periodic_timer typedef.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Sending a heartbeat every second:
+ * @code
+ * void on_tick(asio::periodic_timer& timer,
+ *     const asio::error_code& error, std::size_t missed)
+ * {
+ *   if (!error)
+ *   {
+ *     send_heartbeat(missed);
+ *     timer.async_wait(
+ *         [&timer](asio::error_code e, std::size_t m)
+ *         {
+ *           on_tick(timer, e, m);
+ *         });
+ *   }
+ * }
+ *
+ * ...
+ *
+ * asio::periodic_timer timer(my_context, std::chrono::seconds(1));
+ * timer.async_wait(
+ *     [&timer](asio::error_code e, std::size_t m)
+ *     {
+ *       on_tick(timer, e, m);
+ *     });
+ * @endcode
+ */
+template <typename Clock, typename WaitTraits, typename Executor>
+class basic_periodic_timer
+  : public periodic_timer_base
+{
+private:
+  class initiate_async_wait;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the timer type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The timer type when rebound to the specified executor.
+    typedef basic_periodic_timer<Clock, WaitTraits, Executor1> other;
+  };
+
+  /// The clock type.
+  typedef Clock clock_type;
+
+  /// The duration type of the clock.
+  typedef typename clock_type::duration duration;
+
+  /// The time point type of the clock.
+  typedef typename clock_type::time_point time_point;
+
+  /// The wait traits type.
+  typedef WaitTraits traits_type;
+
+  /// Constructor.
+  /**
+   * This constructor creates a periodic timer. The first tick occurs one
+   * period after the first wait is started.
+   *
+   * @param ex The I/O executor that the timer will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the timer.
+   *
+   * @param period The interval between ticks. Must be greater than zero.
+   *
+   * @param schedule Specifies how successive ticks are scheduled.
+   */
+  basic_periodic_timer(const executor_type& ex, const duration& period,
+      schedule_type schedule = fixed_rate)
+    : impl_(0, ex),
+      period_(period),
+      schedule_(schedule),
+      started_(false),
+      slot_(0)
+  {
+  }
+
+  /// Constructor.
+  /**
+   * This constructor creates a periodic timer. The first tick occurs one
+   * period after the first wait is started.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the timer will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the timer.
+   *
+   * @param period The interval between ticks. Must be greater than zero.
+   *
+   * @param schedule Specifies how successive ticks are scheduled.
+   */
+  template <typename ExecutionContext>
+  basic_periodic_timer(ExecutionContext& context, const duration& period,
+      schedule_type schedule = fixed_rate,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : impl_(0, 0, context),
+      period_(period),
+      schedule_(schedule),
+      started_(false),
+      slot_(0)
+  {
+  }
+
+  /// Move-construct a basic_periodic_timer from another.
+  /**
+   * This constructor moves a timer from one object to another.
+   *
+   * @param other The other basic_periodic_timer object from which the move
+   * will occur.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * it had been restarted.
+   */
+  basic_periodic_timer(basic_periodic_timer&& other)
+    : impl_(std::move(other.impl_)),
+      period_(other.period_),
+      schedule_(other.schedule_),
+      started_(other.started_),
+      slot_(other.slot_)
+  {
+    other.started_ = false;
+    other.slot_ = 0;
+  }
+
+  /// Move-assign a basic_periodic_timer from another.
+  /**
+   * This assignment operator moves a timer from one object to another. Cancels
+   * any outstanding asynchronous operations associated with the target object.
+   *
+   * @param other The other basic_periodic_timer object from which the move
+   * will occur.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * it had been restarted.
+   */
+  basic_periodic_timer& operator=(basic_periodic_timer&& other)
+  {
+    impl_ = std::move(other.impl_);
+    period_ = other.period_;
+    schedule_ = other.schedule_;
+    started_ = other.started_;
+    other.started_ = false;
+    if (slot_)
+      slot_->release();
+    slot_ = other.slot_;
+    other.slot_ = 0;
+    return *this;
+  }
+
+  // All timers have access to each other's implementations.
+  template <typename Clock1, typename WaitTraits1, typename Executor1>
+  friend class basic_periodic_timer;
+
+  /// Move-construct a basic_periodic_timer from another.
+  /**
+   * This constructor moves a timer from one object to another.
+   *
+   * @param other The other basic_periodic_timer object from which the move
+   * will occur.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * it had been restarted.
+   */
+  template <typename Executor1>
+  basic_periodic_timer(
+      basic_periodic_timer<Clock, WaitTraits, Executor1>&& other,
+      constraint_t<
+        is_convertible<Executor1, Executor>::value
+      > = 0)
+    : impl_(std::move(other.impl_)),
+      period_(other.period_),
+      schedule_(other.schedule_),
+      started_(other.started_),
+      slot_(other.slot_)
+  {
+    other.started_ = false;
+    other.slot_ = 0;
+  }
+
+  /// Move-assign a basic_periodic_timer from another.
+  /**
+   * This assignment operator moves a timer from one object to another. Cancels
+   * any outstanding asynchronous operations associated with the target object.
+   *
+   * @param other The other basic_periodic_timer object from which the move
+   * will occur.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * it had been restarted.
+   */
+  template <typename Executor1>
+  constraint_t<
+    is_convertible<Executor1, Executor>::value,
+    basic_periodic_timer&
+  > operator=(basic_periodic_timer<Clock, WaitTraits, Executor1>&& other)
+  {
+    basic_periodic_timer tmp(std::move(other));
+    impl_ = std::move(tmp.impl_);
+    period_ = tmp.period_;
+    schedule_ = tmp.schedule_;
+    started_ = tmp.started_;
+    std::swap(slot_, tmp.slot_);
+    return *this;
+  }
+
+  /// Destroys the timer.
+  /**
+   * This function destroys the timer, cancelling any outstanding asynchronous
+   * wait operations associated with the timer as if by calling @c cancel.
+   */
+  ~basic_periodic_timer()
+  {
+    if (slot_)
+      slot_->release();
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return impl_.get_executor();
+  }
+
+  /// Get the arena used by default for operations on the timer.
+  /**
+   * This function is only available when the timer's executor carries an
+   * arena. An executor carries an arena when the value of its
+   * asio::execution::allocator property is an asio::arena_allocator.
+   *
+   * @returns The arena, or a null pointer if no arena has been set.
+   */
+  handler_arena* arena() const noexcept
+  {
+    return impl_.get_arena();
+  }
+
+  /// Set the arena used by default for operations on the timer.
+  /**
+   * Asynchronous operations started on the timer after this call allocate
+   * their memory from the arena, unless their completion handler has its own
+   * associated allocator. This includes the intermediate operations of composed
+   * operations, such as asio::async_read, that are started on the timer.
+   *
+   * This function is only available when the timer's executor carries an
+   * arena. The arena replaces the one held by the timer's executor.
+   *
+   * @param a The arena. It must outlive all operations that use it.
+   */
+  void set_arena(handler_arena& a) noexcept
+  {
+    impl_.set_arena(&a);
+  }
+
+  /// Stop using an arena for operations on the timer.
+  /**
+   * Asynchronous operations started on the timer after this call allocate
+   * their memory as if by asio::recycling_allocator, unless their completion
+   * handler has its own associated allocator. Operations that have already
+   * been started continue to use the arena.
+   *
+   * This function is only available when the timer's executor carries an
+   * arena.
+   */
+  void clear_arena() noexcept
+  {
+    impl_.set_arena(0);
+  }
+
+  /// Get the interval between ticks.
+  duration period() const
+  {
+    return period_;
+  }
+
+  /// Set the interval between ticks.
+  /**
+   * The new period takes effect from the next wait that is started. It does
+   * not affect a wait that is already pending.
+   *
+   * @param period The interval between ticks. Must be greater than zero.
+   */
+  void set_period(const duration& period)
+  {
+    period_ = period;
+  }
+
+  /// Get the scheduling mode used for successive ticks.
+  schedule_type schedule() const
+  {
+    return schedule_;
+  }
+
+  /// Set the scheduling mode used for successive ticks.
+  /**
+   * The new mode takes effect from the next wait that is started.
+   */
+  void set_schedule(schedule_type schedule)
+  {
+    schedule_ = schedule;
+  }
+
+  /// Get the time of the most recently scheduled tick.
+  /**
+   * While a wait is pending this is the time at which it will complete.
+   */
+  time_point expiry() const
+  {
+    return impl_.get_service().expiry(impl_.get_implementation());
+  }
+
+  /// Cancel any asynchronous operations that are waiting on the timer.
+  /**
+   * This function forces the completion of any pending asynchronous wait
+   * operations against the timer. The handler for each cancelled operation will
+   * be invoked with the asio::error::operation_aborted error code.
+   *
+   * Cancelling the timer does not change its schedule. In fixed_rate mode, a
+   * subsequent wait completes at the next tick that follows the cancelled one.
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t cancel()
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().cancel(impl_.get_implementation(), ec);
+    asio::detail::throw_error(ec, "cancel");
+    return s;
+  }
+
+  /// Cancel any pending waits and restart the schedule.
+  /**
+   * This function cancels any pending asynchronous wait operations, as if by
+   * calling @c cancel, and discards the current schedule. The next tick will
+   * occur one period after the next wait is started.
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t restart()
+  {
+    started_ = false;
+    return cancel();
+  }
+
+  /// Perform a blocking wait for the next tick.
+  /**
+   * This function blocks and does not return until the next tick of the
+   * timer.
+   *
+   * @return The number of ticks that were missed before the one that was waited
+   * for.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t wait()
+  {
+    asio::error_code ec;
+    std::size_t missed = this->wait(ec);
+    asio::detail::throw_error(ec, "wait");
+    return missed;
+  }
+
+  /// Perform a blocking wait for the next tick.
+  /**
+   * This function blocks and does not return until the next tick of the
+   * timer.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @return The number of ticks that were missed before the one that was waited
+   * for.
+   */
+  std::size_t wait(asio::error_code& ec)
+  {
+    std::size_t missed = schedule_next_tick(true);
+    impl_.get_service().wait(impl_.get_implementation(), ec);
+    return missed;
+  }
+
+  /// Start an asynchronous wait for the next tick.
+  /**
+   * This function may be used to initiate an asynchronous wait for the next
+   * tick of the timer. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * At most one wait may be outstanding on a periodic timer at any time.
+   * Starting a wait cancels a wait that is already pending.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the next tick occurs.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t missed // Number of ticks skipped before this one.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, std::size_t))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_wait(
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WaitToken, void (asio::error_code, std::size_t)>(
+        declval<initiate_async_wait>(), token))
+  {
+    return async_initiate<WaitToken, void (asio::error_code, std::size_t)>(
+        initiate_async_wait(this), token);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_periodic_timer(const basic_periodic_timer&) = delete;
+  basic_periodic_timer& operator=(const basic_periodic_timer&) = delete;
+
+  typedef detail::chrono_time_traits<Clock, WaitTraits> time_traits;
+
+  // Compute the time of the next tick and set it as the expiry time. Returns
+  // the number of ticks that were skipped. Unless a wait may be outstanding,
+  // the timer is not cancelled, so that it keeps its place in the timer queue
+  // from the previous tick.
+  std::size_t schedule_next_tick(bool may_be_waiting)
+  {
+    time_point now = time_traits::now();
+    time_point next = now + period_;
+    std::size_t missed = 0;
+
+    if (started_ && schedule_ == fixed_rate && period_ > duration::zero())
+    {
+      next = expiry() + period_;
+      if (next < now)
+      {
+        // Skip to the most recent tick that has already passed, so that the
+        // wait completes immediately without drifting from the schedule.
+        typename duration::rep behind = (now - next) / period_;
+        next += behind * period_;
+        missed = static_cast<std::size_t>(behind);
+      }
+    }
+
+    // Setting the expiry time cannot fail. Any error from cancelling a
+    // pending wait is ignored by the service.
+    if (may_be_waiting)
+    {
+      asio::error_code ec;
+      impl_.get_service().expires_at(impl_.get_implementation(), next, ec);
+    }
+    else
+    {
+      impl_.get_service().expires_at_next_tick(
+          impl_.get_implementation(), next, period_);
+    }
+    started_ = true;
+    return missed;
+  }
+
+  // Get a slot whose block can hold a wait operation of the given size and
+  // alignment. Returns whether a wait may be outstanding, either in the
+  // slot or in a slot that it replaces.
+  bool prepare_slot(std::size_t size, std::size_t align)
+  {
+    if (slot_ && slot_->fits(size, align))
+      return slot_->outstanding();
+
+    bool outstanding = false;
+    if (slot_)
+    {
+      outstanding = slot_->outstanding();
+      slot_->release();
+      slot_ = 0;
+    }
+    slot_ = detail::periodic_wait_slot::create(size, align);
+    return outstanding;
+  }
+
+  class initiate_async_wait
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_wait(basic_periodic_timer* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WaitHandler>
+    void operator()(WaitHandler&& handler) const
+    {
+      typedef detail::append_handler<decay_t<WaitHandler>, std::size_t>
+        handler2_type;
+      typedef detail::arena_bound_handler<handler2_type, Executor>
+        handler3_type;
+      typedef decay_t<decltype(declval<handler3_type&>().value)>
+        handler3_value_type;
+      typedef detail::periodic_wait_handler<handler3_value_type>
+        handler4_type;
+      typedef typename detail::deadline_timer_service<time_traits>::template
+        wait_op_type<handler4_type, Executor>::type op;
+
+      bool may_be_waiting = self_->prepare_slot(sizeof(op), alignof(op));
+      std::size_t missed = self_->schedule_next_tick(may_be_waiting);
+
+      handler2_type handler2(static_cast<WaitHandler&&>(handler),
+          std::tuple<std::size_t>(missed));
+      handler3_type handler3(handler2, self_->impl_.get_executor());
+      handler4_type handler4(
+          static_cast<handler3_value_type&&>(handler3.value),
+          self_->slot_);
+      self_->impl_.get_service().async_wait(
+          self_->impl_.get_implementation(),
+          handler4, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_periodic_timer* self_;
+  };
+
+  detail::io_object_impl<
+    detail::deadline_timer_service<time_traits>,
+    executor_type > impl_;
+
+  // The interval between ticks.
+  duration period_;
+
+  // How successive ticks are scheduled.
+  schedule_type schedule_;
+
+  // Whether the first tick has been scheduled.
+  bool started_;
+
+  // The memory reused by the wait operation for each tick.
+  detail::periodic_wait_slot* slot_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BASIC_PERIODIC_TIMER_HPP
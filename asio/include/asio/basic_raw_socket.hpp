@@ -18,8 +18,8 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include "asio/basic_socket.hpp"
+#include "asio/detail/arena_handler.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
-#include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
@@ -1236,7 +1236,8 @@ private:
       // does not meet the documented type requirements for a WriteHandler.
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_bound_handler<WriteHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_send(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -1270,7 +1271,8 @@ private:
       // does not meet the documented type requirements for a WriteHandler.
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_bound_handler<WriteHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_send_to(
           self_->impl_.get_implementation(), buffers, destination,
           flags, handler2.value, self_->impl_.get_executor());
@@ -1304,7 +1306,8 @@ private:
       // does not meet the documented type requirements for a ReadHandler.
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
-      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_bound_handler<ReadHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_receive(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -1338,7 +1341,8 @@ private:
       // does not meet the documented type requirements for a ReadHandler.
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
-      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_bound_handler<ReadHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_receive_from(
           self_->impl_.get_implementation(), buffers, *sender_endpoint,
           flags, handler2.value, self_->impl_.get_executor());
@@ -770,7 +770,8 @@ private:
       // does not meet the documented type requirements for a WriteHandler.
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_bound_handler<WriteHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_send(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -805,7 +806,8 @@ private:
       // does not meet the documented type requirements for a ReadHandler.
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
-      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_bound_handler<ReadHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_receive_with_flags(
           self_->impl_.get_implementation(), buffers, in_flags,
           *out_flags, handler2.value, self_->impl_.get_executor());
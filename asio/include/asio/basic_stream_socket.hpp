@@ -19,8 +19,8 @@
 #include <cstddef>
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
+#include "asio/detail/arena_handler.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
-#include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -1111,7 +1111,8 @@ private:
       // does not meet the documented type requirements for a WriteHandler.
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::arena_bound_handler<WriteHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_send(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -1145,7 +1146,8 @@ private:
       // does not meet the documented type requirements for a ReadHandler.
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
-      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::arena_bound_handler<ReadHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_receive(
           self_->impl_.get_implementation(), buffers, flags,
           handler2.value, self_->impl_.get_executor());
@@ -19,11 +19,11 @@
 #include <cstddef>
 #include <utility>
 #include "asio/any_io_executor.hpp"
+#include "asio/detail/arena_handler.hpp"
 #include "asio/detail/chrono_time_traits.hpp"
 #include "asio/detail/deadline_timer_service.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/io_object_impl.hpp"
-#include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/wait_traits.hpp"
@@ -381,6 +381,51 @@ public:
     return impl_.get_executor();
   }
 
+  /// Get the arena used by default for operations on the timer.
+  /**
+   * This function is only available when the timer's executor carries an
+   * arena. An executor carries an arena when the value of its
+   * asio::execution::allocator property is an asio::arena_allocator.
+   *
+   * @returns The arena, or a null pointer if no arena has been set.
+   */
+  handler_arena* arena() const noexcept
+  {
+    return impl_.get_arena();
+  }
+
+  /// Set the arena used by default for operations on the timer.
+  /**
+   * Asynchronous operations started on the timer after this call allocate
+   * their memory from the arena, unless their completion handler has its own
+   * associated allocator. This includes the intermediate operations of composed
+   * operations, such as asio::async_read, that are started on the timer.
+   *
+   * This function is only available when the timer's executor carries an
+   * arena. The arena replaces the one held by the timer's executor.
+   *
+   * @param a The arena. It must outlive all operations that use it.
+   */
+  void set_arena(handler_arena& a) noexcept
+  {
+    impl_.set_arena(&a);
+  }
+
+  /// Stop using an arena for operations on the timer.
+  /**
+   * Asynchronous operations started on the timer after this call allocate
+   * their memory as if by asio::recycling_allocator, unless their completion
+   * handler has its own associated allocator. Operations that have already
+   * been started continue to use the arena.
+   *
+   * This function is only available when the timer's executor carries an
+   * arena.
+   */
+  void clear_arena() noexcept
+  {
+    impl_.set_arena(0);
+  }
+
   /// Cancel any asynchronous operations that are waiting on the timer.
   /**
    * This function forces the completion of any pending asynchronous wait
@@ -801,7 +846,8 @@ private:
       // does not meet the documented type requirements for a WaitHandler.
       ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
 
-      detail::non_const_lvalue<WaitHandler> handler2(handler);
+      detail::arena_bound_handler<WaitHandler, Executor> handler2(
+          handler, self_->impl_.get_executor());
       self_->impl_.get_service().async_wait(
           self_->impl_.get_implementation(),
           handler2.value, self_->impl_.get_executor());
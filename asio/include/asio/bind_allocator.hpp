@@ -281,6 +281,8 @@ public:
 
   /// Move constructor.
   allocator_binder(allocator_binder&& other)
+    noexcept(is_nothrow_move_constructible<T>::value
+      && is_nothrow_move_constructible<Allocator>::value)
     : allocator_(static_cast<allocator_type&&>(
           other.get_allocator())),
       target_(static_cast<T&&>(other.get()))
@@ -285,6 +285,8 @@ public:
 
   /// Move constructor.
   cancellation_slot_binder(cancellation_slot_binder&& other)
+    noexcept(is_nothrow_move_constructible<T>::value
+      && is_nothrow_move_constructible<CancellationSlot>::value)
     : slot_(static_cast<cancellation_slot_type&&>(
           other.get_cancellation_slot())),
       target_(static_cast<T&&>(other.get()))
@@ -320,6 +320,8 @@ public:
 
   /// Move constructor.
   executor_binder(executor_binder&& other)
+    noexcept(is_nothrow_move_constructible<T>::value
+      && is_nothrow_move_constructible<Executor>::value)
     : base_type(static_cast<executor_type&&>(other.get_executor()),
         static_cast<T&&>(other.get()))
   {
@@ -285,6 +285,8 @@ public:
 
   /// Move constructor.
   immediate_executor_binder(immediate_executor_binder&& other)
+    noexcept(is_nothrow_move_constructible<T>::value
+      && is_nothrow_move_constructible<Executor>::value)
     : executor_(static_cast<immediate_executor_type&&>(
           other.get_immediate_executor())),
       target_(static_cast<T&&>(other.get()))
@@ -0,0 +1,152 @@
+//
+// detail/arena_handler.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ARENA_HANDLER_HPP
+#define ASIO_DETAIL_ARENA_HANDLER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <memory>
+#include "asio/associated_allocator.hpp"
+#include "asio/associator.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/allocator.hpp"
+#include "asio/handler_arena.hpp"
+#include "asio/query.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Adapts a handler that uses the default allocator so that its associated
+// allocator is the arena of the I/O object on which the operation was started.
+template <typename Handler>
+class arena_handler
+{
+public:
+  typedef void result_type;
+
+  template <typename H>
+  arena_handler(H&& handler, handler_arena* arena)
+    : handler_(static_cast<H&&>(handler)),
+      arena_(arena)
+  {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    static_cast<Handler&&>(handler_)(static_cast<Args&&>(args)...);
+  }
+
+//private:
+  Handler handler_;
+  handler_arena* arena_;
+};
+
+template <typename Handler>
+inline bool asio_handler_is_continuation(
+    arena_handler<Handler>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+      this_handler->handler_);
+}
+
+// Whether an I/O object's executor carries an arena, as an arena_allocator
+// that is the value of the executor's allocator property.
+template <typename Executor, bool = can_query<
+    const Executor&, execution::allocator_t<void>>::value>
+struct is_arena_executor : false_type
+{
+};
+
+template <typename Executor>
+struct is_arena_executor<Executor, true>
+  : is_same<decay_t<query_result_t<const Executor&,
+      execution::allocator_t<void>>>, arena_allocator<void>>
+{
+};
+
+// Prepares a handler to be passed to an I/O object's service. If the object's
+// executor carries an arena, handlers that use the default allocator are bound
+// to that arena. Other handlers are passed through unchanged.
+template <typename T, typename Executor,
+    bool = is_arena_executor<Executor>::value
+      && is_same<associated_allocator_t<decay_t<T>>,
+        std::allocator<void>>::value>
+struct arena_bound_handler : non_const_lvalue<T>
+{
+  arena_bound_handler(T& t, const Executor&)
+    : non_const_lvalue<T>(t)
+  {
+  }
+};
+
+template <typename T, typename Executor>
+struct arena_bound_handler<T, Executor, true>
+{
+  arena_bound_handler(T& t, const Executor& ex)
+    : value(static_cast<T&&>(t),
+        asio::query(ex, execution::allocator).arena())
+  {
+  }
+
+  arena_handler<decay_t<T>> value;
+};
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::arena_handler<Handler>, DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::arena_handler<Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::arena_handler<Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+template <typename Handler, typename Allocator>
+struct associated_allocator<detail::arena_handler<Handler>, Allocator>
+{
+  typedef arena_allocator<void> type;
+
+  static type get(const detail::arena_handler<Handler>& h,
+      const Allocator& = Allocator()) noexcept
+  {
+    return arena_allocator<void>(h.arena_);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ARENA_HANDLER_HPP
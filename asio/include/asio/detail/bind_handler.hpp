@@ -537,6 +537,50 @@ inline bool asio_handler_is_continuation(
       this_handler->handler_);
 }
 
+template <typename Handler, typename Arg1, typename Arg2, typename Arg3>
+class move_binder3
+{
+public:
+  move_binder3(int, Handler&& handler,
+      const Arg1& arg1, const Arg2& arg2, Arg3&& arg3)
+    : handler_(static_cast<Handler&&>(handler)),
+      arg1_(arg1),
+      arg2_(arg2),
+      arg3_(static_cast<Arg3&&>(arg3))
+  {
+  }
+
+  move_binder3(move_binder3&& other)
+    : handler_(static_cast<Handler&&>(other.handler_)),
+      arg1_(static_cast<Arg1&&>(other.arg1_)),
+      arg2_(static_cast<Arg2&&>(other.arg2_)),
+      arg3_(static_cast<Arg3&&>(other.arg3_))
+  {
+  }
+
+  void operator()()
+  {
+    static_cast<Handler&&>(handler_)(
+        static_cast<const Arg1&>(arg1_),
+        static_cast<const Arg2&>(arg2_),
+        static_cast<Arg3&&>(arg3_));
+  }
+
+//private:
+  Handler handler_;
+  Arg1 arg1_;
+  Arg2 arg2_;
+  Arg3 arg3_;
+};
+
+template <typename Handler, typename Arg1, typename Arg2, typename Arg3>
+inline bool asio_handler_is_continuation(
+    move_binder3<Handler, Arg1, Arg2, Arg3>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+      this_handler->handler_);
+}
+
 } // namespace detail
 
 template <template <typename, typename> class Associator,
@@ -704,6 +748,27 @@ struct associator<Associator,
   }
 };
 
+template <template <typename, typename> class Associator,
+    typename Handler, typename Arg1, typename Arg2, typename Arg3,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::move_binder3<Handler, Arg1, Arg2, Arg3>, DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::move_binder3<Handler, Arg1, Arg2, Arg3>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::move_binder3<Handler, Arg1, Arg2, Arg3>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
@@ -0,0 +1,182 @@
+//
+// detail/bulk_executor_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BULK_EXECUTOR_OP_HPP
+#define ASIO_DETAIL_BULK_EXECUTOR_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// An operation that calls a function for each index in the range [0, size),
+// and then completes a handler. A single operation is queued for the whole
+// range. Each thread that dequeues it claims chunks of indices until none are
+// left, and first queues the operation again so that another thread may join
+// in. The last thread to finish completes the handler. If a call to the
+// function throws, no further indices are claimed and the first exception is
+// passed to the handler.
+template <typename Function, typename Handler, typename IoExecutor>
+class bulk_executor_op : public scheduler_operation
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(bulk_executor_op);
+
+  template <typename F>
+  bulk_executor_op(F&& f, Handler& h, const IoExecutor& io_ex,
+      scheduler& sched, std::size_t size, std::size_t max_participants)
+    : scheduler_operation(&bulk_executor_op::do_complete),
+      function_(static_cast<F&&>(f)),
+      handler_(static_cast<Handler&&>(h)),
+      work_(handler_, io_ex),
+      scheduler_(sched),
+      size_(size),
+      chunk_size_(size / (max_participants * 4) + 1),
+      max_participants_(max_participants),
+      num_participants_(1),
+      next_index_(0),
+      pending_(1),
+      failed_(false)
+  {
+  }
+
+  static void do_complete(void* owner, scheduler_operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    ASIO_ASSUME(base != 0);
+    bulk_executor_op* o(static_cast<bulk_executor_op*>(base));
+
+    if (owner)
+    {
+      std::size_t begin = o->next_index_.fetch_add(
+          o->chunk_size_, std::memory_order_relaxed);
+
+      // Only the thread that dequeued the operation can queue it again, so
+      // the number of participants does not need to be atomic.
+      if (begin + o->chunk_size_ < o->size_
+          && o->num_participants_ < o->max_participants_)
+      {
+        ++o->num_participants_;
+        o->pending_.fetch_add(1, std::memory_order_relaxed);
+        o->scheduler_.post_immediate_completion(o, false);
+      }
+
+      while (begin < o->size_)
+      {
+        std::size_t end = o->size_ - begin < o->chunk_size_
+          ? o->size_ : begin + o->chunk_size_;
+#if !defined(ASIO_NO_EXCEPTIONS)
+        try
+        {
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+          o->run_chunk(begin, end);
+#if !defined(ASIO_NO_EXCEPTIONS)
+        }
+        catch (...)
+        {
+          o->fail();
+          break;
+        }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+        begin = o->next_index_.fetch_add(
+            o->chunk_size_, std::memory_order_relaxed);
+      }
+    }
+
+    if (o->pending_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+
+    // Take ownership of the handler object.
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    binder1<Handler, std::exception_ptr>
+      handler(o->handler_, o->exception_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  void run_chunk(std::size_t begin, std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      function_(i);
+  }
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  // Record the first exception thrown by the function, and stop any further
+  // indices from being claimed. The exception is made visible to the thread
+  // that completes the handler by the decrement of the pending count.
+  void fail()
+  {
+    if (!failed_.exchange(true, std::memory_order_relaxed))
+      exception_ = std::current_exception();
+    next_index_.store(size_, std::memory_order_relaxed);
+  }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+
+  Function function_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+  scheduler& scheduler_;
+  const std::size_t size_;
+  const std::size_t chunk_size_;
+  const std::size_t max_participants_;
+  std::size_t num_participants_;
+  std::atomic<std::size_t> next_index_;
+  std::atomic<std::size_t> pending_;
+  std::atomic<bool> failed_;
+  std::exception_ptr exception_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BULK_EXECUTOR_OP_HPP
@@ -108,6 +108,13 @@ public:
     return elem ? elem->value_ : 0;
   }
 
+  // Obtain the key at the top of the stack.
+  static Key* top_key()
+  {
+    context* elem = top_;
+    return elem ? elem->key_ : 0;
+  }
+
 private:
   // The top of the stack of calls for the current thread.
   static tss_ptr<context> top_;
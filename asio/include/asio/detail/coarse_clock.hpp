@@ -0,0 +1,109 @@
+//
+// detail/coarse_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COARSE_CLOCK_HPP
+#define ASIO_DETAIL_COARSE_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+# include "asio/detail/socket_types.hpp"
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <time.h>
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+# if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0600)
+#  define ASIO_HAS_COARSE_CLOCK 1
+# endif // defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0600)
+#elif defined(CLOCK_MONOTONIC_COARSE)
+# define ASIO_HAS_COARSE_CLOCK 1
+# define ASIO_COARSE_CLOCK_ID CLOCK_MONOTONIC_COARSE
+#elif defined(CLOCK_MONOTONIC_FAST)
+# define ASIO_HAS_COARSE_CLOCK 1
+# define ASIO_COARSE_CLOCK_ID CLOCK_MONOTONIC_FAST
+#endif
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A monotonic clock that is cheap enough to read as every handler starts, at
+// the cost of a resolution of a few milliseconds. Times are in microseconds.
+// Where no such clock is available, the time is always zero.
+class coarse_clock
+{
+public:
+  // Get the current time.
+  static uint64_t now()
+  {
+#if !defined(ASIO_HAS_COARSE_CLOCK)
+    return 0;
+#elif defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    return static_cast<uint64_t>(::GetTickCount64()) * 1000;
+#else
+    timespec ts;
+    ::clock_gettime(ASIO_COARSE_CLOCK_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+  }
+
+  // Get the time that has certainly passed since the specified time. Returns
+  // zero if the start time is zero.
+  static uint64_t elapsed_since(uint64_t start)
+  {
+    if (start == 0)
+      return 0;
+    uint64_t elapsed = now() - start;
+    uint64_t res = resolution();
+    return elapsed > res ? elapsed - res : 0;
+  }
+
+  // Get the resolution of the clock.
+  static uint64_t resolution()
+  {
+#if !defined(ASIO_HAS_COARSE_CLOCK)
+    return 0;
+#elif defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    // The default interval of the system timer.
+    return 15625;
+#else
+    static const uint64_t res = query_resolution();
+    return res;
+#endif
+  }
+
+private:
+#if defined(ASIO_HAS_COARSE_CLOCK) \
+  && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  static uint64_t query_resolution()
+  {
+    timespec ts;
+    if (::clock_getres(ASIO_COARSE_CLOCK_ID, &ts) != 0)
+      return 0;
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000
+      + (ts.tv_nsec + 999) / 1000;
+  }
+#endif // defined(ASIO_HAS_COARSE_CLOCK)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_COARSE_CLOCK_HPP
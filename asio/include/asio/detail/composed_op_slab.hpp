@@ -0,0 +1,493 @@
+//
+// detail/composed_op_slab.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COMPOSED_OP_SLAB_HPP
+#define ASIO_DETAIL_COMPOSED_OP_SLAB_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A single allocation holding the state that is shared by all steps of a
+// composed operation. Only one intermediate operation is outstanding at a
+// time, so the slab also caches the memory used by the first intermediate
+// operation and hands it to each of the rest. The slab reserves room for that
+// memory up front, sized from what earlier operations of the same type needed,
+// so that in the steady state a composed operation makes a single allocation.
+class composed_op_slab_base
+{
+public:
+  // The header placed in front of each block of memory allocated through the
+  // slab. Sizes are measured in units of the header.
+  struct alignas(ASIO_DEFAULT_ALIGN) block
+  {
+    // The slab that caches the block, or null if the block is not cached.
+    composed_op_slab_base* owner_;
+
+    // The size of the block in units, including the header.
+    std::size_t units_;
+  };
+
+  // Get the number of units needed to hold the specified number of bytes.
+  static std::size_t units_for(std::size_t size)
+  {
+    return (size + sizeof(block) - 1) / sizeof(block);
+  }
+
+  // Allocate memory for an intermediate operation, using the slab's cached
+  // block if it is free.
+  template <typename Allocator>
+  static void* allocate(composed_op_slab_base* s,
+      const Allocator& a, std::size_t size)
+  {
+    std::size_t units = 1 + units_for(size);
+    if (s && !s->in_use_)
+    {
+      if (!s->cached_ || s->cached_->units_ < units)
+      {
+        block* b = new_block(a, s, units);
+        if (s->cached_ && s->cached_ != s->embedded_)
+          delete_block(a, s->cached_, s->cached_->units_);
+        s->cached_ = b;
+        if (s->expected_units_->load(std::memory_order_relaxed) < units)
+          s->expected_units_->store(units, std::memory_order_relaxed);
+      }
+      s->in_use_ = true;
+      return s->cached_ + 1;
+    }
+    return new_block(a, 0, units) + 1;
+  }
+
+  // Deallocate memory obtained from allocate().
+  template <typename Allocator>
+  static void deallocate(const Allocator& a, void* p)
+  {
+    block* b = static_cast<block*>(p) - 1;
+    composed_op_slab_base* s = b->owner_;
+    if (!s)
+      delete_block(a, b, b->units_);
+    else if (!s->orphaned_)
+      s->in_use_ = false;
+    else
+      s->destroy(a);
+  }
+
+protected:
+  composed_op_slab_base(std::atomic<std::size_t>* expected_units,
+      std::size_t units) noexcept
+    : cached_(0),
+      embedded_(0),
+      expected_units_(expected_units),
+      units_(units),
+      in_use_(false),
+      orphaned_(false)
+  {
+  }
+
+  // Release the slab once its state has been destroyed. If the cached block is
+  // still in use, the slab's memory is released when the block is deallocated.
+  template <typename Allocator>
+  void release(const Allocator& a)
+  {
+    if (in_use_)
+      orphaned_ = true;
+    else
+      destroy(a);
+  }
+
+  // The memory reserved for an intermediate operation within the slab itself.
+  block* embedded_block() const noexcept
+  {
+    return embedded_;
+  }
+
+  // Place the reserved memory at the specified location.
+  void set_embedded_block(block* b, std::size_t units) noexcept
+  {
+    b->owner_ = this;
+    b->units_ = units;
+    cached_ = embedded_ = b;
+  }
+
+private:
+  // Allocate a block of the specified number of units.
+  template <typename Allocator>
+  static block* new_block(const Allocator& a,
+      composed_op_slab_base* owner, std::size_t units)
+  {
+    ASIO_REBIND_ALLOC(Allocator, block) alloc(a);
+    block* b = alloc.allocate(units);
+    b->owner_ = owner;
+    b->units_ = units;
+    return b;
+  }
+
+  // Deallocate a block.
+  template <typename Allocator>
+  static void delete_block(const Allocator& a, block* b, std::size_t units)
+  {
+    ASIO_REBIND_ALLOC(Allocator, block) alloc(a);
+    alloc.deallocate(b, units);
+  }
+
+  // Deallocate the cached block, unless it is part of the slab, and then the
+  // slab itself.
+  template <typename Allocator>
+  void destroy(const Allocator& a)
+  {
+    if (cached_ && cached_ != embedded_)
+      delete_block(a, cached_, cached_->units_);
+    delete_block(a, reinterpret_cast<block*>(this), units_);
+  }
+
+  // The block cached for reuse by intermediate operations.
+  block* cached_;
+
+  // The block reserved within the slab's own memory, if any.
+  block* embedded_;
+
+  // The number of units to reserve for intermediate operations in new slabs.
+  std::atomic<std::size_t>* expected_units_;
+
+  // The size of the slab's memory in units.
+  std::size_t units_;
+
+  // Whether the cached block is allocated to an intermediate operation.
+  bool in_use_;
+
+  // Whether the slab's owner has released it while the block was in use.
+  bool orphaned_;
+};
+
+// The allocator associated with the steps of a composed operation that holds
+// its state in a slab. Allocations that cannot use the slab's cached block are
+// made from the underlying allocator.
+template <typename T, typename Allocator>
+class composed_op_slab_allocator
+{
+public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef composed_op_slab_allocator<U, Allocator> other;
+  };
+
+  composed_op_slab_allocator(composed_op_slab_base* slab,
+      const Allocator& a) noexcept
+    : slab_(slab),
+      allocator_(a)
+  {
+  }
+
+  template <typename U>
+  composed_op_slab_allocator(
+      const composed_op_slab_allocator<U, Allocator>& other) noexcept
+    : slab_(other.slab_),
+      allocator_(other.allocator_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if (alignof(T) > ASIO_DEFAULT_ALIGN)
+    {
+      ASIO_REBIND_ALLOC(Allocator, T) alloc(allocator_);
+      return alloc.allocate(n);
+    }
+
+    return static_cast<T*>(composed_op_slab_base::allocate(
+          slab_, allocator_, sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    if (alignof(T) > ASIO_DEFAULT_ALIGN)
+    {
+      ASIO_REBIND_ALLOC(Allocator, T) alloc(allocator_);
+      return alloc.deallocate(p, n);
+    }
+
+    composed_op_slab_base::deallocate(allocator_, p);
+  }
+
+  friend bool operator==(const composed_op_slab_allocator& a,
+      const composed_op_slab_allocator& b) noexcept
+  {
+    return a.slab_ == b.slab_;
+  }
+
+  friend bool operator!=(const composed_op_slab_allocator& a,
+      const composed_op_slab_allocator& b) noexcept
+  {
+    return a.slab_ != b.slab_;
+  }
+
+private:
+  template <typename, typename> friend class composed_op_slab_allocator;
+
+  composed_op_slab_base* slab_;
+  Allocator allocator_;
+};
+
+template <typename Allocator>
+class composed_op_slab_allocator<void, Allocator>
+{
+public:
+  typedef void value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef composed_op_slab_allocator<U, Allocator> other;
+  };
+
+  composed_op_slab_allocator(composed_op_slab_base* slab,
+      const Allocator& a) noexcept
+    : slab_(slab),
+      allocator_(a)
+  {
+  }
+
+  template <typename U>
+  composed_op_slab_allocator(
+      const composed_op_slab_allocator<U, Allocator>& other) noexcept
+    : slab_(other.slab_),
+      allocator_(other.allocator_)
+  {
+  }
+
+  friend bool operator==(const composed_op_slab_allocator& a,
+      const composed_op_slab_allocator& b) noexcept
+  {
+    return a.slab_ == b.slab_;
+  }
+
+  friend bool operator!=(const composed_op_slab_allocator& a,
+      const composed_op_slab_allocator& b) noexcept
+  {
+    return a.slab_ != b.slab_;
+  }
+
+private:
+  template <typename, typename> friend class composed_op_slab_allocator;
+
+  composed_op_slab_base* slab_;
+  Allocator allocator_;
+};
+
+// Owns the slab holding a composed operation's state. The slab is allocated
+// using the default allocator for the handler's associated allocator.
+template <typename State, typename HandlerAllocator>
+class composed_op_slab
+{
+public:
+  typedef typename get_default_allocator<HandlerAllocator>::type
+    underlying_allocator_type;
+
+  typedef composed_op_slab_allocator<void, underlying_allocator_type>
+    allocator_type;
+
+  template <typename Arg>
+  composed_op_slab(const HandlerAllocator& a, const Arg& arg)
+    : slab_(0),
+      allocator_(get_default_allocator<HandlerAllocator>::get(a))
+  {
+    typedef composed_op_slab_base::block block;
+    std::size_t extra = expected_units().load(std::memory_order_relaxed);
+    std::size_t units = slab_units + state_units + extra;
+    ASIO_REBIND_ALLOC(underlying_allocator_type, block) alloc(allocator_);
+    memory_guard guard = { &alloc, alloc.allocate(units), units };
+    new (guard.memory_ + slab_units) State(arg);
+    slab_ = new (guard.memory_) slab(&expected_units(), units);
+    if (extra > 0)
+      slab_->place(guard.memory_ + slab_units + state_units, extra);
+    guard.memory_ = 0;
+  }
+
+  composed_op_slab(composed_op_slab&& other) noexcept
+    : slab_(other.slab_),
+      allocator_(static_cast<underlying_allocator_type&&>(other.allocator_))
+  {
+    other.slab_ = 0;
+  }
+
+  ~composed_op_slab()
+  {
+    reset();
+  }
+
+  // Destroy the state and release the slab.
+  void reset()
+  {
+    if (slab_)
+    {
+      state()->~State();
+      slab* s = slab_;
+      slab_ = 0;
+      s->release_memory(allocator_);
+    }
+  }
+
+  State* operator->() const noexcept
+  {
+    return state();
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_type(slab_, allocator_);
+  }
+
+private:
+  typedef composed_op_slab_base::block block;
+
+  // Gives access to the slab's memory management.
+  class slab : public composed_op_slab_base
+  {
+  public:
+    slab(std::atomic<std::size_t>* expected_units, std::size_t units)
+      : composed_op_slab_base(expected_units, units)
+    {
+    }
+
+    void place(block* b, std::size_t units)
+    {
+      this->set_embedded_block(b, units);
+    }
+
+    void release_memory(const underlying_allocator_type& a)
+    {
+      this->release(a);
+    }
+  };
+
+  // Releases the slab's memory if the state's constructor throws.
+  struct memory_guard
+  {
+    ~memory_guard()
+    {
+      if (memory_)
+        alloc_->deallocate(memory_, units_);
+    }
+
+    ASIO_REBIND_ALLOC(underlying_allocator_type, block)* alloc_;
+    block* memory_;
+    std::size_t units_;
+  };
+
+  // The number of units occupied by the slab's header and the state.
+  static const std::size_t slab_units = (sizeof(slab) + sizeof(block) - 1)
+    / sizeof(block);
+  static const std::size_t state_units = (sizeof(State) + sizeof(block) - 1)
+    / sizeof(block);
+
+  // The number of units to reserve for intermediate operations, as learned
+  // from earlier operations of this type.
+  static std::atomic<std::size_t>& expected_units()
+  {
+    static std::atomic<std::size_t> units(0);
+    return units;
+  }
+
+  State* state() const noexcept
+  {
+    return reinterpret_cast<State*>(
+        reinterpret_cast<block*>(slab_) + slab_units);
+  }
+
+  // Disallow copying and assignment.
+  composed_op_slab(const composed_op_slab&) = delete;
+  composed_op_slab& operator=(const composed_op_slab&) = delete;
+
+  slab* slab_;
+  underlying_allocator_type allocator_;
+};
+
+// Holds a composed operation's state directly. Used when the state cannot be
+// placed in a slab.
+template <typename State, typename HandlerAllocator>
+class composed_op_inline_state
+{
+public:
+  typedef HandlerAllocator allocator_type;
+
+  template <typename Arg>
+  composed_op_inline_state(const HandlerAllocator& a, const Arg& arg)
+    : allocator_(a),
+      state_(arg)
+  {
+  }
+
+  composed_op_inline_state(composed_op_inline_state&& other)
+    : allocator_(static_cast<HandlerAllocator&&>(other.allocator_)),
+      state_(static_cast<State&&>(other.state_))
+  {
+  }
+
+  void reset()
+  {
+  }
+
+  State* operator->() noexcept
+  {
+    return &state_;
+  }
+
+  const State* operator->() const noexcept
+  {
+    return &state_;
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_;
+  }
+
+private:
+  HandlerAllocator allocator_;
+  State state_;
+};
+
+// Selects how a composed operation holds its state. Handlers that use the
+// default allocator keep their state inline, so that their intermediate
+// operations continue to use the recycling allocator or the I/O object's
+// arena.
+template <typename State, typename HandlerAllocator>
+struct composed_op_state
+{
+  typedef conditional_t<
+    alignof(State) <= ASIO_DEFAULT_ALIGN
+      && !is_same<HandlerAllocator, std::allocator<void>>::value,
+    composed_op_slab<State, HandlerAllocator>,
+    composed_op_inline_state<State, HandlerAllocator>
+  > type;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_COMPOSED_OP_SLAB_HPP
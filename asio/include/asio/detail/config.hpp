@@ -379,6 +379,34 @@
 # define ASIO_DEFAULT_ALIGN alignof(std::max_align_t)
 #endif // defined(__GNUC__)
 
+// Cache line size, used to keep objects that are accessed by different threads
+// apart.
+#if !defined(ASIO_CACHE_LINE_SIZE)
+# define ASIO_CACHE_LINE_SIZE 64
+#endif // !defined(ASIO_CACHE_LINE_SIZE)
+
+// The default number of blocks that a thread's recycling allocator cache holds
+// in each size class. Threads running an execution_context use the depth set
+// in the context's memory limits instead.
+#if !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
+#endif // !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+
+// Default time, in microseconds, that a handler may run while other work is
+// waiting before this_thread_should_yield() returns true.
+#if !defined(ASIO_HANDLER_YIELD_USEC)
+# define ASIO_HANDLER_YIELD_USEC 1000
+#endif // !defined(ASIO_HANDLER_YIELD_USEC)
+
+// Recording the start time of every handler, so that this_thread_should_yield()
+// also counts the time a handler runs before it first asks. Reads a coarse
+// clock as each handler starts, and so must be explicitly enabled.
+#if !defined(ASIO_HAS_HANDLER_START_TIME)
+# if defined(ASIO_ENABLE_HANDLER_YIELD)
+#  define ASIO_HAS_HANDLER_START_TIME 1
+# endif // defined(ASIO_ENABLE_HANDLER_YIELD)
+#endif // !defined(ASIO_HAS_HANDLER_START_TIME)
+
 // Standard library support for aligned allocation.
 #if !defined(ASIO_HAS_STD_ALIGNED_ALLOC)
 # if !defined(ASIO_DISABLE_STD_ALIGNED_ALLOC)
@@ -1233,6 +1261,18 @@
 # define ASIO_THREAD_KEYWORD __thread
 #endif // !defined(ASIO_THREAD_KEYWORD)
 
+// Per-thread timer queues. Must be explicitly enabled, and are only supported
+// by the epoll reactor.
+#if !defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+# if defined(ASIO_ENABLE_PER_THREAD_TIMER_QUEUES)
+#  if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#   if defined(ASIO_HAS_THREADS)
+#    define ASIO_HAS_PER_THREAD_TIMER_QUEUES 1
+#   endif // defined(ASIO_HAS_THREADS)
+#  endif // defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# endif // defined(ASIO_ENABLE_PER_THREAD_TIMER_QUEUES)
+#endif // !defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
 // Support for POSIX ssize_t typedef.
 #if !defined(ASIO_DISABLE_SSIZE_T)
 # if defined(__linux__) \
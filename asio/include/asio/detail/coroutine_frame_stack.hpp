@@ -0,0 +1,278 @@
+//
+// detail/coroutine_frame_stack.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COROUTINE_FRAME_STACK_HPP
+#define ASIO_DETAIL_COROUTINE_FRAME_STACK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A per-thread allocator for coroutine frames. Frames are carved from large
+// chunks by bumping a pointer, and the frame on top of the stack is reclaimed
+// immediately when it is freed, so that nested co_awaits reuse the same memory
+// over and over. Frames freed out of order leave a hole that is reclaimed once
+// all frames in the chunk have been freed.
+//
+// A frame that outlives those above it pins its chunk. When the current chunk
+// fills up while it still has live frames, it is kept as the retired chunk
+// and replaced by the previous retired chunk, if that is free, or by a new
+// one. A thread therefore holds at most two chunks. While both have live
+// frames, allocate() fails and the caller obtains the memory for the frame
+// elsewhere, marking it as not belonging to a chunk with unowned_frame().
+//
+// A frame may be freed on any thread. Each chunk counts its live frames, plus
+// one reference held by the owning thread while the chunk is current. The
+// chunk is deleted when the last reference is released.
+class coroutine_frame_stack
+  : private noncopyable
+{
+public:
+  enum
+  {
+    // The size of each chunk, including its header.
+    chunk_size = 64 * 1024,
+
+    // Frames larger than this are not served from a chunk.
+    max_frame_size = chunk_size / 8
+  };
+
+  coroutine_frame_stack()
+    : current_(0),
+      retired_(0)
+  {
+  }
+
+  ~coroutine_frame_stack()
+  {
+    if (current_)
+      release(current_);
+    if (retired_)
+      release(retired_);
+  }
+
+  // Determine whether a frame of the specified size is small enough to be
+  // allocated by a coroutine_frame_stack.
+  static bool is_stack_frame(std::size_t size)
+  {
+    return rounded_frame_size(size) <= max_frame_size;
+  }
+
+  // Allocate a frame from a chunk. The this_stack argument is the stack of
+  // the calling thread, and may be null. Returns null if the frame cannot be
+  // allocated from a chunk. The owning chunk is stored in front of the
+  // returned memory.
+  static void* allocate(coroutine_frame_stack* this_stack, std::size_t size)
+  {
+    if (!this_stack)
+      return 0;
+
+    std::size_t frame_size = rounded_frame_size(size);
+    chunk* owner = this_stack->current_;
+    if (owner)
+    {
+      // Once every frame in the chunk has been freed, start again from the
+      // bottom of the chunk.
+      if (only_owner(owner))
+        owner->top_ = chunk_header_size();
+
+      // The chunk is full and still has live frames. Retire it, provided the
+      // previously retired chunk is free to take its place.
+      if (owner->top_ + frame_size > chunk_size)
+      {
+        chunk* next = this_stack->retired_;
+        if (next && !only_owner(next))
+          return 0;
+
+        if (next)
+          next->top_ = chunk_header_size();
+        else
+        {
+          void* p = aligned_new(ASIO_DEFAULT_ALIGN, chunk_size);
+          next = new (p) chunk;
+        }
+        this_stack->retired_ = owner;
+        this_stack->current_ = next;
+        owner = next;
+      }
+    }
+    else
+    {
+      void* p = aligned_new(ASIO_DEFAULT_ALIGN, chunk_size);
+      owner = new (p) chunk;
+      this_stack->current_ = owner;
+    }
+
+    unsigned char* frame = reinterpret_cast<unsigned char*>(owner) + owner->top_;
+    owner->top_ += frame_size;
+    ref_count_up(owner->refs_);
+
+    frame_header* header = new (frame) frame_header;
+    header->owner_ = owner;
+    return frame + frame_header_size();
+  }
+
+  // Get the size of the memory needed to hold a frame that is not allocated
+  // from a chunk.
+  static std::size_t unowned_frame_size(std::size_t size)
+  {
+    return rounded_frame_size(size);
+  }
+
+  // Prepare memory of unowned_frame_size() bytes to hold a frame that is not
+  // allocated from a chunk. Returns the frame.
+  static void* unowned_frame(void* memory)
+  {
+    frame_header* header = new (memory) frame_header;
+    header->owner_ = 0;
+    return static_cast<unsigned char*>(memory) + frame_header_size();
+  }
+
+  // Free a frame previously obtained from allocate() or unowned_frame(). The
+  // this_stack argument is the stack of the calling thread, and may be null.
+  // For a frame that is not allocated from a chunk, returns the memory that
+  // was passed to unowned_frame(), which the caller must then free. Otherwise
+  // returns null.
+  static void* deallocate(coroutine_frame_stack* this_stack,
+      void* pointer, std::size_t size)
+  {
+    frame_header* header = reinterpret_cast<frame_header*>(
+        static_cast<unsigned char*>(pointer) - frame_header_size());
+    chunk* owner = header->owner_;
+
+    if (!owner)
+      return header;
+
+    // Only the owning thread may move the top of its current chunk.
+    if (this_stack && this_stack->current_ == owner)
+    {
+      unsigned char* base = reinterpret_cast<unsigned char*>(owner);
+      std::size_t offset = reinterpret_cast<unsigned char*>(header) - base;
+      if (offset + rounded_frame_size(size) == owner->top_)
+        owner->top_ = offset;
+    }
+
+    release(owner);
+    return 0;
+  }
+
+  // Release the chunks from which no frames are allocated.
+  void trim()
+  {
+    if (retired_ && only_owner(retired_))
+    {
+      release(retired_);
+      retired_ = 0;
+    }
+
+    if (current_ && only_owner(current_))
+    {
+      release(current_);
+      current_ = retired_;
+      retired_ = 0;
+    }
+  }
+
+  // Get the number of bytes in use in the current chunk.
+  std::size_t bytes_in_use() const
+  {
+    return current_ ? current_->top_ - chunk_header_size() : 0;
+  }
+
+  // Get the number of bytes in the chunks held by the stack.
+  std::size_t bytes_reserved() const
+  {
+    return (current_ ? chunk_size : 0) + (retired_ ? chunk_size : 0);
+  }
+
+private:
+  // The chunk header, followed by the frames.
+  struct chunk
+  {
+    chunk()
+      : refs_(1),
+        top_(chunk_header_size())
+    {
+    }
+
+    atomic_count refs_;
+    std::size_t top_;
+  };
+
+  // Stored in front of each frame.
+  struct frame_header
+  {
+    chunk* owner_;
+  };
+
+  static std::size_t round_up(std::size_t size)
+  {
+    return (size + ASIO_DEFAULT_ALIGN - 1)
+      / ASIO_DEFAULT_ALIGN * ASIO_DEFAULT_ALIGN;
+  }
+
+  static std::size_t chunk_header_size()
+  {
+    return round_up(sizeof(chunk));
+  }
+
+  static std::size_t frame_header_size()
+  {
+    return round_up(sizeof(frame_header));
+  }
+
+  static std::size_t rounded_frame_size(std::size_t size)
+  {
+    return frame_header_size() + round_up(size);
+  }
+
+  static bool only_owner(chunk* c)
+  {
+#if defined(ASIO_HAS_THREADS)
+    return c->refs_.load(std::memory_order_acquire) == 1;
+#else // defined(ASIO_HAS_THREADS)
+    return c->refs_ == 1;
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  static void release(chunk* c)
+  {
+    if (ref_count_down(c->refs_))
+    {
+      c->~chunk();
+      aligned_delete(c);
+    }
+  }
+
+  // The chunk from which frames are allocated.
+  chunk* current_;
+
+  // The chunk that was current before it filled up, if any.
+  chunk* retired_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_COROUTINE_FRAME_STACK_HPP
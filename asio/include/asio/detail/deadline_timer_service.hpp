@@ -27,6 +27,8 @@
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_timer_queue.hpp"
 #include "asio/detail/timer_queue.hpp"
 #include "asio/detail/timer_queue_ptime.hpp"
 #include "asio/detail/timer_scheduler.hpp"
@@ -54,6 +56,13 @@ public:
   // The duration type.
   typedef typename Time_Traits::duration_type duration_type;
 
+  // The type of the queue used to hold the timers.
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  typedef thread_timer_queue<Time_Traits> timer_queue_type;
+#else // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  typedef timer_queue<Time_Traits> timer_queue_type;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
   // The implementation type of the timer. This type is dependent on the
   // underlying implementation of the timer service.
   struct implementation_type
@@ -62,6 +71,9 @@ public:
     time_type expiry;
     bool might_have_pending_waits;
     typename timer_queue<Time_Traits>::per_timer_data timer_data;
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    timer_queue_type* queue;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
   };
 
   // Constructor.
@@ -70,6 +82,11 @@ public:
         deadline_timer_service<Time_Traits>>(context),
       scheduler_(asio::use_service<timer_scheduler>(context))
   {
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    for (std::size_t i = 0; i < timer_queue_type::max_threads; ++i)
+      thread_queues_[i] = 0;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
     scheduler_.init_task();
     scheduler_.add_timer_queue(timer_queue_);
   }
@@ -78,6 +95,17 @@ public:
   ~deadline_timer_service()
   {
     scheduler_.remove_timer_queue(timer_queue_);
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    for (std::size_t i = 0; i < timer_queue_type::max_threads; ++i)
+    {
+      if (thread_queues_[i])
+      {
+        scheduler_.remove_timer_queue(*thread_queues_[i]);
+        delete thread_queues_[i];
+      }
+    }
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
   }
 
   // Destroy all user-defined handler objects owned by the service.
@@ -90,6 +118,9 @@ public:
   {
     impl.expiry = time_type();
     impl.might_have_pending_waits = false;
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    impl.queue = 0;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
   }
 
   // Destroy a timer implementation.
@@ -103,7 +134,13 @@ public:
   void move_construct(implementation_type& impl,
       implementation_type& other_impl)
   {
-    scheduler_.move_timer(timer_queue_, impl.timer_data, other_impl.timer_data);
+    scheduler_.move_timer(queue_for(other_impl),
+        impl.timer_data, other_impl.timer_data);
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    impl.queue = other_impl.queue;
+    other_impl.queue = 0;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
 
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
@@ -117,13 +154,24 @@ public:
       deadline_timer_service& other_service,
       implementation_type& other_impl)
   {
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    // The timers may be held in different queues even within one service.
+    if (impl.might_have_pending_waits)
+      scheduler_.cancel_timer(queue_for(impl), impl.timer_data);
+#else // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
     if (this != &other_service)
       if (impl.might_have_pending_waits)
         scheduler_.cancel_timer(timer_queue_, impl.timer_data);
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
 
-    other_service.scheduler_.move_timer(other_service.timer_queue_,
+    other_service.scheduler_.move_timer(other_service.queue_for(other_impl),
         impl.timer_data, other_impl.timer_data);
 
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    impl.queue = other_impl.queue;
+    other_impl.queue = 0;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
@@ -158,7 +206,8 @@ public:
     ASIO_HANDLER_OPERATION((scheduler_.context(),
           "deadline_timer", &impl, 0, "cancel"));
 
-    std::size_t count = scheduler_.cancel_timer(timer_queue_, impl.timer_data);
+    std::size_t count = scheduler_.cancel_timer(
+        queue_for(impl), impl.timer_data);
     impl.might_have_pending_waits = false;
     ec = asio::error_code();
     return count;
@@ -178,7 +227,7 @@ public:
           "deadline_timer", &impl, 0, "cancel_one"));
 
     std::size_t count = scheduler_.cancel_timer(
-        timer_queue_, impl.timer_data, 1);
+        queue_for(impl), impl.timer_data, 1);
     if (count == 0)
       impl.might_have_pending_waits = false;
     ec = asio::error_code();
@@ -213,6 +262,24 @@ public:
     return count;
   }
 
+  // Set the expiry time for the next tick of a timer that is waited on once
+  // per period. Unlike expires_at(), the timer is not cancelled, so a timer
+  // that was left in the timer queue when its last tick fired keeps its place
+  // there and is moved to the new time by the next wait. Must only be called
+  // when no wait on the timer is outstanding.
+  void expires_at_next_tick(implementation_type& impl,
+      const time_type& expiry_time, const duration_type& period)
+  {
+    if (!impl.timer_data.has_period(period))
+    {
+      // The period may only be changed while the timer is not in a queue.
+      asio::error_code ec;
+      cancel(impl, ec);
+      impl.timer_data.set_period(period);
+    }
+    impl.expiry = expiry_time;
+  }
+
   // Set the expiry time for the timer relative to now.
   std::size_t expires_after(implementation_type& impl,
       const duration_type& expiry_time, asio::error_code& ec)
@@ -242,6 +309,13 @@ public:
     }
   }
 
+  // The type of the operation that waits on the timer for a handler.
+  template <typename Handler, typename IoExecutor>
+  struct wait_op_type
+  {
+    typedef wait_handler<Handler, IoExecutor> type;
+  };
+
   // Start an asynchronous wait on the timer.
   template <typename Handler, typename IoExecutor>
   void async_wait(implementation_type& impl,
@@ -250,6 +324,12 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = asio::get_associated_cancellation_slot(handler);
 
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    // A timer is bound to a queue the first time it is armed.
+    if (!impl.queue)
+      impl.queue = &select_queue();
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
     // Allocate and construct an operation to wrap the handler.
     typedef wait_handler<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -260,7 +340,8 @@ public:
     if (slot.is_connected())
     {
       p.p->cancellation_key_ =
-        &slot.template emplace<op_cancellation>(this, &impl.timer_data);
+        &slot.template emplace<op_cancellation>(
+            this, &queue_for(impl), &impl.timer_data);
     }
 
     impl.might_have_pending_waits = true;
@@ -268,7 +349,8 @@ public:
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "deadline_timer", &impl, 0, "async_wait"));
 
-    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
+    scheduler_.schedule_timer(queue_for(impl),
+        impl.expiry, impl.timer_data, p.p);
     p.v = p.p = 0;
   }
 
@@ -296,9 +378,10 @@ private:
   class op_cancellation
   {
   public:
-    op_cancellation(deadline_timer_service* s,
+    op_cancellation(deadline_timer_service* s, timer_queue_type* q,
         typename timer_queue<Time_Traits>::per_timer_data* p)
       : service_(s),
+        queue_(q),
         timer_data_(p)
     {
     }
@@ -311,17 +394,59 @@ private:
               | cancellation_type::total)))
       {
         service_->scheduler_.cancel_timer_by_key(
-            service_->timer_queue_, timer_data_, this);
+            *queue_, timer_data_, this);
       }
     }
 
   private:
     deadline_timer_service* service_;
+    timer_queue_type* queue_;
     typename timer_queue<Time_Traits>::per_timer_data* timer_data_;
   };
 
+  // Get the queue that holds the given timer.
+  timer_queue_type& queue_for(implementation_type& impl)
+  {
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    if (impl.queue)
+      return *impl.queue;
+#else // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    (void)impl;
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+    return timer_queue_;
+  }
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  // Select the queue for a timer that is being armed. Timers armed from inside
+  // a run function use the calling thread's own queue.
+  timer_queue_type& select_queue()
+  {
+    if (thread_context::top_of_thread_call_stack())
+    {
+      std::size_t index = timer_queue_type::this_thread_index();
+      if (index < timer_queue_type::max_threads)
+      {
+        // Only the owning thread creates its queue, so no locking is needed.
+        if (!thread_queues_[index])
+        {
+          timer_queue_type* queue = new timer_queue_type;
+          scheduler_.add_timer_queue(*queue);
+          thread_queues_[index] = queue;
+        }
+        return *thread_queues_[index];
+      }
+    }
+    return timer_queue_;
+  }
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
   // The queue of timers.
-  timer_queue<Time_Traits> timer_queue_;
+  timer_queue_type timer_queue_;
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  // The queues of timers armed from inside run functions, indexed by thread.
+  timer_queue_type* thread_queues_[timer_queue_type::max_threads];
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
 
   // The object that schedules and executes timers. Usually a reactor.
   timer_scheduler& scheduler_;
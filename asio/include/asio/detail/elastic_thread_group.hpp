@@ -0,0 +1,121 @@
+//
+// detail/elastic_thread_group.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ELASTIC_THREAD_GROUP_HPP
+#define ASIO_DETAIL_ELASTIC_THREAD_GROUP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/event.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A group of threads that run a scheduler, where the number of threads varies
+// with the load. A monitor thread samples the scheduler's load periodically
+// and adds a thread whenever operations have stayed queued for a whole period
+// without any thread becoming idle, which happens when the threads are busy
+// or blocked. Threads that find no work for the idle timeout exit, as long as
+// the minimum number of threads remains.
+class elastic_thread_group
+  : private noncopyable
+{
+public:
+  // Constructor starts the minimum number of threads and the monitor.
+  ASIO_DECL elastic_thread_group(scheduler& sched,
+      std::size_t min_threads, std::size_t max_threads,
+      long growth_latency_usec, long idle_timeout_usec);
+
+  // Destructor joins all threads.
+  ASIO_DECL ~elastic_thread_group();
+
+  // Get the number of threads currently running the scheduler.
+  ASIO_DECL std::size_t size() const;
+
+  // Wait for the scheduler to stop and all threads to exit. The monitor keeps
+  // adding threads until the scheduler stops, so that queued work is run.
+  ASIO_DECL void join();
+
+private:
+  // Structure used to track a single thread running the scheduler.
+  struct worker;
+
+  // Function objects used as the entry points of the threads.
+  struct worker_function;
+  struct monitor_function;
+
+  // Run the scheduler on a worker thread until it stops, or until the thread
+  // has been idle for the idle timeout and is not needed.
+  ASIO_DECL void run_worker(worker* w);
+
+  // Sample the load periodically, adding and reaping threads as required.
+  ASIO_DECL void run_monitor();
+
+  // Start a new worker thread.
+  ASIO_DECL void add_worker(mutex::scoped_lock& lock);
+
+  // Join and destroy worker threads that have exited.
+  ASIO_DECL void reap_workers(mutex::scoped_lock& lock);
+
+  // The scheduler run by the threads.
+  scheduler& scheduler_;
+
+  // The limits on the number of threads.
+  const std::size_t min_threads_;
+  const std::size_t max_threads_;
+
+  // The time for which operations may stay queued before a thread is added.
+  const long growth_latency_usec_;
+
+  // The time for which a thread may be idle before it exits.
+  const long idle_timeout_usec_;
+
+  // Mutex to protect access to internal data.
+  mutable mutex mutex_;
+
+  // Event used to wake the monitor when it is to exit.
+  event monitor_event_;
+
+  // Event signalled when a worker thread exits.
+  event exit_event_;
+
+  // Whether the monitor is to exit.
+  bool stopping_;
+
+  // The number of worker threads that are running the scheduler.
+  std::size_t num_threads_;
+
+  // The worker threads that have not yet been joined.
+  worker* workers_;
+
+  // The monitor thread.
+  thread* monitor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/elastic_thread_group.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_ELASTIC_THREAD_GROUP_HPP
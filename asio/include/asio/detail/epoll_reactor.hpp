@@ -28,6 +28,7 @@
 #include "asio/detail/scheduler_task.hpp"
 #include "asio/detail/select_interrupter.hpp"
 #include "asio/detail/socket_types.hpp"
+#include "asio/detail/thread_timer_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
 #include "asio/detail/timer_queue_set.hpp"
 #include "asio/detail/wait_op.hpp"
@@ -74,6 +75,7 @@ public:
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
+    ASIO_DECL bool may_perform_io();
     ASIO_DECL operation* perform_io(uint32_t events);
     ASIO_DECL static void do_complete(
         void* owner, operation* base,
@@ -96,6 +98,10 @@ public:
   ASIO_DECL void notify_fork(
       asio::execution_context::fork_event fork_ev);
 
+  // Add the memory held on the free list of the reactor's per-descriptor state to the counters.
+  ASIO_DECL void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
   // Initialise the task.
   ASIO_DECL void init_task();
 
@@ -171,6 +177,12 @@ public:
   ASIO_DECL void cleanup_descriptor_data(
       per_descriptor_data& descriptor_data);
 
+  // Pre-allocate state for the specified number of descriptors.
+  ASIO_DECL void reserve_descriptors(std::size_t n);
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -205,12 +217,43 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  // Schedule a new operation in the given self-locking timer queue to expire
+  // at the specified absolute time.
+  template <typename Time_Traits>
+  void schedule_timer(thread_timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op);
+
+  // Cancel the timer operations associated with the given token. Returns the
+  // number of operations that have been posted or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timer(thread_timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
+
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(thread_timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
+  // Move the timer operations associated with the given timer.
+  template <typename Time_Traits>
+  void move_timer(thread_timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& target,
+      typename timer_queue<Time_Traits>::per_timer_data& source);
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
   // Run epoll once until interrupted or events are ready to be dispatched.
   ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Determine whether an operation returned by run() has work to do.
+  ASIO_DECL bool has_work(operation* op);
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -270,7 +313,7 @@ private:
   bool shutdown_;
 
   // Mutex to protect access to the registered descriptors.
-  mutex registered_descriptors_mutex_;
+  mutable mutex registered_descriptors_mutex_;
 
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
@@ -0,0 +1,159 @@
+//
+// detail/fair_executor_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_FAIR_EXECUTOR_SERVICE_HPP
+#define ASIO_DETAIL_FAIR_EXECUTOR_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/executor_op.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Gives each fair executor its own queue of functions. A queue occupies at
+// most a fixed number of places in the underlying executor's queue, and runs
+// a fixed number of functions each time one of those places reaches the
+// front. Executors that share an underlying executor are therefore served in
+// round-robin order, however many functions each has queued.
+class fair_executor_service
+  : public execution_context_service_base<fair_executor_service>
+{
+public:
+  // The underlying implementation of a fair executor.
+  class fair_impl
+  {
+  public:
+    ASIO_DECL ~fair_impl();
+
+  private:
+    friend class fair_executor_service;
+
+    // Mutex to protect access to internal data.
+    mutex mutex_;
+
+    // Indicates that the service has been shut down and will accept no
+    // further functions.
+    bool shutdown_;
+
+    // The number of functions run each time the queue reaches the front of
+    // the underlying executor's queue.
+    std::size_t weight_;
+
+    // The maximum number of places the queue may occupy in the underlying
+    // executor's queue, and so the number of its functions that may run
+    // concurrently.
+    std::size_t concurrency_;
+
+    // The number of places the queue currently occupies.
+    std::size_t scheduled_;
+
+    // The functions waiting to be run.
+    op_queue<scheduler_operation> queue_;
+
+    // Pointers to adjacent handle implementations in linked list.
+    fair_impl* next_;
+    fair_impl* prev_;
+
+    // The service in which the implementation is held.
+    fair_executor_service* service_;
+  };
+
+  typedef shared_ptr<fair_impl> implementation_type;
+
+  // Construct a new fair executor service for the specified context.
+  ASIO_DECL explicit fair_executor_service(execution_context& context);
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Create a new fair executor implementation.
+  ASIO_DECL implementation_type create_implementation(
+      std::size_t weight, std::size_t concurrency);
+
+  // Request invocation of the given function.
+  template <typename Executor, typename Function>
+  static void execute(const implementation_type& impl, Executor& ex,
+      Function&& function,
+      enable_if_t<
+        can_query<Executor, execution::allocator_t<void>>::value
+      >* = 0);
+
+  // Request invocation of the given function.
+  template <typename Executor, typename Function>
+  static void execute(const implementation_type& impl, Executor& ex,
+      Function&& function,
+      enable_if_t<
+        !can_query<Executor, execution::allocator_t<void>>::value
+      >* = 0);
+
+  // Determine whether a function from the queue is running in the current
+  // thread.
+  ASIO_DECL static bool running_in_this_thread(
+      const implementation_type& impl);
+
+  // Get the number of functions run each time the queue is scheduled.
+  ASIO_DECL static std::size_t get_weight(const implementation_type& impl);
+
+  // Get the maximum number of the queue's functions that run concurrently.
+  ASIO_DECL static std::size_t get_concurrency(
+      const implementation_type& impl);
+
+private:
+  template <typename Executor> class invoker;
+
+  // Adds a function to the queue. Returns true if the caller must schedule
+  // the queue on the underlying executor.
+  ASIO_DECL static bool enqueue(const implementation_type& impl,
+      scheduler_operation* op);
+
+  // Runs queued functions, up to the weight of the queue.
+  ASIO_DECL static void run_ready_functions(const implementation_type& impl);
+
+  // Gives up the queue's place in the underlying executor. Returns true if
+  // functions remain, in which case the caller must schedule the queue again.
+  ASIO_DECL static bool reschedule(const implementation_type& impl);
+
+  // Helper function to request invocation of the given function.
+  template <typename Executor, typename Function, typename Allocator>
+  static void do_execute(const implementation_type& impl, Executor& ex,
+      Function&& function, const Allocator& a);
+
+  // Mutex to protect access to the service-wide state.
+  mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  fair_impl* impl_list_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/detail/impl/fair_executor_service.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/fair_executor_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_FAIR_EXECUTOR_SERVICE_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <new>
 #include "asio/associated_allocator.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/associated_immediate_executor.hpp"
@@ -34,6 +35,7 @@
 namespace asio {
 
 class executor;
+class inline_executor;
 class io_context;
 
 #if !defined(ASIO_USE_TS_EXECUTOR_AS_DEFAULT)
@@ -204,6 +206,117 @@ public:
   }
 };
 
+template <typename Executor, typename IoContext, typename PolymorphicExecutor>
+class handler_work_base<Executor, Executor, IoContext, PolymorphicExecutor,
+    enable_if_t<
+      is_same<
+        Executor,
+        typename IoContext::executor_type
+      >::value
+    >
+  >
+{
+public:
+  handler_work_base(bool base1_owns_work, const Executor& ex,
+      const Executor& candidate) noexcept
+    : owns_work_(base1_owns_work || ex != candidate)
+  {
+    // A handler whose executor is the I/O executor is completed from within
+    // that io_context, so there is no need to count work or to dispatch.
+    if (owns_work_)
+    {
+      new (&executor_) executor_type(
+          asio::prefer(ex, execution::outstanding_work.tracked));
+    }
+  }
+
+  handler_work_base(const handler_work_base& other) noexcept
+    : owns_work_(other.owns_work_)
+  {
+    if (owns_work_)
+      new (&executor_) executor_type(other.executor_);
+  }
+
+  handler_work_base(handler_work_base&& other) noexcept
+    : owns_work_(other.owns_work_)
+  {
+    if (owns_work_)
+    {
+      new (&executor_) executor_type(
+          static_cast<executor_type&&>(other.executor_));
+    }
+  }
+
+  ~handler_work_base()
+  {
+    if (owns_work_)
+      executor_.~executor_type();
+  }
+
+  bool owns_work() const noexcept
+  {
+    return owns_work_;
+  }
+
+  template <typename Function, typename Handler>
+  void dispatch(Function& function, Handler& handler)
+  {
+    if (owns_work_)
+    {
+      asio::prefer(executor_,
+          execution::allocator((get_associated_allocator)(handler))
+        ).execute(static_cast<Function&&>(function));
+    }
+    else
+    {
+      static_cast<Function&&>(function)();
+    }
+  }
+
+private:
+  typedef decay_t<
+      prefer_result_t<Executor, execution::outstanding_work_t::tracked_t>
+    > executor_type;
+
+  // The tracked executor is constructed only when work is owned.
+  union
+  {
+    executor_type executor_;
+  };
+
+  bool owns_work_;
+};
+
+template <typename CandidateExecutor,
+    typename IoContext, typename PolymorphicExecutor>
+class handler_work_base<inline_executor,
+    CandidateExecutor, IoContext, PolymorphicExecutor>
+{
+public:
+  explicit handler_work_base(int, int, const inline_executor&) noexcept
+  {
+  }
+
+  template <typename OtherExecutor>
+  handler_work_base(bool /*base1_owns_work*/, const inline_executor&,
+      const OtherExecutor& /*candidate*/) noexcept
+  {
+  }
+
+  bool owns_work() const noexcept
+  {
+    return false;
+  }
+
+  template <typename Function, typename Handler>
+  void dispatch(Function& function, Handler&)
+  {
+    // The handler has declared itself safe to run directly in the thread that
+    // completes the operation.
+    static_cast<Function&&>(function)();
+  }
+};
+
 template <typename Executor, typename IoContext>
 class handler_work_base<Executor, void, IoContext, Executor>
 {
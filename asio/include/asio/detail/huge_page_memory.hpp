@@ -0,0 +1,82 @@
+//
+// detail/huge_page_memory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_HUGE_PAGE_MEMORY_HPP
+#define ASIO_DETAIL_HUGE_PAGE_MEMORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A region of memory that is backed by huge pages where the platform allows.
+// Explicit huge pages are tried first. If none are available, the region is
+// mapped using normal pages and the kernel is advised to use transparent huge
+// pages. On platforms without memory mapping, the region is allocated from the
+// heap.
+class huge_page_memory
+  : private noncopyable
+{
+public:
+  // The size of a huge page.
+  enum { huge_page_size = 2 * 1024 * 1024 };
+
+  // Allocate a region of at least the specified size. Throws on failure.
+  ASIO_DECL explicit huge_page_memory(std::size_t size);
+
+  // Release the region.
+  ASIO_DECL ~huge_page_memory();
+
+  // Get a pointer to the start of the region.
+  void* data() const
+  {
+    return data_;
+  }
+
+  // Get the size of the region.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  // Whether the region is backed by explicit huge pages.
+  bool uses_huge_pages() const
+  {
+    return huge_pages_;
+  }
+
+private:
+  // How the region was obtained.
+  enum kind { heap, mapped };
+
+  void* data_;
+  std::size_t size_;
+  kind kind_;
+  bool huge_pages_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/huge_page_memory.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_HUGE_PAGE_MEMORY_HPP
@@ -405,6 +405,12 @@ int dev_poll_reactor::do_dev_poll_create()
   return fd;
 }
 
+void dev_poll_reactor::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void dev_poll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -0,0 +1,226 @@
+//
+// detail/impl/elastic_thread_group.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_ELASTIC_THREAD_GROUP_IPP
+#define ASIO_DETAIL_IMPL_ELASTIC_THREAD_GROUP_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <exception>
+#include "asio/detail/elastic_thread_group.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+struct elastic_thread_group::worker
+{
+  // The thread running the scheduler.
+  thread* thread_;
+
+  // Whether the thread has finished running the scheduler.
+  bool exited_;
+
+  // The next worker in the group.
+  worker* next_;
+};
+
+struct elastic_thread_group::worker_function
+{
+  elastic_thread_group* group_;
+  worker* worker_;
+
+  void operator()()
+  {
+#if !defined(ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+      group_->run_worker(worker_);
+#if !defined(ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+  }
+};
+
+struct elastic_thread_group::monitor_function
+{
+  elastic_thread_group* group_;
+
+  void operator()()
+  {
+    group_->run_monitor();
+  }
+};
+
+elastic_thread_group::elastic_thread_group(scheduler& sched,
+    std::size_t min_threads, std::size_t max_threads,
+    long growth_latency_usec, long idle_timeout_usec)
+  : scheduler_(sched),
+    min_threads_(min_threads),
+    max_threads_(max_threads),
+    growth_latency_usec_(growth_latency_usec),
+    idle_timeout_usec_(idle_timeout_usec),
+    stopping_(false),
+    num_threads_(0),
+    workers_(0),
+    monitor_(0)
+{
+  mutex::scoped_lock lock(mutex_);
+  for (std::size_t i = 0; i < min_threads_; ++i)
+    add_worker(lock);
+  monitor_function f = { this };
+  monitor_ = new thread(f);
+}
+
+elastic_thread_group::~elastic_thread_group()
+{
+  join();
+}
+
+std::size_t elastic_thread_group::size() const
+{
+  mutex::scoped_lock lock(mutex_);
+  return num_threads_;
+}
+
+void elastic_thread_group::join()
+{
+  mutex::scoped_lock lock(mutex_);
+
+  // Worker threads signal the event as they exit. The timed wait covers a
+  // scheduler that is stopped while there are no workers.
+  while (!scheduler_.stopped())
+  {
+    exit_event_.clear(lock);
+    exit_event_.wait_for_usec(lock, growth_latency_usec_);
+  }
+
+  stopping_ = true;
+  monitor_event_.signal_all(lock);
+  thread* monitor = monitor_;
+  monitor_ = 0;
+  lock.unlock();
+
+  if (monitor)
+  {
+    monitor->join();
+    delete monitor;
+  }
+
+  // No more workers can be added once the monitor has exited.
+  lock.lock();
+  worker* workers = workers_;
+  workers_ = 0;
+  lock.unlock();
+
+  while (workers)
+  {
+    workers->thread_->join();
+    worker* tmp = workers;
+    workers = workers->next_;
+    delete tmp->thread_;
+    delete tmp;
+  }
+}
+
+void elastic_thread_group::run_worker(worker* w)
+{
+  for (;;)
+  {
+    asio::error_code ec;
+    scheduler_.run_until_idle(idle_timeout_usec_, ec);
+
+    mutex::scoped_lock lock(mutex_);
+    if (scheduler_.stopped() || num_threads_ > min_threads_)
+    {
+      --num_threads_;
+      w->exited_ = true;
+      exit_event_.signal_all(lock);
+      return;
+    }
+  }
+}
+
+void elastic_thread_group::run_monitor()
+{
+  mutex::scoped_lock lock(mutex_);
+  scheduler::load_sample last_sample = scheduler_.sample_load();
+  while (!stopping_)
+  {
+    monitor_event_.wait_for_usec(lock, growth_latency_usec_);
+    if (stopping_)
+      break;
+
+    reap_workers(lock);
+
+    // Operations that were queued at the last sample and are still queued,
+    // with no thread having become idle in between, have waited for at least
+    // the growth latency.
+    scheduler::load_sample sample = scheduler_.sample_load();
+    if (sample.work_queued && last_sample.work_queued
+        && sample.idle_threads == 0
+        && sample.idle_transitions == last_sample.idle_transitions
+        && num_threads_ < max_threads_ && !scheduler_.stopped())
+      add_worker(lock);
+    last_sample = sample;
+  }
+}
+
+void elastic_thread_group::add_worker(mutex::scoped_lock&)
+{
+  scoped_ptr<worker> w(new worker);
+  w->exited_ = false;
+
+  // The worker cannot exit before the mutex is released, so it is always
+  // linked into the group first.
+  worker_function f = { this, w.get() };
+  w->thread_ = new thread(f);
+  w->next_ = workers_;
+  workers_ = w.release();
+  ++num_threads_;
+}
+
+void elastic_thread_group::reap_workers(mutex::scoped_lock&)
+{
+  // A worker marks itself as exited under the mutex just before its thread
+  // function returns, so these joins do not wait for long.
+  worker** w = &workers_;
+  while (*w)
+  {
+    if ((*w)->exited_)
+    {
+      worker* tmp = *w;
+      *w = tmp->next_;
+      tmp->thread_->join();
+      delete tmp->thread_;
+      delete tmp;
+    }
+    else
+      w = &(*w)->next_;
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_ELASTIC_THREAD_GROUP_IPP
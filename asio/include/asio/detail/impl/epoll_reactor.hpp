@@ -99,6 +99,75 @@ void epoll_reactor::move_timer(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
+template <typename Time_Traits>
+void epoll_reactor::schedule_timer(thread_timer_queue<Time_Traits>& queue,
+    const typename Time_Traits::time_type& time,
+    typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op)
+{
+  asio::detail::mutex::scoped_lock queue_lock(queue.mutex());
+
+  if (queue.is_shutdown())
+  {
+    queue_lock.unlock();
+    scheduler_.post_immediate_completion(op, false);
+    return;
+  }
+
+  bool earliest = queue.enqueue_timer(time, timer, op);
+  scheduler_.work_started();
+  queue_lock.unlock();
+
+  // The reactor's lock is needed only if its timeout may have to change.
+  if (earliest)
+  {
+    mutex::scoped_lock lock(mutex_);
+    update_timeout();
+  }
+}
+
+template <typename Time_Traits>
+std::size_t epoll_reactor::cancel_timer(thread_timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    std::size_t max_cancelled)
+{
+  asio::detail::mutex::scoped_lock queue_lock(queue.mutex());
+  op_queue<operation> ops;
+  std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  queue_lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+  return n;
+}
+
+template <typename Time_Traits>
+void epoll_reactor::cancel_timer_by_key(
+    thread_timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data* timer,
+    void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock queue_lock(queue.mutex());
+  op_queue<operation> ops;
+  queue.cancel_timer_by_key(timer, ops, cancellation_key);
+  queue_lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
+template <typename Time_Traits>
+void epoll_reactor::move_timer(thread_timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& target,
+    typename timer_queue<Time_Traits>::per_timer_data& source)
+{
+  asio::detail::mutex::scoped_lock queue_lock(queue.mutex());
+  op_queue<operation> ops;
+  queue.cancel_timer(target, ops);
+  queue.move_timer(target, source);
+  queue_lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
 } // namespace detail
 } // namespace asio
 
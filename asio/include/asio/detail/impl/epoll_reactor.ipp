@@ -44,7 +44,8 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(ctx.get_memory_resource())
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -143,6 +144,15 @@ void epoll_reactor::notify_fork(
   }
 }
 
+void epoll_reactor::add_memory_usage(
+    execution_context::memory_usage& usage) const
+{
+  // Freed objects are not returned to the heap, as events referring to them
+  // may still be delivered. They are reused for new registrations.
+  mutex::scoped_lock lock(registered_descriptors_mutex_);
+  usage.object_pool_bytes += registered_descriptors_.free_count() * sizeof(descriptor_state);
+}
+
 void epoll_reactor::init_task()
 {
   scheduler_.init_task();
@@ -611,6 +621,15 @@ void epoll_reactor::interrupt()
   epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
+bool epoll_reactor::has_work(operation* op)
+{
+  // A descriptor is returned for all of its ready events, even those for which
+  // it has no operations waiting.
+  if (op->completes_with(&descriptor_state::do_complete))
+    return static_cast<descriptor_state*>(op)->may_perform_io();
+  return true;
+}
+
 int epoll_reactor::do_epoll_create()
 {
 #if defined(EPOLL_CLOEXEC)
@@ -673,6 +692,19 @@ void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+void epoll_reactor::reserve_descriptors(std::size_t n)
+{
+  mutex::scoped_lock lock(registered_descriptors_mutex_);
+  registered_descriptors_.reserve(n, ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+}
+
+void epoll_reactor::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -762,6 +794,23 @@ epoll_reactor::descriptor_state::descriptor_state(bool locking)
 {
 }
 
+bool epoll_reactor::descriptor_state::may_perform_io()
+{
+  // The caller holds the scheduler's lock, so the descriptor's lock is only
+  // tried. If it is busy, the descriptor is assumed to have I/O to perform.
+  if (!mutex_.try_lock())
+    return true;
+
+  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+  bool result = false;
+  for (int j = 0; j < max_ops && !result; ++j)
+    if (task_result_ & (flag[j] | EPOLLERR | EPOLLHUP))
+      result = !op_queue_[j].empty();
+
+  mutex_.unlock();
+  return result;
+}
+
 operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
 {
   mutex_.lock();
@@ -0,0 +1,148 @@
+//
+// detail/impl/fair_executor_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_HPP
+#define ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Executor>
+class fair_executor_service::invoker
+{
+public:
+  invoker(const implementation_type& impl, Executor& ex)
+    : impl_(impl),
+      executor_(asio::prefer(ex, execution::outstanding_work.tracked))
+  {
+  }
+
+  invoker(const invoker& other)
+    : impl_(other.impl_),
+      executor_(other.executor_)
+  {
+  }
+
+  invoker(invoker&& other)
+    : impl_(static_cast<implementation_type&&>(other.impl_)),
+      executor_(static_cast<executor_type&&>(other.executor_))
+  {
+  }
+
+  struct on_invoker_exit
+  {
+    invoker* this_;
+
+    ~on_invoker_exit()
+    {
+      // Go to the back of the underlying executor's queue if there is more to
+      // do, so that other work is run first.
+      if (reschedule(this_->impl_))
+      {
+        executor_type ex = this_->executor_;
+        recycling_allocator<void> allocator;
+        asio::prefer(
+            asio::require(
+              static_cast<executor_type&&>(ex),
+              execution::blocking.never),
+            execution::allocator(allocator)
+          ).execute(static_cast<invoker&&>(*this_));
+      }
+    }
+  };
+
+  void operator()()
+  {
+    // Ensure the queue is scheduled again, if required, on block exit.
+    on_invoker_exit on_exit = { this };
+    (void)on_exit;
+
+    run_ready_functions(impl_);
+  }
+
+private:
+  typedef decay_t<
+      prefer_result_t<
+        Executor,
+        execution::outstanding_work_t::tracked_t
+      >
+    > executor_type;
+
+  implementation_type impl_;
+  executor_type executor_;
+};
+
+template <typename Executor, typename Function>
+inline void fair_executor_service::execute(const implementation_type& impl,
+    Executor& ex, Function&& function,
+    enable_if_t<
+      can_query<Executor, execution::allocator_t<void>>::value
+    >*)
+{
+  return fair_executor_service::do_execute(impl, ex,
+      static_cast<Function&&>(function),
+      asio::query(ex, execution::allocator));
+}
+
+template <typename Executor, typename Function>
+inline void fair_executor_service::execute(const implementation_type& impl,
+    Executor& ex, Function&& function,
+    enable_if_t<
+      !can_query<Executor, execution::allocator_t<void>>::value
+    >*)
+{
+  return fair_executor_service::do_execute(impl, ex,
+      static_cast<Function&&>(function),
+      std::allocator<void>());
+}
+
+template <typename Executor, typename Function, typename Allocator>
+void fair_executor_service::do_execute(const implementation_type& impl,
+    Executor& ex, Function&& function, const Allocator& a)
+{
+  typedef decay_t<Function> function_type;
+
+  // Allocate and construct an operation to wrap the function.
+  typedef executor_op<function_type, Allocator> op;
+  typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
+  p.p = new (p.v) op(static_cast<Function&&>(function), a);
+
+  ASIO_HANDLER_CREATION((impl->service_->context(), *p.p,
+        "fair_executor", impl.get(), 0, "execute"));
+
+  // Add the function to the queue, and give the queue another place in the
+  // underlying executor if it has not reached its concurrency limit.
+  bool schedule = enqueue(impl, p.p);
+  p.v = p.p = 0;
+  if (schedule)
+  {
+    recycling_allocator<void> allocator;
+    asio::prefer(
+        asio::require(ex, execution::blocking.never),
+        execution::allocator(allocator)
+      ).execute(invoker<Executor>(impl, ex));
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_HPP
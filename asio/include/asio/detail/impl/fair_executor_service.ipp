@@ -0,0 +1,163 @@
+//
+// detail/impl/fair_executor_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/call_stack.hpp"
+#include "asio/detail/fair_executor_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+fair_executor_service::fair_executor_service(execution_context& ctx)
+  : execution_context_service_base<fair_executor_service>(ctx),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+void fair_executor_service::shutdown()
+{
+  op_queue<scheduler_operation> ops;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  fair_impl* impl = impl_list_;
+  while (impl)
+  {
+    impl->mutex_.lock();
+    impl->shutdown_ = true;
+    ops.push(impl->queue_);
+    impl->mutex_.unlock();
+    impl = impl->next_;
+  }
+}
+
+fair_executor_service::implementation_type
+fair_executor_service::create_implementation(
+    std::size_t weight, std::size_t concurrency)
+{
+  implementation_type new_impl = allocate_shared<fair_impl>(
+      memory_resource_allocator<fair_impl>(
+        &context().get_memory_resource()));
+  new_impl->shutdown_ = false;
+  new_impl->weight_ = weight > 0 ? weight : 1;
+  new_impl->concurrency_ = concurrency > 0 ? concurrency : 1;
+  new_impl->scheduled_ = 0;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  // Insert implementation into linked list of all implementations.
+  new_impl->next_ = impl_list_;
+  new_impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = new_impl.get();
+  impl_list_ = new_impl.get();
+  new_impl->service_ = this;
+
+  return new_impl;
+}
+
+fair_executor_service::fair_impl::~fair_impl()
+{
+  asio::detail::mutex::scoped_lock lock(service_->mutex_);
+
+  // Remove implementation from linked list of all implementations.
+  if (service_->impl_list_ == this)
+    service_->impl_list_ = next_;
+  if (prev_)
+    prev_->next_ = next_;
+  if (next_)
+    next_->prev_= prev_;
+}
+
+bool fair_executor_service::running_in_this_thread(
+    const implementation_type& impl)
+{
+  return !!call_stack<fair_impl>::contains(impl.get());
+}
+
+std::size_t fair_executor_service::get_weight(
+    const implementation_type& impl)
+{
+  return impl->weight_;
+}
+
+std::size_t fair_executor_service::get_concurrency(
+    const implementation_type& impl)
+{
+  return impl->concurrency_;
+}
+
+bool fair_executor_service::enqueue(const implementation_type& impl,
+    scheduler_operation* op)
+{
+  asio::detail::mutex::scoped_lock lock(impl->mutex_);
+  if (impl->shutdown_)
+  {
+    lock.unlock();
+    op->destroy();
+    return false;
+  }
+
+  impl->queue_.push(op);
+  if (impl->scheduled_ < impl->concurrency_)
+  {
+    ++impl->scheduled_;
+    return true;
+  }
+  return false;
+}
+
+void fair_executor_service::run_ready_functions(
+    const implementation_type& impl)
+{
+  // Indicate that this queue is executing on the current thread.
+  call_stack<fair_impl>::context ctx(impl.get());
+
+  // Each function is taken from the queue separately, so that other threads
+  // holding a place for this queue can run the functions that follow it.
+  asio::error_code ec;
+  for (std::size_t n = 0; n < impl->weight_; ++n)
+  {
+    asio::detail::mutex::scoped_lock lock(impl->mutex_);
+    scheduler_operation* o = impl->queue_.front();
+    if (!o)
+      break;
+    impl->queue_.pop();
+    lock.unlock();
+
+    o->complete(impl.get(), ec, 0);
+  }
+}
+
+bool fair_executor_service::reschedule(const implementation_type& impl)
+{
+  asio::detail::mutex::scoped_lock lock(impl->mutex_);
+  if (!impl->shutdown_ && !impl->queue_.empty())
+    return true;
+  --impl->scheduled_;
+  return false;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_FAIR_EXECUTOR_SERVICE_IPP
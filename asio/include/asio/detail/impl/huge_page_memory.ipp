@@ -0,0 +1,97 @@
+//
+// detail/impl/huge_page_memory.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_HUGE_PAGE_MEMORY_IPP
+#define ASIO_DETAIL_IMPL_HUGE_PAGE_MEMORY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/huge_page_memory.hpp"
+#include "asio/detail/memory.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/mman.h>
+# include <cerrno>
+# include "asio/detail/throw_error.hpp"
+# include "asio/error.hpp"
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+huge_page_memory::huge_page_memory(std::size_t size)
+  : data_(0),
+    size_((size + huge_page_size - 1) / huge_page_size * huge_page_size),
+    kind_(heap),
+    huge_pages_(false)
+{
+  if (size_ == 0)
+    size_ = huge_page_size;
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  void* p = MAP_FAILED;
+
+# if defined(MAP_HUGETLB)
+  p = ::mmap(0, size_, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED)
+  {
+    data_ = p;
+    kind_ = mapped;
+    huge_pages_ = true;
+    return;
+  }
+# endif // defined(MAP_HUGETLB)
+
+  // No huge pages are reserved, so fall back to normal pages.
+  p = ::mmap(0, size_, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "mmap");
+  }
+
+# if defined(MADV_HUGEPAGE)
+  ::madvise(p, size_, MADV_HUGEPAGE);
+# endif // defined(MADV_HUGEPAGE)
+
+  data_ = p;
+  kind_ = mapped;
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  data_ = aligned_new(ASIO_CACHE_LINE_SIZE, size_);
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+huge_page_memory::~huge_page_memory()
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  if (kind_ == mapped)
+  {
+    ::munmap(data_, size_);
+    return;
+  }
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  aligned_delete(data_);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_HUGE_PAGE_MEMORY_IPP
@@ -44,6 +44,7 @@ io_uring_service::io_uring_service(asio::execution_context& ctx)
     shutdown_(false),
     timeout_(),
     registration_mutex_(mutex_.enabled()),
+    registered_io_objects_(ctx.get_memory_resource()),
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
     event_fd_(-1)
@@ -183,6 +184,15 @@ void io_uring_service::notify_fork(
   }
 }
 
+void io_uring_service::add_memory_usage(
+    execution_context::memory_usage& usage) const
+{
+  // Freed objects are not returned to the heap, as events referring to them
+  // may still be delivered. They are reused for new registrations.
+  mutex::scoped_lock lock(registration_mutex_);
+  usage.object_pool_bytes += registered_io_objects_.free_count() * sizeof(io_object);
+}
+
 void io_uring_service::init_task()
 {
   scheduler_.init_task();
@@ -663,6 +673,19 @@ bool io_uring_service::do_cancel_ops(
   return cancel_op;
 }
 
+void io_uring_service::reserve_descriptors(std::size_t n)
+{
+  mutex::scoped_lock lock(registration_mutex_);
+  registered_io_objects_.reserve(n, ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+}
+
+void io_uring_service::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void io_uring_service::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -51,7 +51,8 @@ kqueue_reactor::kqueue_reactor(asio::execution_context& ctx)
     kqueue_fd_(do_kqueue_create()),
     interrupter_(),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(ctx.get_memory_resource())
 {
   struct kevent events[1];
   ASIO_KQUEUE_EV_SET(&events[0], interrupter_.read_descriptor(),
@@ -133,6 +134,15 @@ void kqueue_reactor::notify_fork(
   }
 }
 
+void kqueue_reactor::add_memory_usage(
+    execution_context::memory_usage& usage) const
+{
+  // Freed objects are not returned to the heap, as events referring to them
+  // may still be delivered. They are reused for new registrations.
+  mutex::scoped_lock lock(registered_descriptors_mutex_);
+  usage.object_pool_bytes += registered_descriptors_.free_count() * sizeof(descriptor_state);
+}
+
 void kqueue_reactor::init_task()
 {
   scheduler_.init_task();
@@ -572,6 +582,19 @@ void kqueue_reactor::free_descriptor_state(kqueue_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+void kqueue_reactor::reserve_descriptors(std::size_t n)
+{
+  mutex::scoped_lock lock(registered_descriptors_mutex_);
+  registered_descriptors_.reserve(n, ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+}
+
+void kqueue_reactor::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void kqueue_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -0,0 +1,195 @@
+//
+// detail/impl/offload_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_OFFLOAD_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_OFFLOAD_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/offload.hpp"
+#include "asio/detail/concurrency_hint.hpp"
+#include "asio/detail/offload_service.hpp"
+#include "asio/detail/signal_blocker.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class offload_service::work_scheduler_runner
+{
+public:
+  work_scheduler_runner(scheduler_impl& work_scheduler)
+    : work_scheduler_(work_scheduler)
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    work_scheduler_.run(ec);
+  }
+
+private:
+  scheduler_impl& work_scheduler_;
+};
+
+offload_service::offload_service(execution_context& context)
+  : execution_context_service_base<offload_service>(context),
+    scheduler_(asio::use_service<scheduler_impl>(context)),
+    work_scheduler_(new scheduler_impl(context, -1, false)),
+    num_threads_(0),
+    max_threads_(offload_options().max_threads),
+    num_queued_(0),
+    max_queued_(offload_options().max_queued),
+    num_running_(0),
+    caller_runs_(offload_options().overflow == offload_options::caller_runs)
+{
+  work_scheduler_->work_started();
+}
+
+offload_service::~offload_service()
+{
+  shutdown();
+}
+
+void offload_service::shutdown()
+{
+  if (work_scheduler_.get())
+  {
+    work_scheduler_->work_finished();
+    work_scheduler_->stop();
+    threads_.join();
+    num_threads_ = 0;
+    work_scheduler_.reset();
+  }
+}
+
+void offload_service::notify_fork(execution_context::fork_event fork_ev)
+{
+  if (!work_scheduler_.get())
+    return;
+
+  if (fork_ev == execution_context::fork_prepare)
+  {
+    work_scheduler_->stop();
+    threads_.join();
+
+    mutex::scoped_lock lock(mutex_);
+    num_threads_ = 0;
+  }
+  else
+  {
+    work_scheduler_->restart();
+
+    // Replace the threads that were running queued functions.
+    mutex::scoped_lock lock(mutex_);
+    while (num_threads_ < num_queued_ + num_running_
+        && num_threads_ < max_threads_)
+      maybe_start_thread(lock);
+  }
+}
+
+offload_options offload_service::get_options() const
+{
+  mutex::scoped_lock lock(mutex_);
+  offload_options options;
+  options.max_threads = max_threads_;
+  options.max_queued = max_queued_;
+  options.overflow = caller_runs_
+    ? offload_options::caller_runs : offload_options::reject;
+  return options;
+}
+
+void offload_service::set_options(const offload_options& options)
+{
+  mutex::scoped_lock lock(mutex_);
+  max_threads_ = options.max_threads > 0 ? options.max_threads : 1;
+  max_queued_ = options.max_queued;
+  caller_runs_ = options.overflow == offload_options::caller_runs;
+}
+
+void offload_service::start_offload_op(offload_op* op)
+{
+  if (!ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER,
+        scheduler_.concurrency_hint()))
+  {
+    op->ec_ = asio::error::operation_not_supported;
+    scheduler_.post_immediate_completion(op, false);
+    return;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+
+  // Functions run by callers are also counted as running, so there may be
+  // more running functions than threads.
+  std::size_t idle_threads = num_threads_ > num_running_
+    ? num_threads_ - num_running_ : 0;
+  if (num_queued_ >= max_queued_ + idle_threads
+      && num_threads_ >= max_threads_)
+  {
+    if (!caller_runs_)
+    {
+      lock.unlock();
+      op->ec_ = asio::error::try_again;
+      scheduler_.post_immediate_completion(op, false);
+      return;
+    }
+
+    // Run the function in the calling thread, which passes the operation to
+    // the context's scheduler for completion.
+    ++num_queued_;
+    lock.unlock();
+    scheduler_.work_started();
+    op->complete(work_scheduler_.get(), asio::error_code(), 0);
+    return;
+  }
+
+  ++num_queued_;
+  maybe_start_thread(lock);
+  lock.unlock();
+
+  scheduler_.work_started();
+  work_scheduler_->post_immediate_completion(op, false);
+}
+
+void offload_service::offload_op_started()
+{
+  mutex::scoped_lock lock(mutex_);
+  --num_queued_;
+  ++num_running_;
+}
+
+void offload_service::offload_op_finished()
+{
+  mutex::scoped_lock lock(mutex_);
+  --num_running_;
+}
+
+void offload_service::maybe_start_thread(mutex::scoped_lock&)
+{
+  if (num_threads_ < num_queued_ + num_running_
+      && num_threads_ < max_threads_)
+  {
+    asio::detail::signal_blocker sb;
+    threads_.create_thread(work_scheduler_runner(*work_scheduler_));
+    ++num_threads_;
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_OFFLOAD_SERVICE_IPP
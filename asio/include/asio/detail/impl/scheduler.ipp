@@ -69,6 +69,7 @@ struct scheduler::task_cleanup
     // the operation queue.
     lock_->lock();
     scheduler_->task_interrupted_ = true;
+    this_thread_->running_task = false;
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
   }
@@ -82,7 +83,22 @@ struct scheduler::work_cleanup
 {
   ~work_cleanup()
   {
-    if (this_thread_->private_outstanding_work > 1)
+    if (this_thread_->defers_work_finished)
+    {
+      // Operations posted by the handler reuse the work of this and earlier
+      // completed operations, so the count is only touched when the handler
+      // posted more than the thread has completed.
+      long work = this_thread_->private_outstanding_work
+        - this_thread_->deferred_work_finished - 1;
+      if (work > 0)
+      {
+        asio::detail::increment(scheduler_->outstanding_work_, work);
+        this_thread_->deferred_work_finished = 0;
+      }
+      else
+        this_thread_->deferred_work_finished = -work;
+    }
+    else if (this_thread_->private_outstanding_work > 1)
     {
       asio::detail::increment(
           scheduler_->outstanding_work_,
@@ -108,6 +124,86 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::affine_cleanup
+{
+  ~affine_cleanup()
+  {
+#if defined(ASIO_HAS_THREADS)
+    if (this_thread_->affine_op_limit == 0)
+      return;
+
+    if (!lock_->locked())
+      lock_->lock();
+    scheduler_->remove_affine_thread(*this_thread_);
+
+    if (!this_thread_->affine_op_queue.empty())
+    {
+      // Operations that could not be run on this thread are returned to the
+      // main queue so that another thread may run them.
+      scheduler_->op_queue_.push(this_thread_->affine_op_queue);
+      this_thread_->affine_op_count = 0;
+      if (scheduler_->stopped_)
+        lock_->unlock();
+      else
+        scheduler_->wake_one_thread_and_unlock(*lock_);
+    }
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::deferred_work_cleanup
+{
+  ~deferred_work_cleanup()
+  {
+    if (this_thread_->deferred_work_finished > 0)
+    {
+      if (!lock_->locked())
+        lock_->lock();
+      scheduler_->flush_deferred_work(*lock_, *this_thread_);
+    }
+    this_thread_->defers_work_finished = false;
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::cache_report_cleanup
+{
+  ~cache_report_cleanup()
+  {
+    if (this_thread_->reported_cache_bytes > 0)
+    {
+      if (!lock_->locked())
+        lock_->lock();
+      scheduler_->thread_cache_bytes_ -= this_thread_->reported_cache_bytes;
+      this_thread_->reported_cache_bytes = 0;
+    }
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::completion_wait_cleanup
+{
+  ~completion_wait_cleanup()
+  {
+    if (lock_->locked())
+      lock_->unlock();
+    scheduler_->work_finished();
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+};
+
 scheduler::scheduler(asio::execution_context& ctx,
     int concurrency_hint, bool own_thread, get_task_func_type get_task)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -125,7 +221,14 @@ scheduler::scheduler(asio::execution_context& ctx,
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
-    thread_(0)
+    thread_(0),
+    memory_generation_(1),
+    thread_cache_limit_(ctx.get_memory_limits().thread_cache_bytes),
+    thread_cache_depth_(ctx.get_memory_limits().thread_cache_depth),
+    thread_cache_bytes_(0),
+    idle_threads_(0),
+    idle_transitions_(0),
+    affine_threads_(0)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -179,6 +282,28 @@ void scheduler::shutdown()
   task_ = 0;
 }
 
+void scheduler::add_memory_usage(
+    execution_context::memory_usage& usage) const
+{
+  mutex::scoped_lock lock(mutex_);
+  usage.thread_cache_bytes += thread_cache_bytes_;
+}
+
+void scheduler::trim_memory()
+{
+  mutex::scoped_lock lock(mutex_);
+  start_memory_generation(lock);
+}
+
+void scheduler::set_memory_limits(
+    const execution_context::memory_limits& limits)
+{
+  mutex::scoped_lock lock(mutex_);
+  thread_cache_limit_ = limits.thread_cache_bytes;
+  thread_cache_depth_ = limits.thread_cache_depth;
+  start_memory_generation(lock);
+}
+
 void scheduler::init_task()
 {
   mutex::scoped_lock lock(mutex_);
@@ -205,6 +330,23 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   mutex::scoped_lock lock(mutex_);
 
+  // Threads that stay inside the scheduler report the size of their cache.
+  this_thread.reports_cache_bytes = true;
+  cache_report_cleanup on_exit_report = { this, &lock, &this_thread };
+  (void)on_exit_report;
+
+  // Only threads that stay inside the scheduler accept affine operations.
+  if (!one_thread_)
+    add_affine_thread(this_thread);
+  affine_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+
+  // Threads that stay inside the scheduler defer removing the work of
+  // completed operations until they block or leave.
+  this_thread.defers_work_finished = true;
+  deferred_work_cleanup on_exit_work = { this, &lock, &this_thread };
+  (void)on_exit_work;
+
   std::size_t n = 0;
   for (; do_run_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
@@ -230,6 +372,45 @@ std::size_t scheduler::run_one(asio::error_code& ec)
   return do_run_one(lock, this_thread, ec);
 }
 
+std::size_t scheduler::run_until_idle(long usec, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (outstanding_work_ == 0)
+  {
+    stop();
+    return 0;
+  }
+
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  thread_call_stack::context ctx(this, this_thread);
+
+  mutex::scoped_lock lock(mutex_);
+
+  // Threads that stay inside the scheduler report the size of their cache.
+  this_thread.reports_cache_bytes = true;
+  cache_report_cleanup on_exit_report = { this, &lock, &this_thread };
+  (void)on_exit_report;
+
+  // Only threads that stay inside the scheduler accept affine operations.
+  if (!one_thread_)
+    add_affine_thread(this_thread);
+  affine_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+
+  // Threads that stay inside the scheduler defer removing the work of
+  // completed operations until they block or leave.
+  this_thread.defers_work_finished = true;
+  deferred_work_cleanup on_exit_work = { this, &lock, &this_thread };
+  (void)on_exit_work;
+
+  std::size_t n = 0;
+  for (; do_run_one(lock, this_thread, ec, usec); lock.lock())
+    if (n != (std::numeric_limits<std::size_t>::max)())
+      ++n;
+  return n;
+}
+
 std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
 {
   ec = asio::error_code();
@@ -248,6 +429,69 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
   return do_wait_one(lock, this_thread, usec, ec);
 }
 
+std::size_t scheduler::run_until_complete(
+    const bool& complete, asio::error_code& ec)
+{
+  ec = asio::error_code();
+
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  thread_call_stack::context ctx(this, this_thread);
+
+  mutex::scoped_lock lock(mutex_);
+  if (complete)
+    return 0;
+
+  // The wait counts as work, so that the scheduler does not run out of work
+  // while the operation is outstanding on some other execution context.
+  work_started();
+  completion_wait_cleanup on_exit = { this, &lock };
+  (void)on_exit;
+
+#if defined(ASIO_HAS_THREADS)
+  // The operation may depend on handlers that an outer call on this thread
+  // has kept on its private or affine queues, so they are moved to the main
+  // queue along with their work. Work that the outer call has finished but
+  // not yet subtracted is released now, as that call does not resume until
+  // the wait is over.
+  if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+  {
+    op_queue_.push(outer_info->private_op_queue);
+    op_queue_.push(outer_info->affine_op_queue);
+    outer_info->affine_op_count = 0;
+    if (outer_info->private_outstanding_work > 0)
+    {
+      asio::detail::increment(outstanding_work_,
+          outer_info->private_outstanding_work);
+      outer_info->private_outstanding_work = 0;
+    }
+    if (outer_info->deferred_work_finished > 0)
+      flush_deferred_work(lock, *outer_info);
+  }
+#endif // defined(ASIO_HAS_THREADS)
+
+  std::size_t n = 0;
+  for (; do_run_one(lock, this_thread, ec, -1, &complete); lock.lock())
+    if (n != (std::numeric_limits<std::size_t>::max)())
+      ++n;
+  return n;
+}
+
+void scheduler::notify_complete(bool& complete)
+{
+  mutex::scoped_lock lock(mutex_);
+  complete = true;
+
+  // The waiting thread may be idle or running the task. The flag must not be
+  // touched once the mutex is released, as the waiter may then return.
+  wakeup_event_.signal_all(lock);
+  if (!task_interrupted_ && task_)
+  {
+    task_interrupted_ = true;
+    task_->interrupt();
+  }
+}
+
 std::size_t scheduler::poll(asio::error_code& ec)
 {
   ec = asio::error_code();
@@ -318,6 +562,14 @@ bool scheduler::stopped() const
   return stopped_;
 }
 
+scheduler::load_sample scheduler::sample_load() const
+{
+  mutex::scoped_lock lock(mutex_);
+  load_sample sample = { !op_queue_.empty(), idle_threads_,
+    idle_transitions_, task_ != 0 && !task_interrupted_ };
+  return sample;
+}
+
 void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
@@ -346,12 +598,23 @@ void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
 #if defined(ASIO_HAS_THREADS)
-  if (one_thread_ || is_continuation)
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
   {
-    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    thread_info* info = static_cast<thread_info*>(this_thread);
+    if (one_thread_ || is_continuation)
     {
-      ++static_cast<thread_info*>(this_thread)->private_outstanding_work;
-      static_cast<thread_info*>(this_thread)->private_op_queue.push(op);
+      ++info->private_outstanding_work;
+      info->private_op_queue.push(op);
+      return;
+    }
+
+    // Reuse the work of an operation already completed by this thread.
+    if (info->deferred_work_finished > 0)
+    {
+      --info->deferred_work_finished;
+      mutex::scoped_lock lock(mutex_);
+      op_queue_.push(op);
+      wake_one_thread_and_unlock(lock);
       return;
     }
   }
@@ -368,27 +631,136 @@ void scheduler::post_immediate_completion(
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+  long work = static_cast<long>(n);
+
 #if defined(ASIO_HAS_THREADS)
-  if (one_thread_ || is_continuation)
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
   {
-    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    thread_info* info = static_cast<thread_info*>(this_thread);
+    if (one_thread_ || is_continuation)
     {
-      static_cast<thread_info*>(this_thread)->private_outstanding_work
-        += static_cast<long>(n);
-      static_cast<thread_info*>(this_thread)->private_op_queue.push(ops);
+      info->private_outstanding_work += work;
+      info->private_op_queue.push(ops);
       return;
     }
+
+    // Reuse the work of operations already completed by this thread.
+    long reused = info->deferred_work_finished < work
+      ? info->deferred_work_finished : work;
+    info->deferred_work_finished -= reused;
+    work -= reused;
   }
 #else // defined(ASIO_HAS_THREADS)
   (void)is_continuation;
 #endif // defined(ASIO_HAS_THREADS)
 
-  increment(outstanding_work_, static_cast<long>(n));
+  if (work > 0)
+    increment(outstanding_work_, work);
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(ops);
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::post_affine_completion(scheduler::operation* op,
+    thread_info_base* preferred_thread, bool is_continuation)
+{
+#if defined(ASIO_HAS_THREADS)
+  if (preferred_thread == 0)
+  {
+    // No thread is preferred.
+  }
+  else if (thread_call_stack::contains(this) == preferred_thread)
+  {
+    thread_info* info = static_cast<thread_info*>(preferred_thread);
+    if (info->affine_op_count < info->affine_op_limit)
+    {
+      ++info->private_outstanding_work;
+      ++info->affine_op_count;
+      info->affine_op_queue.push(op);
+      return;
+    }
+  }
+  else
+  {
+    // The preferred thread may have left the scheduler, so it is only used if
+    // it is still in the list of threads that accept affine operations. A
+    // thread running the task can be woken on its own by interrupting the
+    // task, whereas a thread that is running a handler or waiting for work is
+    // not given the operation, as it would then wait on that thread.
+    mutex::scoped_lock lock(mutex_);
+    for (thread_info* info = affine_threads_;
+        info != 0; info = info->next_affine_thread)
+    {
+      if (info == preferred_thread)
+      {
+        if (info->running_task
+            && info->remote_affine_op_count < max_affine_ops)
+        {
+          work_started();
+          ++info->remote_affine_op_count;
+          info->remote_affine_op_queue.push(op);
+          if (!task_interrupted_ && task_)
+          {
+            task_interrupted_ = true;
+            task_->interrupt();
+          }
+          return;
+        }
+        break;
+      }
+    }
+  }
+#else // defined(ASIO_HAS_THREADS)
+  (void)preferred_thread;
+#endif // defined(ASIO_HAS_THREADS)
+
+  post_immediate_completion(op, is_continuation);
+}
+
+bool scheduler::has_queued_handlers()
+{
+  operation* o = op_queue_.front();
+  return o != 0 && (o != &task_operation_ || op_queue_access::next(o) != 0);
+}
+
+void scheduler::add_affine_thread(scheduler::thread_info& this_thread)
+{
+  this_thread.affine_op_limit = max_affine_ops;
+  this_thread.next_affine_thread = affine_threads_;
+  affine_threads_ = &this_thread;
+}
+
+void scheduler::remove_affine_thread(scheduler::thread_info& this_thread)
+{
+  thread_info** link = &affine_threads_;
+  while (*link != &this_thread)
+    link = &(*link)->next_affine_thread;
+  *link = this_thread.next_affine_thread;
+  this_thread.next_affine_thread = 0;
+
+  this_thread.affine_op_queue.push(this_thread.remote_affine_op_queue);
+  this_thread.remote_affine_op_count = 0;
+}
+
+bool scheduler::share_affine_operations(scheduler::thread_info& this_thread)
+{
+#if defined(ASIO_HAS_THREADS)
+  if (!this_thread.affine_op_queue.empty()
+      && (idle_threads_ > 0 || (task_ && !task_interrupted_)))
+  {
+    // The thread is about to run a handler, which may take some time. Rather
+    // than keep its affine operations waiting while other threads are idle or
+    // blocked in the task, give them to the main queue.
+    op_queue_.push(this_thread.affine_op_queue);
+    this_thread.affine_op_count = 0;
+    return true;
+  }
+#else // defined(ASIO_HAS_THREADS)
+  (void)this_thread;
+#endif // defined(ASIO_HAS_THREADS)
+  return false;
+}
+
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
 #if defined(ASIO_HAS_THREADS)
@@ -447,20 +819,77 @@ void scheduler::abandon_operations(
 
 std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
-    const asio::error_code& ec)
+    const asio::error_code& ec, long idle_usec, const bool* complete)
 {
-  while (!stopped_)
+  // A thread waiting for an operation to complete keeps running handlers
+  // even if the scheduler is stopped, as a synchronous operation would.
+  while (!stopped_ || complete)
   {
+    if (complete && *complete)
+      return 0;
+
+    if (update_thread_cache(lock, this_thread))
+      continue;
+
+#if defined(ASIO_HAS_THREADS)
+    if (this_thread.remote_affine_op_count > 0)
+    {
+      // Take the operations that other threads gave to this thread while it
+      // was running the task.
+      this_thread.affine_op_queue.push(this_thread.remote_affine_op_queue);
+      this_thread.affine_op_count += this_thread.remote_affine_op_count;
+      this_thread.remote_affine_op_count = 0;
+    }
+
+    if (!this_thread.affine_op_queue.empty()
+        && (this_thread.affine_run_count < max_affine_run
+          || !has_queued_handlers()))
+    {
+      // Prefer operations that asked to run on this thread, but only for a
+      // bounded number of turns while there is other work waiting.
+      operation* o = this_thread.affine_op_queue.front();
+      this_thread.affine_op_queue.pop();
+      --this_thread.affine_op_count;
+      ++this_thread.affine_run_count;
+      std::size_t task_result = o->task_result_;
+
+      if (share_affine_operations(this_thread))
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      this_thread.handler_started();
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(this, ec, task_result);
+      this_thread.rethrow_pending_exception();
+
+      return 1;
+    }
+#endif // defined(ASIO_HAS_THREADS)
+
     if (!op_queue_.empty())
     {
       // Prepare to execute first handler from queue.
       operation* o = op_queue_.front();
+      if (o == &task_operation_ && this_thread.deferred_work_finished > 0)
+      {
+        // The task may block, so the thread's deferred work is removed first.
+        flush_deferred_work(lock, this_thread);
+        continue;
+      }
+
       op_queue_.pop();
       bool more_handlers = (!op_queue_.empty());
 
       if (o == &task_operation_)
       {
         task_interrupted_ = more_handlers;
+        this_thread.running_task = true;
 
         if (more_handlers && !one_thread_)
           wakeup_event_.unlock_and_signal_one(lock);
@@ -471,13 +900,20 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         (void)on_exit;
 
         // Run the task. May throw an exception. Only block if the operation
-        // queue is empty and we're not polling, otherwise we want to return
-        // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        // queue is empty, we're not polling, and there are no operations
+        // waiting to run on this thread, otherwise we want to return as soon
+        // as possible.
+        task_->run(more_handlers || !this_thread.affine_op_queue.empty()
+            ? 0 : -1, this_thread.private_op_queue);
       }
       else
       {
         std::size_t task_result = o->task_result_;
+#if defined(ASIO_HAS_THREADS)
+        this_thread.affine_run_count = 0;
+        if (share_affine_operations(this_thread))
+          more_handlers = true;
+#endif // defined(ASIO_HAS_THREADS)
 
         if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
@@ -488,6 +924,8 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         work_cleanup on_exit = { this, &lock, &this_thread };
         (void)on_exit;
 
+        this_thread.handler_started();
+
         // Complete the operation. May throw an exception. Deletes the object.
         o->complete(this, ec, task_result);
         this_thread.rethrow_pending_exception();
@@ -495,10 +933,26 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         return 1;
       }
     }
+    else if (this_thread.deferred_work_finished > 0)
+    {
+      // Remove the thread's deferred work before it waits, as the wait ends
+      // only when the count of outstanding work drops to zero.
+      flush_deferred_work(lock, this_thread);
+    }
     else
     {
+      ++idle_threads_;
+      ++idle_transitions_;
       wakeup_event_.clear(lock);
-      wakeup_event_.wait(lock);
+      if (idle_usec < 0)
+        wakeup_event_.wait(lock);
+      else if (!wakeup_event_.wait_for_usec(lock, idle_usec)
+          && op_queue_.empty())
+      {
+        --idle_threads_;
+        return 0;
+      }
+      --idle_threads_;
     }
   }
 
@@ -515,8 +969,11 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   operation* o = op_queue_.front();
   if (o == 0)
   {
+    ++idle_threads_;
+    ++idle_transitions_;
     wakeup_event_.clear(lock);
     wakeup_event_.wait_for_usec(lock, usec);
+    --idle_threads_;
     usec = 0; // Wait at most once.
     o = op_queue_.front();
   }
@@ -569,6 +1026,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
 
+  this_thread.handler_started();
+
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
@@ -624,6 +1083,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
 
+  this_thread.handler_started();
+
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
@@ -631,6 +1092,28 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   return 1;
 }
 
+bool scheduler::has_waiting_work()
+{
+  // Handlers that the calling thread keeps for itself can only run once the
+  // current handler returns, even if other threads are idle.
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    thread_info* info = static_cast<thread_info*>(this_thread);
+    if (!info->private_op_queue.empty() || !info->affine_op_queue.empty())
+      return true;
+  }
+
+  // The task is not counted, as it is always queued while it is not running.
+  // Nor are operations the task returned that turn out to have nothing to do.
+  mutex::scoped_lock lock(mutex_);
+  if (idle_threads_ != 0)
+    return false;
+  for (operation* o = op_queue_.front(); o; o = op_queue_access::next(o))
+    if (o != &task_operation_ && (!task_ || task_->has_work(o)))
+      return true;
+  return false;
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
@@ -644,6 +1127,15 @@ void scheduler::stop_all_threads(
   }
 }
 
+void scheduler::flush_deferred_work(
+    mutex::scoped_lock& lock, scheduler::thread_info& this_thread)
+{
+  long work = this_thread.deferred_work_finished;
+  this_thread.deferred_work_finished = 0;
+  if ((outstanding_work_ -= work) == 0)
+    stop_all_threads(lock);
+}
+
 void scheduler::wake_one_thread_and_unlock(
     mutex::scoped_lock& lock)
 {
@@ -658,6 +1150,49 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+void scheduler::start_memory_generation(mutex::scoped_lock& lock)
+{
+  ++memory_generation_;
+  wakeup_event_.signal_all(lock);
+
+  if (!task_interrupted_ && task_)
+  {
+    task_interrupted_ = true;
+    task_->interrupt();
+  }
+}
+
+bool scheduler::update_thread_cache(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  if (this_thread.memory_generation != memory_generation_)
+  {
+    // A thread that has only just entered the scheduler starts with an empty
+    // cache, and so only needs to apply the cache limit.
+    bool trim = this_thread.memory_generation != 0;
+    this_thread.memory_generation = memory_generation_;
+    this_thread.set_cache_limit(thread_cache_limit_);
+    this_thread.set_cache_depth(thread_cache_depth_);
+    if (trim)
+    {
+      lock.unlock();
+      this_thread.trim();
+      lock.lock();
+      return true;
+    }
+  }
+
+  if (this_thread.reports_cache_bytes)
+  {
+    std::size_t cache_bytes = this_thread.statistics().cached_bytes;
+    thread_cache_bytes_ += cache_bytes;
+    thread_cache_bytes_ -= this_thread.reported_cache_bytes;
+    this_thread.reported_cache_bytes = cache_bytes;
+  }
+
+  return false;
+}
+
 scheduler_task* scheduler::get_default_task(asio::execution_context& ctx)
 {
 #if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
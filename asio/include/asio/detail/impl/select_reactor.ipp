@@ -349,6 +349,12 @@ void select_reactor::restart_reactor::do_complete(void* owner, operation* base,
 }
 #endif // defined(ASIO_HAS_IOCP)
 
+void select_reactor::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void select_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
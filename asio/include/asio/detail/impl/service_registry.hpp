@@ -82,7 +82,23 @@ void service_registry::init_key_from_id(execution_context::service::key& key,
 template <typename Service, typename Owner>
 execution_context::service* service_registry::create(void* owner)
 {
-  return new Service(*static_cast<Owner*>(owner));
+  return create_service<Service>(*static_cast<Owner*>(owner));
+}
+
+template <typename Service, typename Owner, typename... Args>
+Service* service_registry::create_service(Owner& owner, Args&&... args)
+{
+  Service* new_service = resource_new<Service>(
+      owner.get_memory_resource(), owner, static_cast<Args&&>(args)...);
+  new_service->destroy_ = &service_registry::destroy_service<Service>;
+  return new_service;
+}
+
+template <typename Service>
+void service_registry::destroy_service(execution_context::service* service)
+{
+  resource_delete(service->owner_.get_memory_resource(),
+      static_cast<Service*>(service));
 }
 
 } // namespace detail
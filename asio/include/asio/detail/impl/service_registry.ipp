@@ -57,19 +57,8 @@ void service_registry::destroy_services()
 
 void service_registry::notify_fork(execution_context::fork_event fork_ev)
 {
-  // Make a copy of all of the services while holding the lock. We don't want
-  // to hold the lock while calling into each service, as it may try to call
-  // back into this class.
   std::vector<execution_context::service*> services;
-  {
-    asio::detail::mutex::scoped_lock lock(mutex_);
-    execution_context::service* service = first_service_;
-    while (service)
-    {
-      services.push_back(service);
-      service = service->next_;
-    }
-  }
+  copy_services(services);
 
   // If processing the fork_prepare event, we want to go in reverse order of
   // service registration, which happens to be the existing order of the
@@ -84,6 +73,57 @@ void service_registry::notify_fork(execution_context::fork_event fork_ev)
       services[i - 1]->notify_fork(fork_ev);
 }
 
+void service_registry::add_memory_usage(
+    execution_context::memory_usage& usage) const
+{
+  std::vector<execution_context::service*> services;
+  copy_services(services);
+  for (std::size_t i = 0; i < services.size(); ++i)
+    services[i]->add_memory_usage(usage);
+}
+
+void service_registry::trim_memory()
+{
+  std::vector<execution_context::service*> services;
+  copy_services(services);
+  for (std::size_t i = 0; i < services.size(); ++i)
+    services[i]->trim_memory();
+}
+
+execution_context::memory_limits service_registry::get_memory_limits() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return memory_limits_;
+}
+
+void service_registry::set_memory_limits(
+    const execution_context::memory_limits& limits)
+{
+  std::vector<execution_context::service*> services;
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    memory_limits_ = limits;
+  }
+  copy_services(services);
+  for (std::size_t i = 0; i < services.size(); ++i)
+    services[i]->set_memory_limits(limits);
+}
+
+void service_registry::copy_services(
+    std::vector<execution_context::service*>& services) const
+{
+  // Make a copy of all of the services while holding the lock. We don't want
+  // to hold the lock while calling into each service, as it may try to call
+  // back into this class.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  execution_context::service* service = first_service_;
+  while (service)
+  {
+    services.push_back(service);
+    service = service->next_;
+  }
+}
+
 void service_registry::init_key_from_id(execution_context::service::key& key,
     const execution_context::id& id)
 {
@@ -106,7 +146,10 @@ bool service_registry::keys_match(
 
 void service_registry::destroy(execution_context::service* service)
 {
-  delete service;
+  if (service && service->destroy_)
+    service->destroy_(service);
+  else
+    delete service;
 }
 
 execution_context::service* service_registry::do_use_service(
@@ -100,13 +100,22 @@ public:
       if (push_waiting_to_ready(this_->impl_))
       {
         recycling_allocator<void> allocator;
-        executor_type ex = this_->executor_;
-        asio::prefer(
-            asio::require(
-              static_cast<executor_type&&>(ex),
-              execution::blocking.never),
-            execution::allocator(allocator)
-          ).execute(static_cast<invoker&&>(*this_));
+        if (is_affine_executor<decay_t<Executor>>::value
+            && this_->impl_->slice_scheduler_)
+        {
+          post_affine(this_->impl_,
+              static_cast<invoker&&>(*this_), allocator, true);
+        }
+        else
+        {
+          executor_type ex = this_->executor_;
+          asio::prefer(
+              asio::require(
+                static_cast<executor_type&&>(ex),
+                execution::blocking.never),
+              execution::allocator(allocator)
+            ).execute(static_cast<invoker&&>(*this_));
+        }
       }
     }
   };
@@ -132,6 +141,95 @@ private:
   executor_type executor_;
 };
 
+template <typename Executor>
+class strand_executor_service::inline_invoker
+{
+public:
+  inline_invoker(const implementation_type& impl, Executor& ex)
+    : impl_(impl),
+      executor_(ex)
+  {
+  }
+
+  inline_invoker(const inline_invoker& other)
+    : impl_(other.impl_),
+      executor_(other.executor_)
+  {
+  }
+
+  inline_invoker(inline_invoker&& other)
+    : impl_(static_cast<implementation_type&&>(other.impl_)),
+      executor_(static_cast<Executor&&>(other.executor_))
+  {
+  }
+
+  struct on_invoker_exit
+  {
+    inline_invoker* this_;
+
+    ~on_invoker_exit()
+    {
+      // Any remaining handlers are run from a normal, work-tracking invoker.
+      if (push_waiting_to_ready(this_->impl_))
+      {
+        recycling_allocator<void> allocator;
+        if (is_affine_executor<decay_t<Executor>>::value
+            && this_->impl_->slice_scheduler_)
+        {
+          post_affine(this_->impl_,
+              invoker<Executor>(this_->impl_, this_->executor_),
+              allocator, true);
+        }
+        else
+        {
+          asio::prefer(
+              asio::require(this_->executor_, execution::blocking.never),
+              execution::allocator(allocator)
+            ).execute(invoker<Executor>(this_->impl_, this_->executor_));
+        }
+      }
+    }
+  };
+
+  void operator()()
+  {
+    // Ensure the next handler, if any, is scheduled on block exit.
+    on_invoker_exit on_exit = { this };
+    (void)on_exit;
+
+    run_ready_handlers(impl_);
+  }
+
+private:
+  implementation_type impl_;
+  Executor executor_;
+};
+
+template <typename Executor, typename>
+struct strand_executor_service::can_run_inline
+{
+  static bool is_running(const Executor&)
+  {
+    return false;
+  }
+};
+
+// An uncontended strand may be run inline, without tracking work against the
+// underlying executor, when the caller is already running inside that
+// executor. The executor is then guaranteed to be alive for the duration.
+template <typename Executor>
+struct strand_executor_service::can_run_inline<Executor,
+    enable_if_t<
+      execution::is_executor<Executor>::value,
+      void_t<decltype(declval<const Executor&>().running_in_this_thread())>
+    >>
+{
+  static bool is_running(const Executor& ex)
+  {
+    return ex.running_in_this_thread();
+  }
+};
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 
 template <typename Executor>
@@ -190,6 +288,28 @@ private:
 
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
 
+template <typename Function, typename Allocator>
+void strand_executor_service::post_affine(const implementation_type& impl,
+    Function&& function, const Allocator& a, bool is_continuation)
+{
+  typedef decay_t<Function> function_type;
+
+  // The function may own the implementation, so take what we need from it
+  // before the function is moved.
+  strand_impl* this_impl = impl.get();
+
+  // Allocate and construct an operation to wrap the function.
+  typedef executor_op<function_type, Allocator> op;
+  typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
+  p.p = new (p.v) op(static_cast<Function&&>(function), a);
+
+  ASIO_HANDLER_CREATION((this_impl->service_->context(), *p.p,
+        "strand_executor", this_impl, 0, "post_affine"));
+
+  post_affine_completion(this_impl, p.p, is_continuation);
+  p.v = p.p = 0;
+}
+
 template <typename Executor, typename Function>
 inline void strand_executor_service::execute(const implementation_type& impl,
     Executor& ex, Function&& function,
@@ -241,12 +361,21 @@ void strand_executor_service::do_execute(const implementation_type& impl,
   ASIO_HANDLER_CREATION((impl->service_->context(), *p.p,
         "strand_executor", impl.get(), 0, "execute"));
 
-  // Add the function to the strand and schedule the strand if required.
+  // Add the function to the strand and schedule the strand if required. If
+  // the strand was uncontended and we are already inside the executor, the
+  // strand can run inline.
   bool first = enqueue(impl, p.p);
   p.v = p.p = 0;
   if (first)
   {
-    ex.execute(invoker<Executor>(impl, ex));
+    if (asio::query(ex, execution::blocking) != execution::blocking.never
+        && can_run_inline<Executor>::is_running(ex))
+      ex.execute(inline_invoker<Executor>(impl, ex));
+    else if (is_affine_executor<decay_t<Executor>>::value
+        && impl->slice_scheduler_)
+      post_affine(impl, invoker<Executor>(impl, ex), a, false);
+    else
+      ex.execute(invoker<Executor>(impl, ex));
   }
 }
 
@@ -280,9 +409,23 @@ void strand_executor_service::dispatch(const implementation_type& impl,
   p.v = p.p = 0;
   if (first)
   {
-    asio::dispatch(ex,
-        allocator_binder<invoker<Executor>, Allocator>(
-          invoker<Executor>(impl, ex), a));
+    if (can_run_inline<Executor>::is_running(ex))
+    {
+      asio::dispatch(ex,
+          allocator_binder<inline_invoker<Executor>, Allocator>(
+            inline_invoker<Executor>(impl, ex), a));
+    }
+    else if (is_affine_executor<decay_t<Executor>>::value
+        && impl->slice_scheduler_)
+    {
+      post_affine(impl, invoker<Executor>(impl, ex), a, false);
+    }
+    else
+    {
+      asio::dispatch(ex,
+          allocator_binder<invoker<Executor>, Allocator>(
+            invoker<Executor>(impl, ex), a));
+    }
   }
 }
 
@@ -306,9 +449,17 @@ void strand_executor_service::post(const implementation_type& impl,
   p.v = p.p = 0;
   if (first)
   {
-    asio::post(ex,
-        allocator_binder<invoker<Executor>, Allocator>(
-          invoker<Executor>(impl, ex), a));
+    if (is_affine_executor<decay_t<Executor>>::value
+        && impl->slice_scheduler_)
+    {
+      post_affine(impl, invoker<Executor>(impl, ex), a, false);
+    }
+    else
+    {
+      asio::post(ex,
+          allocator_binder<invoker<Executor>, Allocator>(
+            invoker<Executor>(impl, ex), a));
+    }
   }
 }
 
@@ -332,9 +483,17 @@ void strand_executor_service::defer(const implementation_type& impl,
   p.v = p.p = 0;
   if (first)
   {
-    asio::defer(ex,
-        allocator_binder<invoker<Executor>, Allocator>(
-          invoker<Executor>(impl, ex), a));
+    if (is_affine_executor<decay_t<Executor>>::value
+        && impl->slice_scheduler_)
+    {
+      post_affine(impl, invoker<Executor>(impl, ex), a, true);
+    }
+    else
+    {
+      asio::defer(ex,
+          allocator_binder<invoker<Executor>, Allocator>(
+            invoker<Executor>(impl, ex), a));
+    }
   }
 }
 
@@ -16,7 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/scheduler.hpp"
 #include "asio/detail/strand_executor_service.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -27,7 +30,8 @@ strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
     salt_(0),
-    impl_list_(0)
+    impl_list_(0),
+    scheduler_(0)
 {
 }
 
@@ -52,9 +56,16 @@ void strand_executor_service::shutdown()
 strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
-  implementation_type new_impl(new strand_impl);
+  implementation_type new_impl = allocate_shared<strand_impl>(
+      memory_resource_allocator<strand_impl>(
+        &context().get_memory_resource()));
   new_impl->locked_ = false;
   new_impl->shutdown_ = false;
+  new_impl->run_budget_ = 0;
+  new_impl->slice_budget_ = 0;
+  new_impl->affinity_scheduler_ = 0;
+  new_impl->slice_scheduler_ = 0;
+  new_impl->last_thread_ = 0;
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
@@ -114,6 +125,8 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
     // The function is acquiring the strand lock and so is responsible for
     // scheduling the strand.
     impl->locked_ = true;
+    impl->slice_budget_ = impl->run_budget_;
+    impl->slice_scheduler_ = impl->affinity_scheduler_;
     impl->mutex_->unlock();
     impl->ready_queue_.push(op);
     return true;
@@ -126,30 +139,99 @@ bool strand_executor_service::running_in_this_thread(
   return !!call_stack<strand_impl>::contains(impl.get());
 }
 
-bool strand_executor_service::push_waiting_to_ready(implementation_type& impl)
+void strand_executor_service::set_run_budget(
+    const implementation_type& impl, std::size_t max_handlers)
+{
+  impl->mutex_->lock();
+  impl->run_budget_ = max_handlers;
+  impl->mutex_->unlock();
+}
+
+std::size_t strand_executor_service::get_run_budget(
+    const implementation_type& impl)
+{
+  impl->mutex_->lock();
+  std::size_t max_handlers = impl->run_budget_;
+  impl->mutex_->unlock();
+  return max_handlers;
+}
+
+void strand_executor_service::set_thread_affinity(
+    const implementation_type& impl, bool affinity)
+{
+  scheduler* sched = 0;
+  if (affinity)
+  {
+    // Affinity is only supported when the strand's execution context is run
+    // by a scheduler, such as io_context or thread_pool.
+    strand_executor_service* service = impl->service_;
+    asio::detail::mutex::scoped_lock lock(service->mutex_);
+    if (!service->scheduler_ && has_service<scheduler>(service->context()))
+      service->scheduler_ = &use_service<scheduler>(service->context());
+    sched = service->scheduler_;
+  }
+
+  impl->mutex_->lock();
+  impl->affinity_scheduler_ = sched;
+  impl->mutex_->unlock();
+}
+
+bool strand_executor_service::get_thread_affinity(
+    const implementation_type& impl)
+{
+  impl->mutex_->lock();
+  bool affinity = impl->affinity_scheduler_ != 0;
+  impl->mutex_->unlock();
+  return affinity;
+}
+
+bool strand_executor_service::push_waiting_to_ready(
+    const implementation_type& impl)
 {
   impl->mutex_->lock();
   impl->ready_queue_.push(impl->waiting_queue_);
   bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
+  impl->slice_budget_ = impl->run_budget_;
+  impl->slice_scheduler_ = impl->affinity_scheduler_;
   impl->mutex_->unlock();
   return more_handlers;
 }
 
-void strand_executor_service::run_ready_handlers(implementation_type& impl)
+void strand_executor_service::run_ready_handlers(
+    const implementation_type& impl)
 {
   // Indicate that this strand is executing on the current thread.
   call_stack<strand_impl>::context ctx(impl.get());
 
-  // Run all ready handlers. No lock is required since the ready queue is
+  // Run ready handlers until the queue is empty or the budget for this slice
+  // is exhausted. Any handlers left in the ready queue are run the next time
+  // the strand is scheduled. No lock is required since the ready queue is
   // accessed only within the strand.
+  std::size_t budget = impl->slice_budget_;
   asio::error_code ec;
+  thread_info_base* this_thread = thread_context::top_of_thread_call_stack();
+  impl->last_thread_ = this_thread;
   while (scheduler_operation* o = impl->ready_queue_.front())
   {
     impl->ready_queue_.pop();
+
+    // Each handler has its own window for this_thread_should_yield().
+    if (this_thread)
+      this_thread->handler_started();
+
     o->complete(impl.get(), ec, 0);
+    if (budget != 0 && --budget == 0)
+      break;
   }
 }
 
+void strand_executor_service::post_affine_completion(strand_impl* impl,
+    scheduler_operation* op, bool is_continuation)
+{
+  impl->slice_scheduler_->post_affine_completion(
+      op, impl->last_thread_, is_continuation);
+}
+
 } // namespace detail
 } // namespace asio
 
@@ -27,7 +27,12 @@ namespace detail {
 
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
-    locked_(false)
+    locked_(false),
+    ref_count_(1),
+    next_(0),
+    prev_(0),
+    service_(0),
+    memory_resource_(0)
 {
 }
 
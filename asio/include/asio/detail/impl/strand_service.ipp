@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/call_stack.hpp"
 #include "asio/detail/strand_service.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -36,8 +38,12 @@ struct strand_service::on_do_complete_exit
     bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
     impl_->mutex_.unlock();
 
+    // The reference held while the strand is scheduled is passed on to the
+    // next scheduling of the strand, if there is one.
     if (more_handlers)
       owner_->post_immediate_completion(impl_, true);
+    else
+      strand_service::release(impl_);
   }
 };
 
@@ -46,43 +52,92 @@ strand_service::strand_service(asio::io_context& io_context)
     io_context_(io_context),
     io_context_impl_(asio::use_service<io_context_impl>(io_context)),
     mutex_(),
-    salt_(0)
+    impl_list_(0)
 {
 }
 
+strand_service::~strand_service()
+{
+  // Any implementations that are still referenced by strand objects must no
+  // longer refer back to the service.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  for (strand_impl* impl = impl_list_; impl; impl = impl->next_)
+    impl->service_ = 0;
+}
+
 void strand_service::shutdown()
 {
   op_queue<operation> ops;
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  for (std::size_t i = 0; i < num_implementations; ++i)
+  for (strand_impl* impl = impl_list_; impl; impl = impl->next_)
   {
-    if (strand_impl* impl = implementations_[i].get())
-    {
-      ops.push(impl->waiting_queue_);
-      ops.push(impl->ready_queue_);
-    }
+    impl->mutex_.lock();
+    ops.push(impl->waiting_queue_);
+    ops.push(impl->ready_queue_);
+    impl->mutex_.unlock();
   }
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
+  memory_resource& resource = io_context_.get_memory_resource();
+  strand_impl* new_impl = resource_new<strand_impl>(resource);
+  new_impl->memory_resource_ = &resource;
+
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  std::size_t salt = salt_++;
-#if defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = salt;
-#else // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = reinterpret_cast<std::size_t>(&impl);
-  index += (reinterpret_cast<std::size_t>(&impl) >> 3);
-  index ^= salt + 0x9e3779b9 + (index << 6) + (index >> 2);
-#endif // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  index = index % num_implementations;
-
-  if (!implementations_[index].get())
-    implementations_[index].reset(new strand_impl);
-  impl = implementations_[index].get();
+  // Insert implementation into linked list of all implementations.
+  new_impl->next_ = impl_list_;
+  new_impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = new_impl;
+  impl_list_ = new_impl;
+  new_impl->service_ = this;
+
+  impl = new_impl;
+}
+
+void strand_service::copy_construct(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  ++other_impl->ref_count_;
+  impl = other_impl;
+}
+
+void strand_service::destroy(strand_service::implementation_type& impl)
+{
+  release(impl);
+  impl = 0;
+}
+
+void strand_service::release(strand_impl* impl)
+{
+  if (--impl->ref_count_ == 0)
+  {
+    if (strand_service* service = impl->service_)
+    {
+      asio::detail::mutex::scoped_lock lock(service->mutex_);
+
+      // Remove implementation from linked list of all implementations.
+      if (service->impl_list_ == impl)
+        service->impl_list_ = impl->next_;
+      if (impl->prev_)
+        impl->prev_->next_ = impl->next_;
+      if (impl->next_)
+        impl->next_->prev_ = impl->prev_;
+    }
+
+    resource_delete(*impl->memory_resource_, impl);
+  }
+}
+
+void strand_service::schedule(implementation_type& impl, bool is_continuation)
+{
+  // The implementation must outlive all strand objects while it is scheduled.
+  ++impl->ref_count_;
+  io_context_impl_.post_immediate_completion(impl, is_continuation);
 }
 
 bool strand_service::running_in_this_thread(
@@ -103,8 +158,12 @@ struct strand_service::on_dispatch_exit
     bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
     impl_->mutex_.unlock();
 
+    // The reference held while the handler runs is passed on to the next
+    // scheduling of the strand, if there is one.
     if (more_handlers)
       io_context_impl_->post_immediate_completion(impl_, false);
+    else
+      strand_service::release(impl_);
   }
 };
 
@@ -116,9 +175,12 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
   impl->mutex_.lock();
   if (can_dispatch && !impl->locked_)
   {
-    // Immediate invocation is allowed.
+    // Immediate invocation is allowed. The handler may destroy the last
+    // strand object, so the implementation must be kept alive until the
+    // strand is released.
     impl->locked_ = true;
     impl->mutex_.unlock();
+    ++impl->ref_count_;
 
     // Indicate that this strand is executing on the current thread.
     call_stack<strand_impl>::context ctx(impl);
@@ -144,7 +206,7 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
     impl->locked_ = true;
     impl->mutex_.unlock();
     impl->ready_queue_.push(op);
-    io_context_impl_.post_immediate_completion(impl, false);
+    schedule(impl, false);
   }
 }
 
@@ -165,7 +227,7 @@ void strand_service::do_post(implementation_type& impl,
     impl->locked_ = true;
     impl->mutex_.unlock();
     impl->ready_queue_.push(op);
-    io_context_impl_.post_immediate_completion(impl, is_continuation);
+    schedule(impl, is_continuation);
   }
 }
 
@@ -186,12 +248,25 @@ void strand_service::do_complete(void* owner, operation* base,
 
     // Run all ready handlers. No lock is required since the ready queue is
     // accessed only within the strand.
+    thread_info_base* this_thread =
+      thread_context::top_of_thread_call_stack();
     while (operation* o = impl->ready_queue_.front())
     {
       impl->ready_queue_.pop();
+
+      // Each handler has its own window for this_thread_should_yield().
+      if (this_thread)
+        this_thread->handler_started();
+
       o->complete(owner, ec, 0);
     }
   }
+  else
+  {
+    // The strand is being destroyed while scheduled, so the reference held by
+    // the io_context must be released.
+    release(static_cast<strand_impl*>(base));
+  }
 }
 
 } // namespace detail
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -27,6 +29,17 @@ thread_info_base* thread_context::top_of_thread_call_stack()
   return thread_call_stack::top();
 }
 
+bool thread_context::this_thread_should_yield(long usec)
+{
+  thread_info_base* this_thread = thread_call_stack::top();
+  if (!this_thread || !this_thread->handler_run_time_exceeded(usec))
+    return false;
+
+  // The context is asked only once the time has run out, as doing so may
+  // involve taking a lock.
+  return thread_call_stack::top_key()->has_waiting_work();
+}
+
 } // namespace detail
 } // namespace asio
 
@@ -69,6 +69,11 @@ void timer_queue<time_traits<boost::posix_time::ptime>>::get_all_timers(
   impl_.get_all_timers(ops);
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime>>::reserve(std::size_t n)
+{
+  impl_.reserve(n);
+}
+
 std::size_t timer_queue<time_traits<boost::posix_time::ptime>>::cancel_timer(
     per_timer_data& timer, op_queue<operation>& ops, std::size_t max_cancelled)
 {
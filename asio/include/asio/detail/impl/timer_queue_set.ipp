@@ -24,12 +24,15 @@ namespace asio {
 namespace detail {
 
 timer_queue_set::timer_queue_set()
-  : first_(0)
+  : first_(0),
+    reserved_(0)
 {
 }
 
 void timer_queue_set::insert(timer_queue_base* q)
 {
+  if (reserved_ > 0)
+    q->reserve(reserved_);
   q->next_ = first_;
   first_ = q;
 }
@@ -93,6 +96,14 @@ void timer_queue_set::get_all_timers(op_queue<operation>& ops)
     p->get_all_timers(ops);
 }
 
+void timer_queue_set::reserve(std::size_t n)
+{
+  for (timer_queue_base* p = first_; p; p = p->next_)
+    p->reserve(n);
+  if (n > reserved_)
+    reserved_ = n;
+}
+
 } // namespace detail
 } // namespace asio
 
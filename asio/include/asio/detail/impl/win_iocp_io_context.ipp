@@ -238,6 +238,47 @@ size_t win_iocp_io_context::wait_one(long usec, asio::error_code& ec)
   return do_one(usec < 0 ? INFINITE : ((usec - 1) / 1000 + 1), this_thread, ec);
 }
 
+size_t win_iocp_io_context::run_until_complete(
+    const bool& complete, asio::error_code& ec)
+{
+  ec = asio::error_code();
+
+  // The wait counts as work, so that the io_context does not run out of work
+  // while the operation is outstanding on some other execution context.
+  work_started();
+  work_finished_on_block_exit on_exit = { this };
+  (void)on_exit;
+
+  win_iocp_thread_info this_thread;
+  thread_call_stack::context ctx(this, this_thread);
+
+  size_t n = 0;
+  for (;;)
+  {
+    {
+      mutex::scoped_lock lock(dispatch_mutex_);
+      if (complete)
+        return n;
+    }
+
+    // A completion on another thread cannot wake this thread in particular,
+    // so the flag is checked again after a bounded wait. A stop event makes
+    // do_one() return early, but it is passed on and the wait continues, as
+    // a synchronous operation would.
+    if (do_one(completion_wait_msec, this_thread, ec))
+    {
+      if (n != (std::numeric_limits<size_t>::max)())
+        ++n;
+    }
+  }
+}
+
+void win_iocp_io_context::notify_complete(bool& complete)
+{
+  mutex::scoped_lock lock(dispatch_mutex_);
+  complete = true;
+}
+
 size_t win_iocp_io_context::poll(asio::error_code& ec)
 {
   if (::InterlockedExchangeAdd(&outstanding_work_, 0) == 0)
@@ -471,6 +512,7 @@ size_t win_iocp_io_context::do_one(DWORD msec,
         work_finished_on_block_exit on_exit = { this };
         (void)on_exit;
 
+        this_thread.handler_started();
         op->complete(this, result_ec, bytes_transferred);
         this_thread.rethrow_pending_exception();
         ec = asio::error_code();
@@ -547,6 +589,17 @@ DWORD win_iocp_io_context::get_gqcs_timeout()
 #endif // !defined(_WIN32_WINNT) || (_WIN32_WINNT < 0x0600)
 }
 
+void win_iocp_io_context::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(dispatch_mutex_);
+  timer_queues_.reserve(n);
+}
+
+bool win_iocp_io_context::has_waiting_work()
+{
+  return true;
+}
+
 void win_iocp_io_context::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(dispatch_mutex_);
@@ -99,6 +99,12 @@ void winrt_timer_scheduler::call_run_thread(winrt_timer_scheduler* scheduler)
   scheduler->run_thread();
 }
 
+void winrt_timer_scheduler::reserve_timers(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(n);
+}
+
 void winrt_timer_scheduler::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -18,10 +18,13 @@
 #include <new>
 #include "asio/detail/config.hpp"
 #include "asio/detail/type_traits.hpp"
+#include "asio/execution/allocator.hpp"
 #include "asio/execution/executor.hpp"
 #include "asio/execution/context.hpp"
+#include "asio/handler_arena.hpp"
 #include "asio/io_context.hpp"
 #include "asio/query.hpp"
+#include "asio/require.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -138,6 +141,21 @@ public:
     return implementation_;
   }
 
+  // Get the arena carried by the executor. Only available when the executor's
+  // allocator is an arena_allocator.
+  handler_arena* get_arena() const noexcept
+  {
+    return asio::query(executor_, execution::allocator).arena();
+  }
+
+  // Replace the arena carried by the executor. Only available when the
+  // executor's allocator is an arena_allocator.
+  void set_arena(handler_arena* arena) noexcept
+  {
+    executor_ = asio::require(executor_,
+        execution::allocator(arena_allocator<void>(arena)));
+  }
+
 private:
   // Helper function to get an executor's context.
   template <typename T>
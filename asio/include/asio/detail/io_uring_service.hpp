@@ -101,6 +101,10 @@ public:
   ASIO_DECL void notify_fork(
       asio::execution_context::fork_event fork_ev);
 
+  // Add the memory held on the free list of the per-object state to the counters.
+  ASIO_DECL void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
   // Initialise the task.
   ASIO_DECL void init_task();
 
@@ -145,6 +149,12 @@ public:
   // object.
   ASIO_DECL void cleanup_io_object(per_io_object_data& io_obj);
 
+  // Pre-allocate state for the specified number of descriptors.
+  ASIO_DECL void reserve_descriptors(std::size_t n);
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -285,7 +295,7 @@ private:
   __kernel_timespec timeout_;
 
   // Mutex to protect access to the registered I/O objects.
-  mutex registration_mutex_;
+  mutable mutex registration_mutex_;
 
   // Keep track of all registered I/O objects.
   object_pool<io_object> registered_io_objects_;
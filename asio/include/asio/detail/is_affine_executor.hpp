@@ -0,0 +1,40 @@
+//
+// detail/is_affine_executor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IS_AFFINE_EXECUTOR_HPP
+#define ASIO_DETAIL_IS_AFFINE_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Whether a strand using the executor may give its invoker directly to the
+// execution context's scheduler, to be kept on the current thread. This is
+// true only for executors that submit to the scheduler without adding any
+// behaviour of their own, and is specialised by io_context and thread_pool.
+template <typename Executor>
+struct is_affine_executor : false_type
+{
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IS_AFFINE_EXECUTOR_HPP
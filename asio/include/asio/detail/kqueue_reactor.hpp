@@ -96,6 +96,10 @@ public:
   ASIO_DECL void notify_fork(
       asio::execution_context::fork_event fork_ev);
 
+  // Add the memory held on the free list of the reactor's per-descriptor state to the counters.
+  ASIO_DECL void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
   // Initialise the task.
   ASIO_DECL void init_task();
 
@@ -171,6 +175,12 @@ public:
   ASIO_DECL void cleanup_descriptor_data(
       per_descriptor_data& descriptor_data);
 
+  // Pre-allocate state for the specified number of descriptors.
+  ASIO_DECL void reserve_descriptors(std::size_t n);
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& queue);
@@ -250,7 +260,7 @@ private:
   bool shutdown_;
 
   // Mutex to protect access to the registered descriptors.
-  mutex registered_descriptors_mutex_;
+  mutable mutex registered_descriptors_mutex_;
 
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
@@ -15,7 +15,12 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
+#include "asio/memory_resource.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -46,6 +51,51 @@ public:
     delete o;
   }
 
+  template <typename Object>
+  static Object* create(memory_resource& r)
+  {
+    resource_memory_guard<Object> guard =
+      { &r, r.allocate(sizeof(Object), alignof(Object)) };
+    Object* o = new (guard.pointer_) Object;
+    guard.pointer_ = 0;
+    return o;
+  }
+
+  template <typename Object, typename Arg>
+  static Object* create(memory_resource& r, Arg arg)
+  {
+    resource_memory_guard<Object> guard =
+      { &r, r.allocate(sizeof(Object), alignof(Object)) };
+    Object* o = new (guard.pointer_) Object(arg);
+    guard.pointer_ = 0;
+    return o;
+  }
+
+  template <typename Object>
+  static void destroy(memory_resource& r, Object* o)
+  {
+    o->~Object();
+    r.deallocate(o, sizeof(Object), alignof(Object));
+  }
+
+  template <typename Object>
+  static Object* construct(void* p)
+  {
+    return new (p) Object;
+  }
+
+  template <typename Object, typename Arg>
+  static Object* construct(void* p, Arg arg)
+  {
+    return new (p) Object(arg);
+  }
+
+  template <typename Object>
+  static void destruct(Object* o)
+  {
+    o->~Object();
+  }
+
   template <typename Object>
   static Object*& next(Object* o)
   {
@@ -66,16 +116,36 @@ class object_pool
 public:
   // Constructor.
   object_pool()
-    : live_list_(0),
-      free_list_(0)
+    : resource_(0),
+      live_list_(0),
+      free_list_(0),
+      free_count_(0),
+      blocks_(0)
+  {
+  }
+
+  // Construct a pool that allocates objects from the specified resource.
+  explicit object_pool(memory_resource& r)
+    : resource_(&r),
+      live_list_(0),
+      free_list_(0),
+      free_count_(0),
+      blocks_(0)
   {
   }
 
   // Destructor destroys all objects.
   ~object_pool()
   {
+    mark_block_objects();
     destroy_list(live_list_);
     destroy_list(free_list_);
+    while (blocks_)
+    {
+      block* b = blocks_;
+      blocks_ = b->next_;
+      deallocate_block(b);
+    }
   }
 
   // Get the object at the start of the live list.
@@ -89,7 +159,12 @@ public:
   {
     Object* o = free_list_;
     if (o)
+    {
       free_list_ = object_pool_access::next(free_list_);
+      --free_count_;
+    }
+    else if (resource_)
+      o = object_pool_access::create<Object>(*resource_);
     else
       o = object_pool_access::create<Object>();
 
@@ -108,7 +183,12 @@ public:
   {
     Object* o = free_list_;
     if (o)
+    {
       free_list_ = object_pool_access::next(free_list_);
+      --free_count_;
+    }
+    else if (resource_)
+      o = object_pool_access::create<Object>(*resource_, arg);
     else
       o = object_pool_access::create<Object>(arg);
 
@@ -139,12 +219,110 @@ public:
         = object_pool_access::prev(o);
     }
 
+    push_free(o);
+  }
+
+  // Get the number of objects on the free list.
+  std::size_t free_count() const
+  {
+    return free_count_;
+  }
+
+  // Construct objects in a single contiguous block and add them to the free
+  // list. Each object starts on its own cache line.
+  void reserve(std::size_t n)
+  {
+    unsigned char* p = allocate_block(n);
+    for (std::size_t i = 0; i < n; ++i, p += stride())
+      push_free(object_pool_access::construct<Object>(p));
+  }
+
+  // Construct objects with an argument in a single contiguous block and add
+  // them to the free list. Each object starts on its own cache line.
+  template <typename Arg>
+  void reserve(std::size_t n, Arg arg)
+  {
+    unsigned char* p = allocate_block(n);
+    for (std::size_t i = 0; i < n; ++i, p += stride())
+      push_free(object_pool_access::construct<Object>(p, arg));
+  }
+
+private:
+  // The header of a block of objects created by reserve().
+  struct block
+  {
+    block* next_;
+    std::size_t size_;
+    std::size_t count_;
+  };
+
+  // The distance between objects in a block.
+  static std::size_t stride()
+  {
+    return round_up(sizeof(Object));
+  }
+
+  static std::size_t round_up(std::size_t size)
+  {
+    return (size + ASIO_CACHE_LINE_SIZE - 1)
+      / ASIO_CACHE_LINE_SIZE * ASIO_CACHE_LINE_SIZE;
+  }
+
+  // Allocate memory for n objects, and return a pointer to the first object.
+  // The block is released when the pool is destroyed.
+  unsigned char* allocate_block(std::size_t n)
+  {
+    std::size_t size = round_up(sizeof(block)) + n * stride();
+    void* p = resource_
+      ? resource_->allocate(size, ASIO_CACHE_LINE_SIZE)
+      : aligned_new(ASIO_CACHE_LINE_SIZE, size);
+    block* b = new (p) block;
+    b->next_ = blocks_;
+    b->size_ = size;
+    b->count_ = n;
+    blocks_ = b;
+    return static_cast<unsigned char*>(p) + round_up(sizeof(block));
+  }
+
+  void deallocate_block(block* b)
+  {
+    if (resource_)
+      resource_->deallocate(b, b->size_, ASIO_CACHE_LINE_SIZE);
+    else
+      aligned_delete(b);
+  }
+
+  // The value stored in the prev pointer of an object that lives in a block
+  // created by reserve(), once the pool is being destroyed.
+  Object* block_marker()
+  {
+    return reinterpret_cast<Object*>(this);
+  }
+
+  // Mark every object that lives in a block, so that destroy_list() can tell
+  // those objects apart without searching the blocks. Every object in a block
+  // is on either the live list or the free list, so the prev pointers are no
+  // longer needed.
+  void mark_block_objects()
+  {
+    for (block* b = blocks_; b; b = b->next_)
+    {
+      unsigned char* p = reinterpret_cast<unsigned char*>(b)
+        + round_up(sizeof(block));
+      for (std::size_t i = 0; i < b->count_; ++i, p += stride())
+        object_pool_access::prev(reinterpret_cast<Object*>(p)) = block_marker();
+    }
+  }
+
+  // Add an object to the free list.
+  void push_free(Object* o)
+  {
     object_pool_access::next(o) = free_list_;
     object_pool_access::prev(o) = 0;
     free_list_ = o;
+    ++free_count_;
   }
 
-private:
   // Helper function to destroy all elements in a list.
   void destroy_list(Object* list)
   {
@@ -152,15 +330,29 @@ private:
     {
       Object* o = list;
       list = object_pool_access::next(o);
-      object_pool_access::destroy(o);
+      if (object_pool_access::prev(o) == block_marker())
+        object_pool_access::destruct(o);
+      else if (resource_)
+        object_pool_access::destroy(*resource_, o);
+      else
+        object_pool_access::destroy(o);
     }
   }
 
+  // The memory resource used to allocate objects, if any.
+  memory_resource* resource_;
+
   // The list of live objects.
   Object* live_list_;
 
   // The free list.
   Object* free_list_;
+
+  // The number of objects on the free list.
+  std::size_t free_count_;
+
+  // The blocks of objects created by reserve().
+  block* blocks_;
 };
 
 } // namespace detail
@@ -0,0 +1,211 @@
+//
+// detail/offload_function_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_OFFLOAD_FUNCTION_OP_HPP
+#define ASIO_DETAIL_OFFLOAD_FUNCTION_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <exception>
+#include <new>
+#include "asio/error.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/offload_service.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Holds the result of an offloaded function until the handler is called. The
+// result is constructed in place when the function returns, and a default
+// constructed result is passed to the handler if the function is not called or
+// exits via an exception.
+template <typename Result>
+class offload_result
+{
+public:
+  static_assert(is_default_constructible<Result>::value,
+      "async_offload requires a default constructible result type");
+
+  offload_result()
+    : has_value_(false)
+  {
+  }
+
+  ~offload_result()
+  {
+    if (has_value_)
+      value().~Result();
+  }
+
+  template <typename Function>
+  void call(Function& f)
+  {
+    new (&storage_) Result(static_cast<Function&&>(f)());
+    has_value_ = true;
+  }
+
+  template <typename Handler>
+  move_binder3<Handler, std::exception_ptr, asio::error_code, Result> bind(
+      Handler& handler, const std::exception_ptr& e,
+      const asio::error_code& ec)
+  {
+    if (has_value_)
+    {
+      return move_binder3<Handler, std::exception_ptr,
+        asio::error_code, Result>(0, static_cast<Handler&&>(handler),
+          e, ec, static_cast<Result&&>(value()));
+    }
+
+    return move_binder3<Handler, std::exception_ptr,
+      asio::error_code, Result>(0, static_cast<Handler&&>(handler),
+        e, ec, Result());
+  }
+
+private:
+  offload_result(const offload_result&) = delete;
+  offload_result& operator=(const offload_result&) = delete;
+
+  Result& value()
+  {
+    return *static_cast<Result*>(static_cast<void*>(&storage_));
+  }
+
+  aligned_storage_t<sizeof(Result), alignment_of<Result>::value> storage_;
+  bool has_value_;
+};
+
+template <>
+class offload_result<void>
+{
+public:
+  template <typename Function>
+  void call(Function& f)
+  {
+    static_cast<Function&&>(f)();
+  }
+
+  template <typename Handler>
+  binder2<Handler, std::exception_ptr, asio::error_code> bind(
+      Handler& handler, const std::exception_ptr& e,
+      const asio::error_code& ec)
+  {
+    return binder2<Handler, std::exception_ptr, asio::error_code>(
+        handler, e, ec);
+  }
+};
+
+template <typename Function, typename Handler, typename IoExecutor>
+class offload_function_op : public offload_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(offload_function_op);
+
+  typedef decay_t<result_of_t<Function()>> result_type;
+
+  template <typename F>
+  offload_function_op(F&& f, Handler& handler,
+      const IoExecutor& io_ex, offload_service& service)
+    : offload_op(&offload_function_op::do_complete),
+      function_(static_cast<F&&>(f)),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex),
+      service_(service)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the operation object.
+    ASIO_ASSUME(base != 0);
+    offload_function_op* o(static_cast<offload_function_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    if (owner && owner != &o->service_.get_scheduler())
+    {
+      // The operation is being run on one of the service's threads, or by
+      // the thread that started it. Time to call the blocking function.
+      o->service_.offload_op_started();
+#if !defined(ASIO_NO_EXCEPTIONS)
+      try
+      {
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+        o->result_.call(o->function_);
+#if !defined(ASIO_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        o->exception_ = std::current_exception();
+      }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+      o->service_.offload_op_finished();
+
+      // Pass operation back to main scheduler for completion.
+      o->service_.get_scheduler().post_deferred_completion(o);
+      p.v = p.p = 0;
+    }
+    else
+    {
+      // The operation has been returned to the main scheduler. The completion
+      // handler is ready to be delivered.
+
+      ASIO_HANDLER_COMPLETION((*o));
+
+      // Take ownership of the operation's outstanding work.
+      handler_work<Handler, IoExecutor> w(
+          static_cast<handler_work<Handler, IoExecutor>&&>(
+            o->work_));
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made. Even if we're not about to make an upcall,
+      // a sub-object of the handler may be the true owner of the memory
+      // associated with the handler. Consequently, a local copy of the handler
+      // is required to ensure that any owning sub-object remains valid until
+      // after we have deallocated the memory here.
+      auto handler(o->result_.bind(o->handler_, o->exception_, o->ec_));
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      if (owner)
+      {
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+        w.complete(handler, handler.handler_);
+        ASIO_HANDLER_INVOCATION_END;
+      }
+    }
+  }
+
+private:
+  Function function_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+  offload_service& service_;
+  offload_result<result_type> result_;
+  std::exception_ptr exception_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_OFFLOAD_FUNCTION_OP_HPP
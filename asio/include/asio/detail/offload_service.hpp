@@ -0,0 +1,149 @@
+//
+// detail/offload_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_OFFLOAD_SERVICE_HPP
+#define ASIO_DETAIL_OFFLOAD_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/thread_group.hpp"
+
+#if defined(ASIO_HAS_IOCP)
+# include "asio/detail/win_iocp_io_context.hpp"
+#else // defined(ASIO_HAS_IOCP)
+# include "asio/detail/scheduler.hpp"
+#endif // defined(ASIO_HAS_IOCP)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+struct offload_options;
+
+namespace detail {
+
+// Base class for operations that run a blocking function on one of the
+// service's threads and then complete on the execution context's scheduler.
+class offload_op : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+protected:
+  offload_op(func_type complete_func)
+    : operation(complete_func)
+  {
+  }
+};
+
+class offload_service
+  : public execution_context_service_base<offload_service>
+{
+public:
+  // The scheduler implementation used to post completions.
+#if defined(ASIO_HAS_IOCP)
+  typedef class win_iocp_io_context scheduler_impl;
+#else
+  typedef class scheduler scheduler_impl;
+#endif
+
+  // Constructor.
+  ASIO_DECL offload_service(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~offload_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Get the limits applied to offloaded functions.
+  ASIO_DECL offload_options get_options() const;
+
+  // Set the limits applied to offloaded functions.
+  ASIO_DECL void set_options(const offload_options& options);
+
+  // Get the scheduler to which completions are posted.
+  scheduler_impl& get_scheduler()
+  {
+    return scheduler_;
+  }
+
+  // Queue an operation to run on one of the service's threads. If the queue
+  // is full, the operation is either rejected or run in the calling thread.
+  ASIO_DECL void start_offload_op(offload_op* op);
+
+  // Called by an operation when a thread begins running its function.
+  ASIO_DECL void offload_op_started();
+
+  // Called by an operation when its function has returned.
+  ASIO_DECL void offload_op_finished();
+
+private:
+  // Helper class to run the work scheduler in a thread.
+  class work_scheduler_runner;
+
+  // Start another thread if all existing threads are busy. The mutex must be
+  // locked.
+  ASIO_DECL void maybe_start_thread(mutex::scoped_lock& lock);
+
+  // The scheduler for the execution context.
+  scheduler_impl& scheduler_;
+
+  // Mutex to protect access to internal data.
+  mutable asio::detail::mutex mutex_;
+
+  // Private scheduler used to queue functions for the service's threads.
+  asio::detail::scoped_ptr<scheduler_impl> work_scheduler_;
+
+  // The threads that run the private scheduler.
+  asio::detail::thread_group threads_;
+
+  // The number of threads in the thread group.
+  std::size_t num_threads_;
+
+  // The maximum number of threads.
+  std::size_t max_threads_;
+
+  // The number of operations waiting for a thread.
+  std::size_t num_queued_;
+
+  // The maximum number of operations waiting for a thread.
+  std::size_t max_queued_;
+
+  // The number of operations whose functions are running.
+  std::size_t num_running_;
+
+  // Whether operations that do not fit in the queue are run by the caller.
+  bool caller_runs_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/offload_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_OFFLOAD_SERVICE_HPP
@@ -0,0 +1,292 @@
+//
+// detail/periodic_wait_slot.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_PERIODIC_WAIT_SLOT_HPP
+#define ASIO_DETAIL_PERIODIC_WAIT_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/associated_allocator.hpp"
+#include "asio/associator.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The memory used by the wait operations of a periodic timer. A periodic
+// timer has at most one wait outstanding at a time, so a single block serves
+// the operation for every tick. The slot also counts the allocations made
+// through it, which tells the timer whether a wait may still be outstanding.
+// The slot is shared between the timer and its operations, and is destroyed
+// once the timer has released it and all of its allocations have been freed.
+class periodic_wait_slot
+  : private noncopyable
+{
+public:
+  // Create a slot whose block holds an object of the given size and alignment.
+  static periodic_wait_slot* create(std::size_t size, std::size_t align)
+  {
+    return new periodic_wait_slot(size, align);
+  }
+
+  // Release the timer's ownership of the slot.
+  void release()
+  {
+    if (state_.fetch_sub(owned, std::memory_order_acq_rel) == owned)
+      delete this;
+  }
+
+  // Whether the slot's block can hold an object of the given size and
+  // alignment.
+  bool fits(std::size_t size, std::size_t align) const
+  {
+    return size <= size_ && align <= align_;
+  }
+
+  // Whether any allocation made through the slot has not yet been freed.
+  bool outstanding() const
+  {
+    return state_.load(std::memory_order_acquire) >= one_allocation;
+  }
+
+  // Claim the slot's block, if it is large enough and not already in use.
+  // Returns null if the block cannot be used, in which case the caller must
+  // allocate the memory itself and then call add_allocation().
+  void* claim(std::size_t size, std::size_t align)
+  {
+    if (fits(size, align))
+    {
+      std::size_t state = state_.load(std::memory_order_relaxed);
+      while ((state & block_in_use) == 0)
+      {
+        if (state_.compare_exchange_weak(state,
+              state + (one_allocation | block_in_use),
+              std::memory_order_acquire, std::memory_order_relaxed))
+          return block_;
+      }
+    }
+    return 0;
+  }
+
+  // Count an allocation that was not able to use the slot's block.
+  void add_allocation()
+  {
+    state_.fetch_add(one_allocation, std::memory_order_relaxed);
+  }
+
+  // Whether the specified memory is the slot's block.
+  bool is_block(const void* p) const
+  {
+    return p == block_;
+  }
+
+  // Record that an allocation has been freed. The slot is destroyed if this
+  // was its last use.
+  void remove_allocation(const void* p)
+  {
+    std::size_t released = one_allocation;
+    if (p == block_)
+      released |= block_in_use;
+    if (state_.fetch_sub(released, std::memory_order_acq_rel) == released)
+      delete this;
+  }
+
+private:
+  // The state is a count of outstanding allocations, plus flags recording
+  // whether the timer still owns the slot and whether the block is in use.
+  enum : std::size_t
+  {
+    owned = 1,
+    block_in_use = 2,
+    one_allocation = 4
+  };
+
+  periodic_wait_slot(std::size_t size, std::size_t align)
+    : state_(owned),
+      block_(aligned_new(align, size)),
+      size_(size),
+      align_(align < ASIO_DEFAULT_ALIGN ? ASIO_DEFAULT_ALIGN : align)
+  {
+  }
+
+  ~periodic_wait_slot()
+  {
+    aligned_delete(block_);
+  }
+
+  std::atomic<std::size_t> state_;
+  void* const block_;
+  const std::size_t size_;
+  const std::size_t align_;
+};
+
+// The allocator associated with a periodic timer's wait operations.
+// Allocations that cannot use the slot's block are made from the underlying
+// allocator.
+template <typename T, typename Allocator>
+class periodic_wait_allocator
+{
+public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef periodic_wait_allocator<U, Allocator> other;
+  };
+
+  periodic_wait_allocator(periodic_wait_slot* slot,
+      const Allocator& a) noexcept
+    : slot_(slot),
+      allocator_(a)
+  {
+  }
+
+  template <typename U>
+  periodic_wait_allocator(
+      const periodic_wait_allocator<U, Allocator>& other) noexcept
+    : slot_(other.slot_),
+      allocator_(other.allocator_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if (void* p = slot_->claim(sizeof(T) * n, alignof(T)))
+      return static_cast<T*>(p);
+
+    ASIO_REBIND_ALLOC(Allocator, T) alloc(allocator_);
+    T* p = alloc.allocate(n);
+    slot_->add_allocation();
+    return p;
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    if (!slot_->is_block(p))
+    {
+      ASIO_REBIND_ALLOC(Allocator, T) alloc(allocator_);
+      alloc.deallocate(p, n);
+    }
+    slot_->remove_allocation(p);
+  }
+
+  friend bool operator==(const periodic_wait_allocator& a,
+      const periodic_wait_allocator& b) noexcept
+  {
+    return a.slot_ == b.slot_;
+  }
+
+  friend bool operator!=(const periodic_wait_allocator& a,
+      const periodic_wait_allocator& b) noexcept
+  {
+    return a.slot_ != b.slot_;
+  }
+
+private:
+  template <typename, typename> friend class periodic_wait_allocator;
+
+  periodic_wait_slot* slot_;
+  Allocator allocator_;
+};
+
+// Adapts a handler so that its wait operation is allocated through a
+// periodic timer's slot.
+template <typename Handler>
+class periodic_wait_handler
+{
+public:
+  typedef void result_type;
+
+  template <typename H>
+  periodic_wait_handler(H&& handler, periodic_wait_slot* slot)
+    : handler_(static_cast<H&&>(handler)),
+      slot_(slot)
+  {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    static_cast<Handler&&>(handler_)(static_cast<Args&&>(args)...);
+  }
+
+//private:
+  Handler handler_;
+  periodic_wait_slot* slot_;
+};
+
+template <typename Handler>
+inline bool asio_handler_is_continuation(
+    periodic_wait_handler<Handler>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(
+      this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::periodic_wait_handler<Handler>, DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::periodic_wait_handler<Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::periodic_wait_handler<Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+template <typename Handler, typename Allocator>
+struct associated_allocator<detail::periodic_wait_handler<Handler>, Allocator>
+{
+  typedef typename detail::get_default_allocator<
+    associated_allocator_t<Handler>>::type underlying_type;
+
+  typedef detail::periodic_wait_allocator<void, underlying_type> type;
+
+  static type get(const detail::periodic_wait_handler<Handler>& h,
+      const Allocator& = Allocator()) noexcept
+  {
+    return type(h.slot_, detail::get_default_allocator<
+        associated_allocator_t<Handler>>::get(
+          (get_associated_allocator)(h.handler_)));
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_PERIODIC_WAIT_SLOT_HPP
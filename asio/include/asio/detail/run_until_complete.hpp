@@ -0,0 +1,331 @@
+//
+// detail/run_until_complete.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_RUN_UNTIL_COMPLETE_HPP
+#define ASIO_DETAIL_RUN_UNTIL_COMPLETE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <exception>
+#include <new>
+#include <tuple>
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Storage for a single value that is constructed when the operation completes.
+template <typename T>
+class run_until_complete_value
+{
+public:
+  run_until_complete_value()
+    : has_value_(false)
+  {
+  }
+
+  ~run_until_complete_value()
+  {
+    if (has_value_)
+      value().~T();
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    new (&storage_) T(static_cast<Args&&>(args)...);
+    has_value_ = true;
+  }
+
+  T take()
+  {
+    if (!has_value_)
+      asio::detail::throw_error(asio::error::operation_aborted);
+    return static_cast<T&&>(value());
+  }
+
+private:
+  run_until_complete_value(const run_until_complete_value&) = delete;
+  run_until_complete_value& operator=(
+      const run_until_complete_value&) = delete;
+
+  T& value()
+  {
+    return *static_cast<T*>(static_cast<void*>(&storage_));
+  }
+
+  aligned_storage_t<sizeof(T), alignment_of<T>::value> storage_;
+  bool has_value_;
+};
+
+// Stores the values passed to the completion handler. An operation that
+// produces no values returns void, one value is returned as is, and several
+// values are returned as a tuple.
+template <typename... Values>
+class run_until_complete_values
+  : private run_until_complete_value<std::tuple<Values...>>
+{
+public:
+  typedef std::tuple<Values...> result_type;
+
+  template <typename... Args>
+  void set_values(Args&&... args)
+  {
+    this->emplace(static_cast<Args&&>(args)...);
+  }
+
+  result_type take_values()
+  {
+    return this->take();
+  }
+};
+
+template <typename Value>
+class run_until_complete_values<Value>
+  : private run_until_complete_value<Value>
+{
+public:
+  typedef Value result_type;
+
+  template <typename Arg>
+  void set_values(Arg&& arg)
+  {
+    this->emplace(static_cast<Arg&&>(arg));
+  }
+
+  result_type take_values()
+  {
+    return this->take();
+  }
+};
+
+template <>
+class run_until_complete_values<>
+{
+public:
+  typedef void result_type;
+
+  void set_values()
+  {
+  }
+
+  void take_values()
+  {
+  }
+};
+
+// Holds the result of an operation, given the decayed argument types of its
+// completion signature.
+template <typename... Values>
+class run_until_complete_result
+  : public run_until_complete_values<Values...>
+{
+public:
+  typedef typename run_until_complete_values<Values...>::result_type
+    result_type;
+
+  template <typename... Args>
+  void set_result(Args&&... args)
+  {
+    this->set_values(static_cast<Args&&>(args)...);
+  }
+
+  result_type get_result()
+  {
+    return this->take_values();
+  }
+};
+
+// An error_code as the first argument is thrown rather than returned.
+template <typename... Values>
+class run_until_complete_result<asio::error_code, Values...>
+  : public run_until_complete_values<Values...>
+{
+public:
+  typedef typename run_until_complete_values<Values...>::result_type
+    result_type;
+
+  template <typename... Args>
+  void set_result(const asio::error_code& ec, Args&&... args)
+  {
+    ec_ = ec;
+    this->set_values(static_cast<Args&&>(args)...);
+  }
+
+  result_type get_result()
+  {
+    asio::detail::throw_error(ec_);
+    return this->take_values();
+  }
+
+  result_type get_result(asio::error_code& ec)
+  {
+    ec = ec_;
+    return this->take_values();
+  }
+
+private:
+  asio::error_code ec_;
+};
+
+// An exception_ptr as the first argument is rethrown if set.
+template <typename... Values>
+class run_until_complete_result<std::exception_ptr, Values...>
+  : public run_until_complete_values<Values...>
+{
+public:
+  typedef typename run_until_complete_values<Values...>::result_type
+    result_type;
+
+  template <typename... Args>
+  void set_result(std::exception_ptr ex, Args&&... args)
+  {
+    ex_ = static_cast<std::exception_ptr&&>(ex);
+    this->set_values(static_cast<Args&&>(args)...);
+  }
+
+  result_type get_result()
+  {
+    if (ex_)
+      std::rethrow_exception(ex_);
+    return this->take_values();
+  }
+
+private:
+  std::exception_ptr ex_;
+};
+
+// The state of a synchronous wait on an operation. It lives on the stack of
+// the waiting thread, which runs the owner's handlers until the completion
+// handler has stored the result and set the flag.
+template <typename Owner, typename Signature>
+class run_until_complete_state;
+
+template <typename Owner, typename... Args>
+class run_until_complete_state<Owner, void(Args...)>
+  : public run_until_complete_result<decay_t<Args>...>
+{
+public:
+  typedef typename run_until_complete_result<decay_t<Args>...>::result_type
+    result_type;
+
+  explicit run_until_complete_state(Owner& owner)
+    : owner_(owner),
+      complete_(false),
+      abandoned_(false)
+  {
+  }
+
+  // Store the result and wake the waiting thread. The state may be destroyed
+  // as soon as the flag is set.
+  template <typename... T>
+  void complete(T&&... args)
+  {
+    this->set_result(static_cast<T&&>(args)...);
+    owner_.notify_complete(complete_);
+  }
+
+  // Wake the waiting thread when the completion handler has been destroyed
+  // without being invoked, as the operation can no longer complete.
+  void abandon()
+  {
+    abandoned_ = true;
+    owner_.notify_complete(complete_);
+  }
+
+  // Get the result, or throw operation_aborted if there is none.
+  result_type get_result()
+  {
+    if (abandoned_)
+      asio::detail::throw_error(asio::error::operation_aborted);
+    return run_until_complete_result<decay_t<Args>...>::get_result();
+  }
+
+  // Get the result, setting operation_aborted if there is none. An operation
+  // that produces values other than the error still throws in that case.
+  result_type get_result(asio::error_code& ec)
+  {
+    if (abandoned_)
+    {
+      ec = asio::error::operation_aborted;
+      return this->take_values();
+    }
+    return run_until_complete_result<decay_t<Args>...>::get_result(ec);
+  }
+
+  // The flag that is set when the operation completes.
+  const bool& completed() const
+  {
+    return complete_;
+  }
+
+private:
+  run_until_complete_state(const run_until_complete_state&) = delete;
+  run_until_complete_state& operator=(
+      const run_until_complete_state&) = delete;
+
+  Owner& owner_;
+  bool complete_;
+  bool abandoned_;
+};
+
+// The completion handler passed to the operation. It is move-only, so that
+// the one object that has been neither moved from nor invoked can tell the
+// waiting thread when it is destroyed.
+template <typename State>
+class run_until_complete_handler
+{
+public:
+  explicit run_until_complete_handler(State& state)
+    : state_(&state)
+  {
+  }
+
+  run_until_complete_handler(run_until_complete_handler&& other) noexcept
+    : state_(other.state_)
+  {
+    other.state_ = 0;
+  }
+
+  ~run_until_complete_handler()
+  {
+    if (state_)
+      state_->abandon();
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    State* state = state_;
+    state_ = 0;
+    state->complete(static_cast<Args&&>(args)...);
+  }
+
+private:
+  run_until_complete_handler& operator=(
+      const run_until_complete_handler&) = delete;
+
+  State* state_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_RUN_UNTIL_COMPLETE_HPP
@@ -58,6 +58,17 @@ public:
   // Destroy all user-defined handler objects owned by the service.
   ASIO_DECL void shutdown();
 
+  // Add the memory held by threads running the scheduler to the counters.
+  ASIO_DECL void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
+  // Ask threads running the scheduler to release their cached memory.
+  ASIO_DECL void trim_memory();
+
+  // Apply a new cache limit to threads running the scheduler.
+  ASIO_DECL void set_memory_limits(
+      const execution_context::memory_limits& limits);
+
   // Initialise the task, if required.
   ASIO_DECL void init_task();
 
@@ -67,10 +78,23 @@ public:
   // Run until interrupted or one operation is performed.
   ASIO_DECL std::size_t run_one(asio::error_code& ec);
 
+  // Run the event loop until interrupted, no more work, or no operation has
+  // been ready to run for the specified time.
+  ASIO_DECL std::size_t run_until_idle(long usec, asio::error_code& ec);
+
   // Run until timeout, interrupted, or one operation is performed.
   ASIO_DECL std::size_t wait_one(
       long usec, asio::error_code& ec);
 
+  // Run operations on the calling thread until the given flag is set by a
+  // call to notify_complete(), whether or not the scheduler is stopped.
+  ASIO_DECL std::size_t run_until_complete(
+      const bool& complete, asio::error_code& ec);
+
+  // Set a flag on which a thread may be waiting in run_until_complete(), and
+  // wake that thread.
+  ASIO_DECL void notify_complete(bool& complete);
+
   // Poll for operations without blocking.
   ASIO_DECL std::size_t poll(asio::error_code& ec);
 
@@ -119,6 +143,15 @@ public:
   ASIO_DECL void post_immediate_completions(std::size_t n,
       op_queue<operation>& ops, bool is_continuation);
 
+  // Request invocation of the given operation on the preferred thread and
+  // return immediately. The operation is kept on the current thread if it is
+  // the preferred thread, is running the scheduler and is not overloaded. It
+  // is given to another preferred thread if that thread is running the task,
+  // which is then interrupted. The operation is otherwise posted normally.
+  // Assumes that work_started() has not yet been called for the operation.
+  ASIO_DECL void post_affine_completion(operation* op,
+      thread_info_base* preferred_thread, bool is_continuation);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(operation* op);
@@ -141,6 +174,25 @@ public:
     return concurrency_hint_;
   }
 
+  // A snapshot of the load on the scheduler.
+  struct load_sample
+  {
+    // Whether operations are queued waiting for a thread.
+    bool work_queued;
+
+    // The number of threads waiting for operations.
+    std::size_t idle_threads;
+
+    // The number of times a thread has started waiting for operations.
+    std::size_t idle_transitions;
+
+    // Whether a thread is running the task and may be blocked in it.
+    bool task_waiting;
+  };
+
+  // Take a snapshot of the load on the scheduler.
+  ASIO_DECL load_sample sample_load() const;
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -151,9 +203,13 @@ private:
   // Structure containing thread-specific data.
   typedef scheduler_thread_info thread_info;
 
-  // Run at most one operation. May block.
+  // Run at most one operation. May block. If idle_usec is non-negative,
+  // returns without running an operation once no operation has been ready for
+  // that time. If complete is non-null, ignores stop requests and returns
+  // without running an operation once the flag it points to is set.
   ASIO_DECL std::size_t do_run_one(mutex::scoped_lock& lock,
-      thread_info& this_thread, const asio::error_code& ec);
+      thread_info& this_thread, const asio::error_code& ec,
+      long idle_usec = -1, const bool* complete = 0);
 
   // Run at most one operation with a timeout. May block.
   ASIO_DECL std::size_t do_wait_one(mutex::scoped_lock& lock,
@@ -163,13 +219,48 @@ private:
   ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const asio::error_code& ec);
 
+  // Determine whether operations are queued that no idle thread is about to
+  // run, including the task when it is not running.
+  ASIO_DECL bool has_waiting_work();
+
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
+  // Remove the work deferred by the calling thread from the count of
+  // outstanding work, stopping the scheduler if none remains. The mutex must
+  // be locked.
+  ASIO_DECL void flush_deferred_work(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Determine whether the main queue holds handlers, as opposed to only the
+  // task. The mutex must be locked.
+  ASIO_DECL bool has_queued_handlers();
+
+  // Add the calling thread to the list of threads that accept affine
+  // operations. The mutex must be locked.
+  ASIO_DECL void add_affine_thread(thread_info& this_thread);
+
+  // Remove the calling thread from the list of threads that accept affine
+  // operations, taking any operations given to it by other threads. The mutex
+  // must be locked.
+  ASIO_DECL void remove_affine_thread(thread_info& this_thread);
+
+  // Move the thread's affine operations to the main queue if other threads
+  // are idle. Returns true if operations were moved. The mutex must be locked.
+  ASIO_DECL bool share_affine_operations(thread_info& this_thread);
+
   // Wake a single idle thread, or the task, and always unlock the mutex.
   ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Ask all threads to apply the cache limit and trim their caches.
+  ASIO_DECL void start_memory_generation(mutex::scoped_lock& lock);
+
+  // Apply the cache limit and report the cache size for the calling thread.
+  // Returns true if the mutex was released to trim the cache.
+  ASIO_DECL bool update_thread_cache(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
   // Get the default task.
   ASIO_DECL static scheduler_task* get_default_task(
       asio::execution_context& ctx);
@@ -186,6 +277,29 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to return a thread's affine operations on block exit.
+  struct affine_cleanup;
+  friend struct affine_cleanup;
+
+  // Helper class to flush a thread's deferred work on block exit.
+  struct deferred_work_cleanup;
+  friend struct deferred_work_cleanup;
+
+  // Helper class to withdraw a thread's reported cache size on block exit.
+  struct cache_report_cleanup;
+  friend struct cache_report_cleanup;
+
+  // Helper class to end the work held by run_until_complete() on block exit.
+  struct completion_wait_cleanup;
+  friend struct completion_wait_cleanup;
+
+  // Limits on the operations that are kept on a thread by affinity. A thread
+  // is considered overloaded once it holds max_affine_ops operations, and it
+  // runs at most max_affine_run affine operations in a row while there are
+  // handlers waiting in the main queue. Affine operations are given to the
+  // main queue when the thread starts a handler while other threads are idle.
+  enum { max_affine_ops = 16, max_affine_run = 16 };
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -227,6 +341,28 @@ private:
 
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
+
+  // Incremented to ask threads running the scheduler to apply the cache limit
+  // and trim their caches.
+  std::size_t memory_generation_;
+
+  // The cache limit for threads running the scheduler.
+  std::size_t thread_cache_limit_;
+
+  // The cache depth for threads running the scheduler.
+  std::size_t thread_cache_depth_;
+
+  // The total cache size reported by threads running the scheduler.
+  std::size_t thread_cache_bytes_;
+
+  // The number of threads waiting for operations.
+  std::size_t idle_threads_;
+
+  // The number of times a thread has started waiting for operations.
+  std::size_t idle_transitions_;
+
+  // The threads that accept affine operations.
+  thread_info* affine_threads_;
 };
 
 } // namespace detail
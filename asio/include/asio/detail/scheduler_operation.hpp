@@ -44,6 +44,13 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // Determine whether the operation is completed by the specified function.
+  template <typename Func>
+  bool completes_with(Func func) const
+  {
+    return func_ == func;
+  }
+
 protected:
   typedef void (*func_type)(void*,
       scheduler_operation*,
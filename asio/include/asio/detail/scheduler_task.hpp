@@ -34,6 +34,13 @@ public:
   // Interrupt the task.
   virtual void interrupt() = 0;
 
+  // Determine whether an operation returned by run() has work to do. Called
+  // with the scheduler's lock held, so must not block.
+  virtual bool has_work(scheduler_operation*)
+  {
+    return true;
+  }
+
 protected:
   // Prevent deletion through this type.
   ~scheduler_task()
@@ -28,8 +28,68 @@ class scheduler_operation;
 
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info()
+    : defers_work_finished(false),
+      deferred_work_finished(0),
+      affine_op_count(0),
+      affine_op_limit(0),
+      affine_run_count(0),
+      remote_affine_op_count(0),
+      running_task(false),
+      next_affine_thread(0),
+      memory_generation(0),
+      reports_cache_bytes(false),
+      reported_cache_bytes(0)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // Whether the thread defers removing the work of the operations it completes
+  // from the scheduler's count of outstanding work, and the number of
+  // operations for which it has done so. Operations posted by the thread reuse
+  // these units before the count is incremented, and the remainder is removed
+  // before the thread blocks or leaves the scheduler.
+  bool defers_work_finished;
+  long deferred_work_finished;
+
+  // Operations that have asked to run on this thread, where possible. These
+  // are not visible to other threads, and are returned to the main queue when
+  // the thread leaves the scheduler.
+  op_queue<scheduler_operation> affine_op_queue;
+  std::size_t affine_op_count;
+
+  // The number of affine operations the thread accepts before it is considered
+  // overloaded. Zero if the thread does not accept affine operations.
+  std::size_t affine_op_limit;
+
+  // The number of consecutive affine operations run by the thread.
+  std::size_t affine_run_count;
+
+  // Affine operations given to the thread by other threads while it runs the
+  // task, and the number of them. Moved to the thread's own affine queue when
+  // it next looks for an operation. Protected by the scheduler's mutex.
+  op_queue<scheduler_operation> remote_affine_op_queue;
+  std::size_t remote_affine_op_count;
+
+  // Whether the thread is running the task. Protected by the scheduler's
+  // mutex.
+  bool running_task;
+
+  // The next thread in the scheduler's list of threads that accept affine
+  // operations. Protected by the scheduler's mutex.
+  scheduler_thread_info* next_affine_thread;
+
+  // The scheduler's memory generation when the thread last applied the cache
+  // limit and trimmed its cache. Zero until the thread first takes the
+  // scheduler's generation, which starts at one.
+  std::size_t memory_generation;
+
+  // Whether the thread reports the size of its cache to the scheduler, and
+  // the size last reported.
+  bool reports_cache_bytes;
+  std::size_t reported_cache_bytes;
 };
 
 } // namespace detail
@@ -151,6 +151,15 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Pre-allocate state for descriptors. There is no per-descriptor state to
+  // allocate.
+  void reserve_descriptors(std::size_t)
+  {
+  }
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& queue);
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include <typeinfo>
+#include <vector>
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -52,6 +53,20 @@ public:
   // Notify all services of a fork event.
   ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
 
+  // Add the memory held by all services to the usage counters.
+  ASIO_DECL void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
+  // Ask all services to release memory held for reuse.
+  ASIO_DECL void trim_memory();
+
+  // Get the soft limits on memory held for reuse.
+  ASIO_DECL execution_context::memory_limits get_memory_limits() const;
+
+  // Store new soft limits and pass them to all services.
+  ASIO_DECL void set_memory_limits(
+      const execution_context::memory_limits& limits);
+
   // Get the service object corresponding to the specified service type. Will
   // create a new service object automatically if no such object already
   // exists. Ownership of the service object is not transferred to the caller.
@@ -75,6 +90,21 @@ public:
   template <typename Service>
   bool has_service() const;
 
+  // Create a service object using the owning context's memory resource. The
+  // object is returned to the resource when it is destroyed.
+  template <typename Service, typename Owner, typename... Args>
+  static Service* create_service(Owner& owner, Args&&... args);
+
+  // Destroy a service instance.
+  ASIO_DECL static void destroy(execution_context::service* service);
+
+  // Helper class to manage service pointers.
+  struct auto_service_ptr
+  {
+    execution_context::service* ptr_;
+    ~auto_service_ptr() { destroy(ptr_); }
+  };
+
 private:
   // Initalise a service's key when the key_type typedef is not available.
   template <typename Service>
@@ -111,17 +141,9 @@ private:
   template <typename Service, typename Owner>
   static execution_context::service* create(void* owner);
 
-  // Destroy a service instance.
-  ASIO_DECL static void destroy(execution_context::service* service);
-
-  // Helper class to manage service pointers.
-  struct auto_service_ptr;
-  friend struct auto_service_ptr;
-  struct auto_service_ptr
-  {
-    execution_context::service* ptr_;
-    ~auto_service_ptr() { destroy(ptr_); }
-  };
+  // Destroy a service instance allocated by create_service().
+  template <typename Service>
+  static void destroy_service(execution_context::service* service);
 
   // Get the service object corresponding to the specified service key. Will
   // create a new service object automatically if no such object already
@@ -140,6 +162,10 @@ private:
   ASIO_DECL bool do_has_service(
       const execution_context::service::key& key) const;
 
+  // Make a copy of all of the services, in reverse order of registration.
+  ASIO_DECL void copy_services(
+      std::vector<execution_context::service*>& services) const;
+
   // Mutex to protect access to internal data.
   mutable asio::detail::mutex mutex_;
 
@@ -148,6 +174,9 @@ private:
 
   // The first service in the list of contained services.
   execution_context::service* first_service_;
+
+  // The soft limits on memory held for reuse.
+  execution_context::memory_limits memory_limits_;
 };
 
 } // namespace detail
@@ -49,6 +49,12 @@ public:
     mutex_.lock();
   }
 
+  // Try to lock the mutex without blocking.
+  bool try_lock()
+  {
+    return mutex_.try_lock();
+  }
+
   // Unlock the mutex.
   void unlock()
   {
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/executor_op.hpp"
+#include "asio/detail/is_affine_executor.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
@@ -32,6 +33,9 @@
 namespace asio {
 namespace detail {
 
+class scheduler;
+class thread_info_base;
+
 // Default service implementation for a strand.
 class strand_executor_service
   : public execution_context_service_base<strand_executor_service>
@@ -58,6 +62,26 @@ public:
     // handlers.
     bool shutdown_;
 
+    // The maximum number of handlers that may be run each time the strand is
+    // scheduled, or zero if there is no limit. Protected by the mutex.
+    std::size_t run_budget_;
+
+    // The number of handlers that may be run in the current scheduling slice.
+    // Set when the strand lock is acquired and only accessed within the strand.
+    std::size_t slice_budget_;
+
+    // The scheduler used to keep the strand on the thread that last ran it, or
+    // null if the strand has no thread affinity. Protected by the mutex.
+    scheduler* affinity_scheduler_;
+
+    // The affinity scheduler for the current scheduling slice. Set when the
+    // strand lock is acquired and only accessed within the strand.
+    scheduler* slice_scheduler_;
+
+    // The thread that last ran the strand's handlers, used only to identify
+    // the thread to the affinity scheduler. Only accessed within the strand.
+    thread_info_base* last_thread_;
+
     // The handlers that are waiting on the strand but should not be run until
     // after the next time the strand is scheduled. This queue must only be
     // modified while the mutex is locked.
@@ -122,10 +146,27 @@ public:
   ASIO_DECL static bool running_in_this_thread(
       const implementation_type& impl);
 
+  // Set the maximum number of handlers to run per scheduling slice.
+  ASIO_DECL static void set_run_budget(const implementation_type& impl,
+      std::size_t max_handlers);
+
+  // Get the maximum number of handlers to run per scheduling slice.
+  ASIO_DECL static std::size_t get_run_budget(
+      const implementation_type& impl);
+
+  // Set whether the strand prefers to stay on the thread that last ran it.
+  ASIO_DECL static void set_thread_affinity(const implementation_type& impl,
+      bool affinity);
+
+  // Get whether the strand prefers to stay on the thread that last ran it.
+  ASIO_DECL static bool get_thread_affinity(const implementation_type& impl);
+
 private:
   friend class strand_impl;
   template <typename F, typename Allocator> class allocator_binder;
   template <typename Executor, typename = void> class invoker;
+  template <typename Executor> class inline_invoker;
+  template <typename Executor, typename = void> struct can_run_inline;
 
   // Adds a function to the strand. Returns true if it acquires the lock.
   ASIO_DECL static bool enqueue(const implementation_type& impl,
@@ -133,10 +174,20 @@ private:
 
   // Transfers waiting handlers to the ready queue. Returns true if one or more
   // handlers were transferred.
-  ASIO_DECL static bool push_waiting_to_ready(implementation_type& impl);
+  ASIO_DECL static bool push_waiting_to_ready(
+      const implementation_type& impl);
 
-  // Invokes all ready-to-run handlers.
-  ASIO_DECL static void run_ready_handlers(implementation_type& impl);
+  // Invokes ready-to-run handlers, up to the budget for the current slice.
+  ASIO_DECL static void run_ready_handlers(const implementation_type& impl);
+
+  // Schedules the strand to run on the thread that last ran it, if possible.
+  template <typename Function, typename Allocator>
+  static void post_affine(const implementation_type& impl,
+      Function&& function, const Allocator& a, bool is_continuation);
+
+  // Passes an operation to the strand's affinity scheduler.
+  ASIO_DECL static void post_affine_completion(strand_impl* impl,
+      scheduler_operation* op, bool is_continuation);
 
   // Helper function to request invocation of the given function.
   template <typename Executor, typename Function, typename Allocator>
@@ -158,6 +209,9 @@ private:
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
+
+  // The scheduler belonging to the execution context, if it has one.
+  scheduler* scheduler_;
 };
 
 } // namespace detail
@@ -17,10 +17,10 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/io_context.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
-#include "asio/detail/scoped_ptr.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -70,6 +70,21 @@ public:
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+
+    // The number of strand objects referring to this implementation, plus one
+    // while the implementation is scheduled on the io_context.
+    atomic_count ref_count_;
+
+    // Pointers to adjacent handle implementations in linked list.
+    strand_impl* next_;
+    strand_impl* prev_;
+
+    // The strand service in where the implementation is held, or null if the
+    // service has been destroyed.
+    strand_service* service_;
+
+    // The memory resource from which the implementation was allocated.
+    memory_resource* memory_resource_;
   };
 
   typedef strand_impl* implementation_type;
@@ -77,12 +92,22 @@ public:
   // Construct a new strand service for the specified io_context.
   ASIO_DECL explicit strand_service(asio::io_context& io_context);
 
+  // Destructor.
+  ASIO_DECL ~strand_service();
+
   // Destroy all user-defined handler objects owned by the service.
   ASIO_DECL void shutdown();
 
   // Construct a new strand implementation.
   ASIO_DECL void construct(implementation_type& impl);
 
+  // Construct a strand implementation that shares the state of another.
+  ASIO_DECL static void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Destroy a strand implementation.
+  ASIO_DECL static void destroy(implementation_type& impl);
+
   // Request the io_context to invoke the given handler.
   template <typename Handler>
   void dispatch(implementation_type& impl, Handler& handler);
@@ -107,28 +132,24 @@ private:
       operation* base, const asio::error_code& ec,
       std::size_t bytes_transferred);
 
+  // Schedule the strand on the io_context to run its ready handlers.
+  ASIO_DECL void schedule(implementation_type& impl, bool is_continuation);
+
+  // Release a reference to the implementation, destroying it if it was the
+  // last.
+  ASIO_DECL static void release(strand_impl* impl);
+
   // The io_context used to obtain an I/O executor.
   io_context& io_context_;
 
   // The io_context implementation used to post completions.
   io_context_impl& io_context_impl_;
 
-  // Mutex to protect access to the array of implementations.
+  // Mutex to protect access to the list of implementations.
   asio::detail::mutex mutex_;
 
-  // Number of implementations shared between all strand objects.
-#if defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = ASIO_STRAND_IMPLEMENTATIONS };
-#else // defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = 193 };
-#endif // defined(ASIO_STRAND_IMPLEMENTATIONS)
-
-  // Pool of implementations.
-  scoped_ptr<strand_impl> implementations_[num_implementations];
-
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same strand implementation.
-  std::size_t salt_;
+  // The head of a linked list of all implementations.
+  strand_impl* impl_list_;
 };
 
 } // namespace detail
@@ -34,9 +34,17 @@ public:
   // not running inside a thread context.
   ASIO_DECL static thread_info_base* top_of_thread_call_stack();
 
+  // Determine whether the handler running on the current thread has run for
+  // at least the given time while other work is waiting. Returns false when
+  // not running inside a thread context.
+  ASIO_DECL static bool this_thread_should_yield(long usec);
+
 protected:
   // Per-thread call stack to track the state of each thread in the context.
   typedef call_stack<thread_context, thread_info_base> thread_call_stack;
+
+  // Determine whether other work is waiting to be run.
+  virtual bool has_waiting_work() = 0;
 };
 
 } // namespace detail
@@ -16,11 +16,21 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include <climits>
 #include <cstddef>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/coroutine_frame_stack.hpp"
+#include "asio/detail/limits.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+# include "asio/detail/coarse_clock.hpp"
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+
+#if defined(ASIO_HAS_THREADS)
+# include <atomic>
+#endif // defined(ASIO_HAS_THREADS)
+
 #if !defined(ASIO_NO_EXCEPTIONS)
 # include <exception>
 # include "asio/multiple_exceptions.hpp"
@@ -31,21 +41,18 @@
 namespace asio {
 namespace detail {
 
-#ifndef ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
-#endif // ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-
 class thread_info_base
   : private noncopyable
 {
 public:
+  // Each purpose has its own set of size class bins. The maximum number of
+  // blocks retained in each bin is the thread's cache depth.
+
   struct default_tag
   {
     enum
     {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = 0,
-      end_mem_index = cache_size
+      mem_index = 0
     };
   };
 
@@ -53,9 +60,7 @@ public:
   {
     enum
     {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = default_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      mem_index = 1
     };
   };
 
@@ -63,9 +68,7 @@ public:
   {
     enum
     {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = awaitable_frame_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      mem_index = 2
     };
   };
 
@@ -73,9 +76,7 @@ public:
   {
     enum
     {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = executor_function_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      mem_index = 3
     };
   };
 
@@ -83,33 +84,109 @@ public:
   {
     enum
     {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = cancellation_signal_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      mem_index = 4
     };
   };
 
-  enum { max_mem_index = parallel_group_tag::end_mem_index };
+  enum { max_mem_index = 5 };
+
+  // Blocks are cached in power-of-two size classes from 64 bytes to 4KB.
+  // Larger allocations go straight to the heap.
+  enum
+  {
+    min_size_class_shift = 6,
+    num_size_classes = 7,
+    max_size_class_size = 1 << (min_size_class_shift + num_size_classes - 1)
+  };
+
+  // Counters describing how the cache has been used by this thread.
+  struct memory_statistics
+  {
+    // Number of allocations satisfied from the cache.
+    std::size_t hits;
+
+    // Number of cacheable allocations that had to go to the heap.
+    std::size_t misses;
+
+    // Number of allocations too large to be cached.
+    std::size_t oversized;
+
+    // Number of deallocations returned to the heap because a bin was full or
+    // the cache limit was reached.
+    std::size_t releases;
+
+    // Total size of the blocks currently held by this thread, including those
+    // waiting to be exchanged with other threads.
+    std::size_t cached_bytes;
+
+    // Number of batches of blocks handed to the shared depot.
+    std::size_t batches_returned;
+
+    // Number of batches of blocks taken from the shared depot.
+    std::size_t batches_received;
+  };
 
   thread_info_base()
+    : cache_limit_((std::numeric_limits<std::size_t>::max)()),
+      cache_depth_(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE),
+      handler_count_(0),
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+      handler_start_(0),
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+      yield_check_handler_(0)
 #if !defined(ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   {
     for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
+    {
+      for (int j = 0; j < num_size_classes; ++j)
+      {
+        reusable_memory_[i][j].head = 0;
+        reusable_memory_[i][j].count = 0;
+      }
+    }
+
+#if defined(ASIO_HAS_THREADS)
+    for (int j = 0; j < num_size_classes; ++j)
+    {
+      outgoing_[j] = 0;
+      spare_[j] = 0;
+    }
+#endif // defined(ASIO_HAS_THREADS)
+
+    statistics_.hits = 0;
+    statistics_.misses = 0;
+    statistics_.oversized = 0;
+    statistics_.releases = 0;
+    statistics_.cached_bytes = 0;
+    statistics_.batches_returned = 0;
+    statistics_.batches_received = 0;
   }
 
   ~thread_info_base()
   {
     for (int i = 0; i < max_mem_index; ++i)
     {
-      // The following test for non-null pointers is technically redundant, but
-      // it is significantly faster when using a tight io_context::poll() loop
-      // in latency sensitive applications.
-      if (reusable_memory_[i])
-        aligned_delete(reusable_memory_[i]);
+      for (int j = 0; j < num_size_classes; ++j)
+      {
+        delete_list(reusable_memory_[i][j].head);
+      }
+    }
+
+#if defined(ASIO_HAS_THREADS)
+    for (int j = 0; j < num_size_classes; ++j)
+    {
+      if (outgoing_[j])
+        return_batch(j, outgoing_[j]);
+      while (spare_[j])
+      {
+        free_block* batch = spare_[j];
+        spare_[j] = batch->next_batch;
+        return_batch(j, batch);
+      }
     }
+#endif // defined(ASIO_HAS_THREADS)
   }
 
   static void* allocate(thread_info_base* this_thread,
@@ -128,71 +205,260 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    int size_class = size_class_of(size);
+    if (size_class == num_size_classes)
+    {
+      if (this_thread)
+        ++this_thread->statistics_.oversized;
+      return aligned_new(align, size);
+    }
+
+    std::size_t block_size = size_class_size(size_class);
 
     if (this_thread)
     {
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
+      bin& b = this_thread->reusable_memory_[Purpose::mem_index][size_class];
+      if (b.head && reinterpret_cast<std::size_t>(b.head) % align == 0)
       {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          unsigned char* const mem = static_cast<unsigned char*>(pointer);
-          if (static_cast<std::size_t>(mem[0]) >= chunks
-              && reinterpret_cast<std::size_t>(pointer) % align == 0)
-          {
-            this_thread->reusable_memory_[mem_index] = 0;
-            mem[size] = mem[0];
-            return pointer;
-          }
-        }
+        free_block* block = b.head;
+        b.head = block->next;
+        --b.count;
+        ++this_thread->statistics_.hits;
+        this_thread->statistics_.cached_bytes -= block_size;
+        return block;
       }
 
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
+#if defined(ASIO_HAS_THREADS)
+      // Refill an empty bin with blocks released by other threads.
+      if (!b.head && this_thread->receive_batch(size_class, b))
       {
-        if (this_thread->reusable_memory_[mem_index])
+        if (reinterpret_cast<std::size_t>(b.head) % align == 0)
         {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          this_thread->reusable_memory_[mem_index] = 0;
-          aligned_delete(pointer);
-          break;
+          free_block* block = b.head;
+          b.head = block->next;
+          --b.count;
+          ++this_thread->statistics_.hits;
+          this_thread->statistics_.cached_bytes -= block_size;
+          return block;
         }
       }
+#endif // defined(ASIO_HAS_THREADS)
+
+      ++this_thread->statistics_.misses;
     }
 
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
-    return pointer;
+    return aligned_new(align, block_size);
   }
 
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    int size_class = size_class_of(size);
+    if (size_class < num_size_classes && this_thread)
     {
-      if (this_thread)
+      std::size_t block_size = size_class_size(size_class);
+      if (this_thread->statistics_.cached_bytes + block_size
+          > this_thread->cache_limit_)
       {
-        for (int mem_index = Purpose::begin_mem_index;
-            mem_index < Purpose::end_mem_index; ++mem_index)
-        {
-          if (this_thread->reusable_memory_[mem_index] == 0)
-          {
-            unsigned char* const mem = static_cast<unsigned char*>(pointer);
-            mem[0] = mem[size];
-            this_thread->reusable_memory_[mem_index] = pointer;
-            return;
-          }
-        }
+        ++this_thread->statistics_.releases;
+        aligned_delete(pointer);
+        return;
+      }
+
+      bin& b = this_thread->reusable_memory_[Purpose::mem_index][size_class];
+      if (b.count < this_thread->cache_depth_)
+      {
+        free_block* block = static_cast<free_block*>(pointer);
+        block->next = b.head;
+        b.head = block;
+        ++b.count;
+        this_thread->statistics_.cached_bytes += block_size;
+        return;
+      }
+
+#if defined(ASIO_HAS_THREADS)
+      // The bin is full, which typically means that this thread frees blocks
+      // that were allocated elsewhere. Gather them into a batch for the
+      // depot, so that they are reused by the allocating threads.
+      free_block* block = static_cast<free_block*>(pointer);
+      free_block*& batch = this_thread->outgoing_[size_class];
+      block->next = batch;
+      block->batch_count = batch ? batch->batch_count + 1 : 1;
+      batch = block;
+      this_thread->statistics_.cached_bytes += block_size;
+      if (block->batch_count == static_cast<std::size_t>(depot::batch_size))
+      {
+        batch = 0;
+        this_thread->return_batch(size_class, block);
       }
+      return;
+#else // defined(ASIO_HAS_THREADS)
+      ++this_thread->statistics_.releases;
+#endif // defined(ASIO_HAS_THREADS)
     }
 
     aligned_delete(pointer);
   }
 
+  // Allocate a coroutine frame. Frames are taken from the thread's frame stack
+  // so that nested frames are served in LIFO order. Frames that are too large
+  // for the stack, or that the stack cannot hold because its chunks are pinned
+  // by long-lived frames, use the awaitable_frame_tag bins.
+  static void* allocate_frame(thread_info_base* this_thread, std::size_t size)
+  {
+    if (!coroutine_frame_stack::is_stack_frame(size))
+      return allocate(awaitable_frame_tag(), this_thread, size);
+
+    if (void* frame = coroutine_frame_stack::allocate(
+          this_thread ? &this_thread->frame_stack_ : 0, size))
+      return frame;
+
+    return coroutine_frame_stack::unowned_frame(
+        allocate(awaitable_frame_tag(), this_thread,
+          coroutine_frame_stack::unowned_frame_size(size)));
+  }
+
+  static void deallocate_frame(thread_info_base* this_thread,
+      void* pointer, std::size_t size)
+  {
+    if (!coroutine_frame_stack::is_stack_frame(size))
+      deallocate(awaitable_frame_tag(), this_thread, pointer, size);
+    else if (void* memory = coroutine_frame_stack::deallocate(
+          this_thread ? &this_thread->frame_stack_ : 0, pointer, size))
+    {
+      deallocate(awaitable_frame_tag(), this_thread, memory,
+          coroutine_frame_stack::unowned_frame_size(size));
+    }
+  }
+
+  // Get the cache usage counters for this thread.
+  const memory_statistics& statistics() const
+  {
+    return statistics_;
+  }
+
+  // Get the maximum number of bytes this thread will hold in its cache.
+  std::size_t cache_limit() const
+  {
+    return cache_limit_;
+  }
+
+  // Set the maximum number of bytes this thread will hold in its cache. Blocks
+  // that would take the cache over the limit are returned to the heap. The
+  // limit does not release blocks that are already cached.
+  void set_cache_limit(std::size_t limit)
+  {
+    cache_limit_ = limit;
+  }
+
+  // Get the maximum number of blocks this thread holds in each bin.
+  std::size_t cache_depth() const
+  {
+    return cache_depth_;
+  }
+
+  // Set the maximum number of blocks this thread holds in each bin. Blocks
+  // freed into a full bin are passed to other threads through the shared
+  // cache. The depth does not release blocks that are already cached.
+  void set_cache_depth(std::size_t depth)
+  {
+    cache_depth_ = depth;
+  }
+
+  // Return all cached blocks to the heap, along with the frame stack's chunk
+  // if no frames are allocated from it.
+  void trim()
+  {
+    for (int i = 0; i < max_mem_index; ++i)
+    {
+      for (int j = 0; j < num_size_classes; ++j)
+      {
+        delete_list(reusable_memory_[i][j].head);
+        reusable_memory_[i][j].head = 0;
+        reusable_memory_[i][j].count = 0;
+      }
+    }
+
+#if defined(ASIO_HAS_THREADS)
+    for (int j = 0; j < num_size_classes; ++j)
+    {
+      delete_list(outgoing_[j]);
+      outgoing_[j] = 0;
+      while (spare_[j])
+      {
+        free_block* batch = spare_[j];
+        spare_[j] = batch->next_batch;
+        delete_list(batch);
+      }
+    }
+#endif // defined(ASIO_HAS_THREADS)
+
+    statistics_.cached_bytes = 0;
+    frame_stack_.trim();
+  }
+
+  // Get the approximate number of bytes held in the cache that threads use to
+  // exchange blocks. This cache is shared by all threads in the process.
+  static std::size_t shared_cached_bytes()
+  {
+#if defined(ASIO_HAS_THREADS)
+    return depot::instance().bytes();
+#else // defined(ASIO_HAS_THREADS)
+    return 0;
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  // Return all blocks held in the shared cache to the heap.
+  static void trim_shared()
+  {
+#if defined(ASIO_HAS_THREADS)
+    depot::instance().trim();
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  // Allocate n blocks large enough to hold the specified size, and add them to
+  // the shared cache. Stops early if the shared cache is full.
+  static void reserve_shared(std::size_t n, std::size_t size)
+  {
+#if defined(ASIO_HAS_THREADS)
+    int size_class = size_class_of(size);
+    if (size_class == num_size_classes)
+      return;
+
+    while (n > 0)
+    {
+      // Free the batch if the depot does not accept it, or if an allocation
+      // throws.
+      struct batch_guard
+      {
+        ~batch_guard() { delete_list(batch_); }
+        free_block* batch_;
+      } guard = { 0 };
+
+      std::size_t count = n < static_cast<std::size_t>(depot::batch_size)
+        ? n : static_cast<std::size_t>(depot::batch_size);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        free_block* block = static_cast<free_block*>(
+            aligned_new(ASIO_DEFAULT_ALIGN, size_class_size(size_class)));
+        block->next = guard.batch_;
+        guard.batch_ = block;
+      }
+      guard.batch_->batch_count = count;
+
+      if (!depot::instance().push(size_class, guard.batch_))
+        return;
+
+      guard.batch_ = 0;
+      n -= count;
+    }
+#else // defined(ASIO_HAS_THREADS)
+    (void)n;
+    (void)size;
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
   void capture_current_exception()
   {
 #if !defined(ASIO_NO_EXCEPTIONS)
@@ -228,13 +494,267 @@ public:
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   }
 
+  // Note that the thread is about to run a new handler.
+  void handler_started()
+  {
+    ++handler_count_;
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+    handler_start_ = coarse_clock::now();
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+  }
+
+  // Determine whether the current handler has run for at least the given
+  // time since its first call to this function, or since this function last
+  // returned true. Reading the clock only when asked keeps the cost off the
+  // handlers that never ask. If the start of each handler is recorded by the
+  // coarse clock, the time is instead measured from the handler's start.
+  bool handler_run_time_exceeded(long usec)
+  {
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if (yield_check_handler_ != handler_count_)
+    {
+      yield_check_handler_ = handler_count_;
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+      // Count the time the handler ran before its first call, less the coarse
+      // clock's resolution so that the time is never overstated.
+      yield_check_start_ = now - chrono::microseconds(
+          static_cast<long long>(coarse_clock::elapsed_since(handler_start_)));
+#else // defined(ASIO_HAS_HANDLER_START_TIME)
+      yield_check_start_ = now;
+      return false;
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+    }
+
+    if (now - yield_check_start_ < chrono::microseconds(usec))
+      return false;
+
+    yield_check_start_ = now;
+    return true;
+  }
+
 private:
-#if defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 8 };
-#else // defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 4 };
-#endif // defined(ASIO_HAS_IO_URING)
-  void* reusable_memory_[max_mem_index];
+  // Get the size class used for a block of the specified size. Returns
+  // num_size_classes if the block is too large to be cached.
+  static int size_class_of(std::size_t size)
+  {
+    int size_class = 0;
+    std::size_t class_size = std::size_t(1) << min_size_class_shift;
+    while (class_size < size && size_class < num_size_classes)
+    {
+      class_size <<= 1;
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  // Get the size of the blocks in the specified size class.
+  static std::size_t size_class_size(int size_class)
+  {
+    return std::size_t(1) << (min_size_class_shift + size_class);
+  }
+
+  // An unused block, linked into the free list for its bin. The first block
+  // of a batch also links to the next batch and records the batch length.
+  struct free_block
+  {
+    free_block* next;
+    free_block* next_batch;
+    std::size_t batch_count;
+  };
+
+  // A list of unused blocks of a single size class.
+  struct bin
+  {
+    free_block* head;
+    std::size_t count;
+  };
+
+  // Free all blocks in a list.
+  static void delete_list(free_block* list)
+  {
+    while (list)
+    {
+      free_block* next = list->next;
+      aligned_delete(list);
+      list = next;
+    }
+  }
+
+#if defined(ASIO_HAS_THREADS)
+  // A process-wide, lock-free stack of batches for each size class. Batches
+  // are only ever pushed one at a time and removed all at once, so the stack
+  // is not subject to the ABA problem.
+  class depot
+    : private noncopyable
+  {
+  public:
+    // The number of blocks in a full batch, and the maximum number of batches
+    // held for each size class.
+    enum { batch_size = 16, max_batches = 64 };
+
+    static depot& instance()
+    {
+      static depot d;
+      return d;
+    }
+
+    // Add a batch to the depot. Returns false if the depot is full.
+    bool push(int size_class, free_block* batch)
+    {
+      if (counts_[size_class].fetch_add(1, std::memory_order_relaxed)
+          >= static_cast<std::size_t>(max_batches))
+      {
+        counts_[size_class].fetch_sub(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      free_block* head = heads_[size_class].load(std::memory_order_relaxed);
+      do
+      {
+        batch->next_batch = head;
+      } while (!heads_[size_class].compare_exchange_weak(head, batch,
+            std::memory_order_release, std::memory_order_relaxed));
+      return true;
+    }
+
+    // Remove all batches from the depot. Only the batches that were taken are
+    // removed from the count, as a concurrent push may already have counted a
+    // batch that it has not yet linked into the stack.
+    free_block* pop_all(int size_class)
+    {
+      if (!heads_[size_class].load(std::memory_order_relaxed))
+        return 0;
+      free_block* batches = heads_[size_class].exchange(
+          0, std::memory_order_acquire);
+      std::size_t count = 0;
+      for (free_block* batch = batches; batch; batch = batch->next_batch)
+        ++count;
+      if (count > 0)
+        counts_[size_class].fetch_sub(count, std::memory_order_relaxed);
+      return batches;
+    }
+
+    // Get the approximate number of bytes held, assuming full batches.
+    std::size_t bytes() const
+    {
+      std::size_t total = 0;
+      for (int i = 0; i < num_size_classes; ++i)
+      {
+        std::size_t count = counts_[i].load(std::memory_order_relaxed);
+        if (count > static_cast<std::size_t>(max_batches))
+          count = max_batches;
+        total += count * batch_size * size_class_size(i);
+      }
+      return total;
+    }
+
+    // Free all batches.
+    void trim()
+    {
+      for (int i = 0; i < num_size_classes; ++i)
+      {
+        free_block* batch = pop_all(i);
+        while (batch)
+        {
+          free_block* next_batch = batch->next_batch;
+          delete_list(batch);
+          batch = next_batch;
+        }
+      }
+    }
+
+  private:
+    depot()
+    {
+      for (int i = 0; i < num_size_classes; ++i)
+      {
+        heads_[i].store(0, std::memory_order_relaxed);
+        counts_[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    ~depot()
+    {
+      for (int i = 0; i < num_size_classes; ++i)
+      {
+        free_block* batch = heads_[i].load(std::memory_order_acquire);
+        while (batch)
+        {
+          free_block* next_batch = batch->next_batch;
+          delete_list(batch);
+          batch = next_batch;
+        }
+      }
+    }
+
+    std::atomic<free_block*> heads_[num_size_classes];
+    std::atomic<std::size_t> counts_[num_size_classes];
+  };
+
+  // Hand a batch to the depot, or free it if the depot is full.
+  void return_batch(int size_class, free_block* batch)
+  {
+    statistics_.cached_bytes -= batch->batch_count * size_class_size(size_class);
+    if (depot::instance().push(size_class, batch))
+      ++statistics_.batches_returned;
+    else
+    {
+      statistics_.releases += batch->batch_count;
+      delete_list(batch);
+    }
+  }
+
+  // Refill an empty bin from a spare batch or from the depot. The depot is
+  // left alone once the thread has reached its cache limit.
+  bool receive_batch(int size_class, bin& b)
+  {
+    if (!spare_[size_class])
+    {
+      if (statistics_.cached_bytes >= cache_limit_)
+        return false;
+      spare_[size_class] = depot::instance().pop_all(size_class);
+      if (!spare_[size_class])
+        return false;
+      ++statistics_.batches_received;
+      for (free_block* batch = spare_[size_class];
+          batch; batch = batch->next_batch)
+      {
+        statistics_.cached_bytes +=
+          batch->batch_count * size_class_size(size_class);
+      }
+    }
+
+    free_block* batch = spare_[size_class];
+    spare_[size_class] = batch->next_batch;
+    b.head = batch;
+    b.count = batch->batch_count;
+    return true;
+  }
+#endif // defined(ASIO_HAS_THREADS)
+
+  bin reusable_memory_[max_mem_index][num_size_classes];
+  memory_statistics statistics_;
+  std::size_t cache_limit_;
+  std::size_t cache_depth_;
+  coroutine_frame_stack frame_stack_;
+
+  // The number of handlers started by the thread, the coarse time at which the
+  // current handler started, and the handler count when the running time of a
+  // handler was first measured.
+  std::size_t handler_count_;
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+  uint64_t handler_start_;
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+  std::size_t yield_check_handler_;
+  chrono::steady_clock::time_point yield_check_start_;
+
+#if defined(ASIO_HAS_THREADS)
+  // Blocks waiting to be handed to the depot as a batch.
+  free_block* outgoing_[num_size_classes];
+
+  // Batches taken from the depot but not yet needed.
+  free_block* spare_[num_size_classes];
+#endif // defined(ASIO_HAS_THREADS)
 
 #if !defined(ASIO_NO_EXCEPTIONS)
   int has_pending_exception_;
@@ -0,0 +1,182 @@
+//
+// detail/thread_timer_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_TIMER_QUEUE_HPP
+#define ASIO_DETAIL_THREAD_TIMER_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/timer_queue.hpp"
+#include "asio/detail/timer_queue_ptime.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A timer queue that is protected by its own mutex rather than by the
+// reactor's mutex. A separate queue is kept for each thread that arms timers
+// from inside a run function, so that arming a timer only contends with the
+// reactor when the timer becomes the earliest in its queue.
+template <typename Time_Traits>
+class thread_timer_queue
+  : public timer_queue<Time_Traits>
+{
+public:
+  // The maximum number of threads that may have their own queue at the same
+  // time. Timers armed from any other thread use the shared queue.
+  enum { max_threads = 64 };
+
+  // Constructor.
+  thread_timer_queue()
+    : shutdown_(false)
+  {
+  }
+
+  // Get the mutex that protects the queue.
+  asio::detail::mutex& mutex()
+  {
+    return mutex_;
+  }
+
+  // Whether the queue has been shut down. Must be called with the mutex held.
+  bool is_shutdown() const
+  {
+    return shutdown_;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return timer_queue<Time_Traits>::empty();
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return timer_queue<Time_Traits>::wait_duration_msec(max_duration);
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return timer_queue<Time_Traits>::wait_duration_usec(max_duration);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    timer_queue<Time_Traits>::get_ready_timers(ops);
+  }
+
+  // Dequeue all timers. This is only done when the reactor shuts down, after
+  // which no further timers are accepted.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    timer_queue<Time_Traits>::get_all_timers(ops);
+    shutdown_ = true;
+  }
+
+  // Get a small, process-wide index identifying the calling thread, or
+  // max_threads if all indexes are in use. A thread is given an index the
+  // first time it asks for one, and the index is reused once the thread exits.
+  static std::size_t this_thread_index()
+  {
+    static thread_local thread_index index;
+    return index.value();
+  }
+
+private:
+  // Holds the calling thread's index for the lifetime of the thread.
+  class thread_index
+  {
+  public:
+    thread_index()
+      : value_(acquire())
+    {
+    }
+
+    ~thread_index()
+    {
+      release(value_);
+    }
+
+    std::size_t value() const
+    {
+      return value_;
+    }
+
+  private:
+    static std::atomic<uint64_t>& used_indexes()
+    {
+      static std::atomic<uint64_t> used(0);
+      return used;
+    }
+
+    // Claim the lowest free index. The acquire ordering ensures that a thread
+    // reusing an index sees the queues created by the index's previous owner.
+    static std::size_t acquire()
+    {
+      std::atomic<uint64_t>& used = used_indexes();
+      uint64_t current = used.load(std::memory_order_relaxed);
+      while (~current != 0)
+      {
+        std::size_t index = 0;
+        while (current & (uint64_t(1) << index))
+          ++index;
+        if (used.compare_exchange_weak(current,
+              current | (uint64_t(1) << index), std::memory_order_acquire))
+          return index;
+      }
+      return max_threads;
+    }
+
+    static void release(std::size_t index)
+    {
+      if (index < max_threads)
+      {
+        used_indexes().fetch_and(~(uint64_t(1) << index),
+            std::memory_order_release);
+      }
+    }
+
+    std::size_t value_;
+  };
+
+  // Mutex to protect access to the queue.
+  mutable asio::detail::mutex mutex_;
+
+  // Whether the queue has been shut down.
+  bool shutdown_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
+#endif // ASIO_DETAIL_THREAD_TIMER_QUEUE_HPP
@@ -48,10 +48,25 @@ public:
   public:
     per_timer_data() :
       heap_index_((std::numeric_limits<std::size_t>::max)()),
-      next_(0), prev_(0)
+      next_(0), prev_(0), period_(), periodic_(false)
     {
     }
 
+    // Whether the timer is rearmed at the specified period.
+    bool has_period(const duration_type& period) const
+    {
+      return periodic_ && period_ == period;
+    }
+
+    // Make the timer periodic. Once a periodic timer fires, it stays in the
+    // heap one period later so that the next wait need not insert it again.
+    // Must not be called while the timer is in a queue.
+    void set_period(const duration_type& period)
+    {
+      period_ = period;
+      periodic_ = true;
+    }
+
   private:
     friend class timer_queue;
 
@@ -64,6 +79,12 @@ public:
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
+
+    // The interval at which a periodic timer is rearmed.
+    duration_type period_;
+
+    // Whether the timer is rearmed after it fires.
+    bool periodic_;
   };
 
   // Constructor.
@@ -103,6 +124,13 @@ public:
         timers_->prev_ = &timer;
       timers_ = &timer;
     }
+    else if (timer.op_queue_.empty() && timer.heap_index_ < heap_.size())
+    {
+      // A periodic timer that was left in the heap when it last fired is moved
+      // to the new time in place.
+      heap_[timer.heap_index_].time_ = time;
+      adjust_heap(timer.heap_index_);
+    }
 
     // Enqueue the individual timer operation.
     timer.op_queue_.push(op);
@@ -150,13 +178,22 @@ public:
       while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+        bool rearm = timer->periodic_ && !timer->op_queue_.empty();
         while (wait_op* op = timer->op_queue_.front())
         {
           timer->op_queue_.pop();
           op->ec_ = asio::error_code();
           ops.push(op);
         }
-        remove_timer(*timer);
+        if (rearm)
+        {
+          // Keep the timer in the heap at its next tick. If it is not waited
+          // on again before then, it is removed when that tick passes.
+          heap_[0].time_ = Time_Traits::add(heap_[0].time_, timer->period_);
+          down_heap(0);
+        }
+        else
+          remove_timer(*timer);
       }
     }
   }
@@ -176,6 +213,12 @@ public:
     heap_.clear();
   }
 
+  // Reserve space for the specified number of timers.
+  virtual void reserve(std::size_t n)
+  {
+    heap_.reserve(n);
+  }
+
   // Cancel and dequeue operations for the given timer.
   std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
@@ -242,6 +285,10 @@ public:
     target.prev_ = source.prev_;
     source.next_ = 0;
     source.prev_ = 0;
+
+    target.period_ = source.period_;
+    target.periodic_ = source.periodic_;
+    source.periodic_ = false;
   }
 
 private:
@@ -276,6 +323,17 @@ private:
     }
   }
 
+  // Move the item at the given index up or down the heap to its correct
+  // position after its time has changed.
+  void adjust_heap(std::size_t index)
+  {
+    if (index > 0 && Time_Traits::less_than(
+          heap_[index].time_, heap_[(index - 1) / 2].time_))
+      up_heap(index);
+    else
+      down_heap(index);
+  }
+
   // Swap two entries in the heap.
   void swap_heap(std::size_t index1, std::size_t index2)
   {
@@ -303,11 +361,7 @@ private:
         swap_heap(index, heap_.size() - 1);
         timer.heap_index_ = (std::numeric_limits<std::size_t>::max)();
         heap_.pop_back();
-        if (index > 0 && Time_Traits::less_than(
-              heap_[index].time_, heap_[(index - 1) / 2].time_))
-          up_heap(index);
-        else
-          down_heap(index);
+        adjust_heap(index);
       }
     }
 
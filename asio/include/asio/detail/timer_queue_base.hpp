@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
@@ -50,6 +51,9 @@ public:
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
+  // Reserve space for the specified number of timers.
+  virtual void reserve(std::size_t n) = 0;
+
 private:
   friend class timer_queue_set;
 
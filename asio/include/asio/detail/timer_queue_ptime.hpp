@@ -72,6 +72,9 @@ public:
   // Dequeue all timers.
   ASIO_DECL virtual void get_all_timers(op_queue<operation>& ops);
 
+  // Reserve space for the specified number of timers.
+  ASIO_DECL virtual void reserve(std::size_t n);
+
   // Cancel and dequeue operations for the given timer.
   ASIO_DECL std::size_t cancel_timer(
       per_timer_data& timer, op_queue<operation>& ops,
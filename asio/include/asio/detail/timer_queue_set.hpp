@@ -50,8 +50,13 @@ public:
   // Dequeue all timers.
   ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
+  // Reserve space for the specified number of timers in each queue, including
+  // queues inserted later.
+  ASIO_DECL void reserve(std::size_t n);
+
 private:
   timer_queue_base* first_;
+  std::size_t reserved_;
 };
 
 } // namespace detail
@@ -77,6 +77,8 @@ using std::is_convertible;
 
 using std::is_copy_constructible;
 
+using std::is_default_constructible;
+
 using std::is_destructible;
 
 using std::is_function;
@@ -85,6 +87,8 @@ using std::is_move_constructible;
 
 using std::is_nothrow_copy_constructible;
 
+using std::is_nothrow_move_constructible;
+
 using std::is_nothrow_destructible;
 
 using std::is_object;
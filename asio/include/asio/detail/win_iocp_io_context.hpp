@@ -74,6 +74,14 @@ public:
   // Run until timeout, interrupted, or one operation is performed.
   ASIO_DECL size_t wait_one(long usec, asio::error_code& ec);
 
+  // Run operations on the calling thread until the given flag is set by a
+  // call to notify_complete(), whether or not the io_context is stopped.
+  ASIO_DECL size_t run_until_complete(
+      const bool& complete, asio::error_code& ec);
+
+  // Set a flag on which a thread may be waiting in run_until_complete().
+  ASIO_DECL void notify_complete(bool& complete);
+
   // Poll for operations without blocking.
   ASIO_DECL size_t poll(asio::error_code& ec);
 
@@ -175,6 +183,15 @@ public:
   ASIO_DECL void on_completion(win_iocp_operation* op,
       const asio::error_code& ec, DWORD bytes_transferred = 0);
 
+  // Pre-allocate state for descriptors. There is no per-descriptor state to
+  // allocate.
+  void reserve_descriptors(std::size_t)
+  {
+  }
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the service.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -233,6 +250,10 @@ private:
   // Helper to calculate the GetQueuedCompletionStatus timeout.
   ASIO_DECL static DWORD get_gqcs_timeout();
 
+  // Determine whether other work is waiting to be run. The depth of the
+  // completion port's queue cannot be observed, so this is always true.
+  ASIO_DECL bool has_waiting_work();
+
   // Helper function to add a new timer queue.
   ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -286,6 +307,10 @@ private:
     // Maximum waitable timer timeout, in microseconds.
     max_timeout_usec = max_timeout_msec * 1000,
 
+    // Interval at which a thread in run_until_complete() checks whether the
+    // operation has been completed by another thread, in milliseconds.
+    completion_wait_msec = 10,
+
     // Completion key value used to wake up a thread to dispatch timers or
     // completed operations.
     wake_for_dispatch = 1,
@@ -64,6 +64,15 @@ public:
   // Initialise the task. No effect as this class uses its own thread.
   ASIO_DECL void init_task();
 
+  // Pre-allocate state for descriptors. There is no per-descriptor state to
+  // allocate.
+  void reserve_descriptors(std::size_t)
+  {
+  }
+
+  // Reserve space for the specified number of timers in each timer queue.
+  ASIO_DECL void reserve_timers(std::size_t n);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& queue);
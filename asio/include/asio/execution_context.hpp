@@ -19,7 +19,9 @@
 #include <cstddef>
 #include <stdexcept>
 #include <typeinfo>
+#include "asio/detail/limits.hpp"
 #include "asio/detail/noncopyable.hpp"
+#include "asio/memory_resource.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -112,9 +114,23 @@ public:
   /// Constructor.
   ASIO_DECL execution_context();
 
+  /// Construct with a memory resource for internal allocations.
+  /**
+   * @param r The memory resource used to allocate the context's services and
+   * other long-lived internal objects. The resource must outlive the
+   * execution_context and all I/O objects associated with it.
+   */
+  ASIO_DECL explicit execution_context(memory_resource& r);
+
   /// Destructor.
   ASIO_DECL ~execution_context();
 
+  /// Get the memory resource used for internal allocations.
+  memory_resource& get_memory_resource() const noexcept
+  {
+    return *memory_resource_;
+  }
+
 protected:
   /// Shuts down all services in the context.
   /**
@@ -192,6 +208,76 @@ public:
    */
   ASIO_DECL void notify_fork(fork_event event);
 
+  /// Describes the memory that an execution_context holds for reuse.
+  struct memory_usage
+  {
+    /// Construct with all counters set to zero.
+    memory_usage() noexcept
+      : thread_cache_bytes(0),
+        object_pool_bytes(0)
+    {
+    }
+
+    /// Bytes held by the recycling allocator caches of threads that are
+    /// running the context.
+    std::size_t thread_cache_bytes;
+
+    /// Bytes held in object pool free lists, such as the per-descriptor state
+    /// of a reactor.
+    std::size_t object_pool_bytes;
+  };
+
+  /// Soft limits on the memory that an execution_context holds for reuse.
+  struct memory_limits
+  {
+    /// Construct with no limits.
+    memory_limits() noexcept
+      : thread_cache_bytes((std::numeric_limits<std::size_t>::max)()),
+        thread_cache_depth(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+    {
+    }
+
+    /// The maximum number of bytes that each thread running the context holds
+    /// in its recycling allocator cache.
+    std::size_t thread_cache_bytes;
+
+    /// The maximum number of blocks of each size that each thread running the
+    /// context holds in its recycling allocator cache. Defaults to the value
+    /// of the @c ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE macro.
+    std::size_t thread_cache_depth;
+  };
+
+  /// Get the memory that the context and its services hold for reuse.
+  /**
+   * This function is thread-safe. The cache of a thread that is running the
+   * context is reported as at the thread's last visit to the context's queue.
+   */
+  ASIO_DECL memory_usage get_memory_usage() const;
+
+  /// Release memory that the context and its services hold for reuse.
+  /**
+   * This function is thread-safe. Memory held by the context's services is
+   * released immediately. Threads that are running the context are woken, and
+   * release their caches before running any further handlers. The cache that
+   * threads use to exchange recycled memory is not affected; use
+   * trim_shared_memory() to release it.
+   *
+   * @note For each service object @c svc in the execution_context set,
+   * performs <tt>svc->trim_memory();</tt>.
+   */
+  ASIO_DECL void trim_memory();
+
+  /// Get the soft limits on memory held for reuse.
+  ASIO_DECL memory_limits get_memory_limits() const;
+
+  /// Set the soft limits on memory held for reuse.
+  /**
+   * This function is thread-safe. Setting the limits also releases memory, as
+   * if by calling trim_memory(). Thereafter, memory that would take a cache
+   * over its limit is returned to the heap rather than cached.
+   */
+  ASIO_DECL void set_memory_limits(const memory_limits& limits);
+
   /// Obtain the service object corresponding to the given type.
   /**
    * This function is used to locate a service object that corresponds to the
@@ -274,6 +360,9 @@ public:
   friend bool has_service(execution_context& e);
 
 private:
+  // The memory resource used for internal allocations.
+  memory_resource* memory_resource_;
+
   // The service registry.
   asio::detail::service_registry* service_registry_;
 };
@@ -318,6 +407,31 @@ private:
   ASIO_DECL virtual void notify_fork(
       execution_context::fork_event event);
 
+  /// Add the memory that the service holds for reuse to the usage counters.
+  /**
+   * This function is not a pure virtual so that services only have to
+   * implement it if necessary. The default implementation does nothing.
+   */
+  ASIO_DECL virtual void add_memory_usage(
+      execution_context::memory_usage& usage) const;
+
+  /// Release memory that the service holds for reuse.
+  /**
+   * This function is not a pure virtual so that services only have to
+   * implement it if necessary. The default implementation does nothing.
+   */
+  ASIO_DECL virtual void trim_memory();
+
+  /// Apply new soft limits on memory held for reuse, releasing memory as if by
+  /// trim_memory().
+  /**
+   * This function is not a pure virtual so that services only have to
+   * implement it if necessary. The default implementation calls
+   * trim_memory().
+   */
+  ASIO_DECL virtual void set_memory_limits(
+      const execution_context::memory_limits& limits);
+
   friend class asio::detail::service_registry;
   struct key
   {
@@ -328,6 +442,10 @@ private:
 
   execution_context& owner_;
   service* next_;
+
+  // Destroys the service if it was allocated from the owner's memory
+  // resource. Null if the service was allocated using new.
+  void (*destroy_)(service*);
 };
 
 /// Exception thrown when trying to add a duplicate service to an
@@ -348,6 +466,24 @@ public:
   ASIO_DECL invalid_service_owner();
 };
 
+/// Get the approximate number of bytes held in the cache that threads use to
+/// exchange recycled memory.
+/**
+ * This cache is shared by all execution contexts in the process, and so is not
+ * included in the memory usage reported by any one context.
+ *
+ * This function is thread-safe.
+ */
+ASIO_DECL std::size_t get_shared_memory_usage();
+
+/// Release the memory held in the cache that threads use to exchange recycled
+/// memory.
+/**
+ * This cache is shared by all execution contexts in the process. This function
+ * is thread-safe.
+ */
+ASIO_DECL void trim_shared_memory();
+
 namespace detail {
 
 // Special derived service id type to keep classes header-file only.
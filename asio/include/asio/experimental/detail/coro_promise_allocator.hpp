@@ -13,6 +13,8 @@
 #define ASIO_EXPERIMENTAL_DETAIL_CORO_PROMISE_ALLOCATOR_HPP
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/experimental/coro_traits.hpp"
 
 namespace asio {
@@ -123,6 +125,20 @@ struct coro_promise_allocator<std::allocator<void>>
 {
   using allocator_type = std::allocator<void>;
 
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  void* operator new(const std::size_t size)
+  {
+    return asio::detail::thread_info_base::allocate_frame(
+        asio::detail::thread_context::top_of_thread_call_stack(), size);
+  }
+
+  void operator delete(void* raw, const std::size_t size)
+  {
+    asio::detail::thread_info_base::deallocate_frame(
+        asio::detail::thread_context::top_of_thread_call_stack(), raw, size);
+  }
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
   template <typename... Args>
   coro_promise_allocator(Args&&...)
   {
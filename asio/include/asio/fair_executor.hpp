@@ -0,0 +1,500 @@
+//
+// fair_executor.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_FAIR_EXECUTOR_HPP
+#define ASIO_FAIR_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/fair_executor_service.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Provides a separately queued share of an executor.
+/**
+ * A fair executor keeps its own queue of submitted functions, and takes only
+ * a bounded share of the underlying executor. It occupies at most @c
+ * concurrency places in the underlying executor's queue, whatever the length
+ * of its own queue. Each time one of those places reaches the front, the fair
+ * executor runs up to @c weight of its functions, and then goes to the back
+ * of the underlying executor's queue if it has more to run.
+ *
+ * Fair executors that share an underlying executor, such as the executor of
+ * a thread_pool or io_context, are therefore served in round-robin order. A
+ * burst of work submitted through one of them delays the others by at most
+ * one turn, rather than by the whole burst. Functions submitted directly to
+ * the underlying executor each take a turn of their own.
+ *
+ * Copies of a fair executor share the same queue.
+ *
+ * Functions are never run inside a call to execute(). If @c concurrency is
+ * greater than one, functions from the same queue may run concurrently and
+ * in any order.
+ */
+template <typename Executor>
+class fair_executor
+{
+public:
+  /// The type of the underlying executor.
+  typedef Executor inner_executor_type;
+
+  /// Construct a fair executor for the specified executor.
+  /**
+   * @param e The underlying executor.
+   *
+   * @param weight The number of functions run each time the fair executor
+   * reaches the front of the underlying executor's queue. A value of zero is
+   * treated as one.
+   *
+   * @param concurrency The maximum number of places that the fair executor
+   * occupies in the underlying executor's queue, and so the maximum number of
+   * its functions that run at the same time. A value of zero is treated as
+   * one.
+   */
+  template <typename Executor1>
+  explicit fair_executor(const Executor1& e,
+      std::size_t weight = 1, std::size_t concurrency = 1,
+      constraint_t<
+        conditional_t<
+          !is_same<Executor1, fair_executor>::value,
+          is_convertible<Executor1, Executor>,
+          false_type
+        >::value
+      > = 0)
+    : executor_(e),
+      impl_(fair_executor::create_implementation(
+            executor_, weight, concurrency))
+  {
+  }
+
+  /// Copy constructor.
+  fair_executor(const fair_executor& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Converting constructor.
+  /**
+   * This constructor is only valid if the @c OtherExecutor type is convertible
+   * to @c Executor.
+   */
+  template <class OtherExecutor>
+  fair_executor(
+      const fair_executor<OtherExecutor>& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Assignment operator.
+  fair_executor& operator=(const fair_executor& other) noexcept
+  {
+    executor_ = other.executor_;
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Converting assignment operator.
+  /**
+   * This assignment operator is only valid if the @c OtherExecutor type is
+   * convertible to @c Executor.
+   */
+  template <class OtherExecutor>
+  fair_executor& operator=(
+      const fair_executor<OtherExecutor>& other) noexcept
+  {
+    executor_ = other.executor_;
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Move constructor.
+  fair_executor(fair_executor&& other) noexcept
+    : executor_(static_cast<Executor&&>(other.executor_)),
+      impl_(static_cast<implementation_type&&>(other.impl_))
+  {
+  }
+
+  /// Converting move constructor.
+  /**
+   * This constructor is only valid if the @c OtherExecutor type is convertible
+   * to @c Executor.
+   */
+  template <class OtherExecutor>
+  fair_executor(fair_executor<OtherExecutor>&& other) noexcept
+    : executor_(static_cast<OtherExecutor&&>(other.executor_)),
+      impl_(static_cast<implementation_type&&>(other.impl_))
+  {
+  }
+
+  /// Move assignment operator.
+  fair_executor& operator=(fair_executor&& other) noexcept
+  {
+    executor_ = static_cast<Executor&&>(other.executor_);
+    impl_ = static_cast<implementation_type&&>(other.impl_);
+    return *this;
+  }
+
+  /// Converting move assignment operator.
+  /**
+   * This assignment operator is only valid if the @c OtherExecutor type is
+   * convertible to @c Executor.
+   */
+  template <class OtherExecutor>
+  fair_executor& operator=(fair_executor<OtherExecutor>&& other) noexcept
+  {
+    executor_ = static_cast<OtherExecutor&&>(other.executor_);
+    impl_ = static_cast<implementation_type&&>(other.impl_);
+    return *this;
+  }
+
+  /// Destructor.
+  ~fair_executor() noexcept
+  {
+  }
+
+  /// Obtain the underlying executor.
+  inner_executor_type get_inner_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  /// Forward a query to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point. A query for the @c blocking property
+   * always returns @c blocking.never.
+   *
+   * For example:
+   * @code asio::fair_executor<my_executor_type> ex = ...;
+   * if (asio::query(ex, asio::execution::blocking)
+   *       == asio::execution::blocking.never)
+   *   ... @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_query<const Executor&, Property>::value,
+    conditional_t<
+      is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t,
+      query_result_t<const Executor&, Property>
+    >
+  > query(const Property& p) const
+    noexcept(is_nothrow_query<const Executor&, Property>::value)
+  {
+    return this->query_helper(
+        is_convertible<Property, execution::blocking_t>(), p);
+  }
+
+  /// Forward a requirement to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * For example:
+   * @code asio::fair_executor<my_executor_type> ex1 = ...;
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::blocking.never); @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_require<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    fair_executor<decay_t<require_result_t<const Executor&, Property>>>
+  > require(const Property& p) const
+    noexcept(is_nothrow_require<const Executor&, Property>::value)
+  {
+    return fair_executor<decay_t<require_result_t<const Executor&, Property>>>(
+        asio::require(executor_, p), impl_);
+  }
+
+  /// Forward a preference to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::prefer customisation point.
+   *
+   * For example:
+   * @code asio::fair_executor<my_executor_type> ex1 = ...;
+   * auto ex2 = asio::prefer(ex1,
+   *     asio::execution::outstanding_work.tracked); @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_prefer<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    fair_executor<decay_t<prefer_result_t<const Executor&, Property>>>
+  > prefer(const Property& p) const
+    noexcept(is_nothrow_prefer<const Executor&, Property>::value)
+  {
+    return fair_executor<decay_t<prefer_result_t<const Executor&, Property>>>(
+        asio::prefer(executor_, p), impl_);
+  }
+
+  /// Request the fair executor to invoke the given function object.
+  /**
+   * This function is used to ask the fair executor to execute the given
+   * function object on its underlying executor. The function object is added
+   * to the fair executor's queue, and is never executed inside this function.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   */
+  template <typename Function>
+  constraint_t<
+    traits::execute_member<const Executor&, Function>::is_valid,
+    void
+  > execute(Function&& f) const
+  {
+    detail::fair_executor_service::execute(impl_,
+        executor_, static_cast<Function&&>(f));
+  }
+
+  /// Determine whether the fair executor is running in the current thread.
+  /**
+   * @return @c true if the current thread is executing a function that was
+   * submitted to the fair executor, or to one of its copies. Otherwise returns
+   * @c false.
+   */
+  bool running_in_this_thread() const noexcept
+  {
+    return detail::fair_executor_service::running_in_this_thread(impl_);
+  }
+
+  /// Get the number of functions run each time the fair executor is scheduled.
+  std::size_t weight() const noexcept
+  {
+    return detail::fair_executor_service::get_weight(impl_);
+  }
+
+  /// Get the maximum number of the fair executor's functions that may run at
+  /// the same time.
+  std::size_t concurrency() const noexcept
+  {
+    return detail::fair_executor_service::get_concurrency(impl_);
+  }
+
+  /// Compare two fair executors for equality.
+  /**
+   * Two fair executors are equal if they share the same queue.
+   */
+  friend bool operator==(const fair_executor& a,
+      const fair_executor& b) noexcept
+  {
+    return a.impl_ == b.impl_;
+  }
+
+  /// Compare two fair executors for inequality.
+  /**
+   * Two fair executors are equal if they share the same queue.
+   */
+  friend bool operator!=(const fair_executor& a,
+      const fair_executor& b) noexcept
+  {
+    return a.impl_ != b.impl_;
+  }
+
+#if defined(GENERATING_DOCUMENTATION)
+private:
+#endif // defined(GENERATING_DOCUMENTATION)
+  typedef detail::fair_executor_service::implementation_type
+    implementation_type;
+
+  template <typename InnerExecutor>
+  static implementation_type create_implementation(const InnerExecutor& ex,
+      std::size_t weight, std::size_t concurrency)
+  {
+    return use_service<detail::fair_executor_service>(
+        asio::query(ex, execution::context)).create_implementation(
+          weight, concurrency);
+  }
+
+  fair_executor(const Executor& ex, const implementation_type& impl)
+    : executor_(ex),
+      impl_(impl)
+  {
+  }
+
+  template <typename Property>
+  query_result_t<const Executor&, Property> query_helper(
+      false_type, const Property& property) const
+  {
+    return asio::query(executor_, property);
+  }
+
+  template <typename Property>
+  execution::blocking_t query_helper(true_type, const Property&) const
+  {
+    return execution::blocking.never;
+  }
+
+  Executor executor_;
+  implementation_type impl_;
+};
+
+/** @defgroup make_fair_executor asio::make_fair_executor
+ *
+ * @brief The asio::make_fair_executor function creates a @ref fair_executor
+ * object for an executor or execution context.
+ */
+/*@{*/
+
+/// Create a @ref fair_executor object for an executor.
+/**
+ * @param ex An executor.
+ *
+ * @param weight The number of functions run each time the fair executor
+ * reaches the front of the underlying executor's queue.
+ *
+ * @param concurrency The maximum number of the fair executor's functions that
+ * run at the same time.
+ *
+ * @returns A fair executor constructed with the specified executor.
+ */
+template <typename Executor>
+inline fair_executor<Executor> make_fair_executor(const Executor& ex,
+    std::size_t weight = 1, std::size_t concurrency = 1,
+    constraint_t<
+      execution::is_executor<Executor>::value
+    > = 0)
+{
+  return fair_executor<Executor>(ex, weight, concurrency);
+}
+
+/// Create a @ref fair_executor object for an execution context.
+/**
+ * @param ctx An execution context, from which an executor will be obtained.
+ *
+ * @param weight The number of functions run each time the fair executor
+ * reaches the front of the underlying executor's queue.
+ *
+ * @param concurrency The maximum number of the fair executor's functions that
+ * run at the same time.
+ *
+ * @returns A fair executor constructed with the execution context's executor,
+ * obtained by performing <tt>ctx.get_executor()</tt>.
+ */
+template <typename ExecutionContext>
+inline fair_executor<typename ExecutionContext::executor_type>
+make_fair_executor(ExecutionContext& ctx,
+    std::size_t weight = 1, std::size_t concurrency = 1,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+{
+  return fair_executor<typename ExecutionContext::executor_type>(
+      ctx.get_executor(), weight, concurrency);
+}
+
+/*@}*/
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+template <typename Executor>
+struct equality_comparable<fair_executor<Executor>>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+template <typename Executor, typename Function>
+struct execute_member<fair_executor<Executor>, Function,
+    enable_if_t<
+      traits::execute_member<const Executor&, Function>::is_valid
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef void result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct query_member<fair_executor<Executor>, Property,
+    enable_if_t<
+      can_query<const Executor&, Property>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<Executor, Property>::value;
+  typedef conditional_t<
+    is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t, query_result_t<Executor, Property>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct require_member<fair_executor<Executor>, Property,
+    enable_if_t<
+      can_require<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_require<Executor, Property>::value;
+  typedef fair_executor<decay_t<require_result_t<Executor, Property>>>
+    result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct prefer_member<fair_executor<Executor>, Property,
+    enable_if_t<
+      can_prefer<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_prefer<Executor, Property>::value;
+  typedef fair_executor<decay_t<prefer_result_t<Executor, Property>>>
+    result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+} // namespace traits
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_FAIR_EXECUTOR_HPP
@@ -0,0 +1,278 @@
+//
+// handler_arena.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_HANDLER_ARENA_HPP
+#define ASIO_HANDLER_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#if defined(ASIO_HAS_THREADS)
+# include <atomic>
+#endif // defined(ASIO_HAS_THREADS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A fixed set of memory slabs that are recycled between asynchronous
+/// operations.
+/**
+ * The handler_arena class owns a small, fixed number of equally sized slabs.
+ * Allocations that fit within a slab are served from a free slab, and the slab
+ * becomes available again as soon as it is deallocated. Allocations that are
+ * too large, or that occur while all slabs are in use, fall back to the same
+ * thread-local recycling strategy used by asio::recycling_allocator.
+ *
+ * An arena is typically associated with all of the I/O objects belonging to a
+ * single connection. The I/O objects are given an executor that carries the
+ * arena as the value of its asio::execution::allocator property. The
+ * operations started on those objects then use the arena by default, so that
+ * a connection in a steady state performs no heap allocation. I/O objects with
+ * other executors, such as asio::any_io_executor, are unaffected.
+ *
+ * @par Example
+ * @code
+ * asio::handler_arena arena;
+ * auto ex = asio::require(my_io_context.get_executor(),
+ *     asio::execution::allocator(asio::arena_allocator<void>(arena)));
+ * asio::ip::tcp::socket::rebind_executor<decltype(ex)>::other socket(ex);
+ * @endcode
+ *
+ * The arena must outlive all operations that use it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class handler_arena
+  : private noncopyable
+{
+public:
+  /// The maximum number of slabs that an arena may own.
+  static constexpr std::size_t max_slabs = 64;
+
+  /// Constructor.
+  /**
+   * @param slab_size The size of each slab, in bytes. This is rounded up to a
+   * multiple of the default alignment.
+   *
+   * @param slab_count The number of slabs. At most @c max_slabs slabs are
+   * created.
+   */
+  ASIO_DECL explicit handler_arena(
+      std::size_t slab_size = 512, std::size_t slab_count = 8);
+
+  /// Destructor.
+  ASIO_DECL ~handler_arena();
+
+  /// Get the size of each slab.
+  std::size_t slab_size() const noexcept
+  {
+    return slab_size_;
+  }
+
+  /// Get the number of slabs.
+  std::size_t slab_count() const noexcept
+  {
+    return slab_count_;
+  }
+
+  /// Get the number of slabs that are not currently in use.
+  ASIO_DECL std::size_t slabs_available() const noexcept;
+
+  /// Allocate a block of memory.
+  ASIO_DECL void* allocate(std::size_t size,
+      std::size_t align = ASIO_DEFAULT_ALIGN);
+
+  /// Deallocate a block of memory previously obtained from allocate().
+  ASIO_DECL void deallocate(void* pointer, std::size_t size);
+
+private:
+  // The storage for all slabs.
+  unsigned char* storage_;
+
+  // The size of each slab.
+  std::size_t slab_size_;
+
+  // The number of slabs.
+  std::size_t slab_count_;
+
+  // A bit mask of the slabs that are not in use.
+#if defined(ASIO_HAS_THREADS)
+  std::atomic<unsigned long long> free_slabs_;
+#else // defined(ASIO_HAS_THREADS)
+  unsigned long long free_slabs_;
+#endif // defined(ASIO_HAS_THREADS)
+};
+
+/// An allocator that obtains memory from a handler_arena.
+/**
+ * A default constructed arena_allocator does not refer to an arena, and
+ * allocates memory in the same way as asio::recycling_allocator.
+ */
+template <typename T>
+class arena_allocator
+{
+public:
+  /// The type of object allocated by the arena allocator.
+  typedef T value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef arena_allocator<U> other;
+  };
+
+  /// Default constructor.
+  constexpr arena_allocator() noexcept
+    : arena_(0)
+  {
+  }
+
+  /// Construct an allocator that uses the specified arena.
+  explicit arena_allocator(handler_arena& a) noexcept
+    : arena_(&a)
+  {
+  }
+
+  /// Construct an allocator that uses the specified arena, if any.
+  explicit arena_allocator(handler_arena* a) noexcept
+    : arena_(a)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  constexpr arena_allocator(const arena_allocator<U>& other) noexcept
+    : arena_(other.arena())
+  {
+  }
+
+  /// Get the arena used by the allocator, if any.
+  constexpr handler_arena* arena() const noexcept
+  {
+    return arena_;
+  }
+
+  /// Equality operator.
+  constexpr bool operator==(const arena_allocator& other) const noexcept
+  {
+    return arena_ == other.arena_;
+  }
+
+  /// Inequality operator.
+  constexpr bool operator!=(const arena_allocator& other) const noexcept
+  {
+    return arena_ != other.arena_;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    void* p = arena_
+      ? arena_->allocate(sizeof(T) * n, alignof(T))
+      : detail::default_allocate(sizeof(T) * n, alignof(T));
+    return static_cast<T*>(p);
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    if (arena_)
+      arena_->deallocate(p, sizeof(T) * n);
+    else
+      detail::default_deallocate(p, sizeof(T) * n);
+  }
+
+private:
+  handler_arena* arena_;
+};
+
+/// A proto-allocator that obtains memory from a handler_arena.
+template <>
+class arena_allocator<void>
+{
+public:
+  /// No values are allocated by a proto-allocator.
+  typedef void value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef arena_allocator<U> other;
+  };
+
+  /// Default constructor.
+  constexpr arena_allocator() noexcept
+    : arena_(0)
+  {
+  }
+
+  /// Construct an allocator that uses the specified arena.
+  explicit arena_allocator(handler_arena& a) noexcept
+    : arena_(&a)
+  {
+  }
+
+  /// Construct an allocator that uses the specified arena, if any.
+  explicit arena_allocator(handler_arena* a) noexcept
+    : arena_(a)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  constexpr arena_allocator(const arena_allocator<U>& other) noexcept
+    : arena_(other.arena())
+  {
+  }
+
+  /// Get the arena used by the allocator, if any.
+  constexpr handler_arena* arena() const noexcept
+  {
+    return arena_;
+  }
+
+  /// Equality operator.
+  constexpr bool operator==(const arena_allocator& other) const noexcept
+  {
+    return arena_ == other.arena_;
+  }
+
+  /// Inequality operator.
+  constexpr bool operator!=(const arena_allocator& other) const noexcept
+  {
+    return arena_ != other.arena_;
+  }
+
+private:
+  handler_arena* arena_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/handler_arena.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_HANDLER_ARENA_HPP
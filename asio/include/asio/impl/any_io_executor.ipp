@@ -20,6 +20,7 @@
 #if !defined(ASIO_USE_TS_EXECUTOR_AS_DEFAULT)
 
 #include "asio/any_io_executor.hpp"
+#include "asio/io_context.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -83,6 +84,19 @@ void any_io_executor::swap(any_io_executor& other) noexcept
   static_cast<base_type&>(*this).swap(static_cast<base_type&>(other));
 }
 
+void any_io_executor::execute_function(function&& f) const
+{
+  typedef io_context::basic_executor_type<std::allocator<void>,
+      detail::io_context_bits::outstanding_work_tracked>
+    tracked_io_context_executor;
+
+  if (const tracked_io_context_executor* ex
+      = fast_target<tracked_io_context_executor>())
+    ex->execute(static_cast<function&&>(f));
+  else
+    target_fns_->execute(*this, static_cast<function&&>(f));
+}
+
 template <>
 any_io_executor any_io_executor::require(
     const execution::blocking_t::never_t& p, int) const
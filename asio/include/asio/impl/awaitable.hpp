@@ -21,6 +21,7 @@
 #include <tuple>
 #include "asio/cancellation_signal.hpp"
 #include "asio/cancellation_state.hpp"
+#include "asio/defer.hpp"
 #include "asio/detail/thread_context.hpp"
 #include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -88,16 +89,13 @@ public:
 #if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
   void* operator new(std::size_t size)
   {
-    return asio::detail::thread_info_base::allocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
-        asio::detail::thread_context::top_of_thread_call_stack(),
-        size);
+    return asio::detail::thread_info_base::allocate_frame(
+        asio::detail::thread_context::top_of_thread_call_stack(), size);
   }
 
   void operator delete(void* pointer, std::size_t size)
   {
-    asio::detail::thread_info_base::deallocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
+    asio::detail::thread_info_base::deallocate_frame(
         asio::detail::thread_context::top_of_thread_call_stack(),
         pointer, size);
   }
@@ -224,6 +222,42 @@ public:
     return result{this};
   }
 
+  // This await transformation resumes the thread of execution through its
+  // executor, as a continuation, only if the current handler has run for
+  // long enough while other work is waiting.
+  auto await_transform(this_coro::yield_if_needed_t) noexcept
+  {
+    struct result
+    {
+      typedef awaitable_async_op_handler<void(), Executor> handler_type;
+
+      awaitable_frame_base* this_;
+      typename handler_type::result_type result_;
+
+      bool await_ready() const noexcept
+      {
+        return !thread_context::this_thread_should_yield(
+            ASIO_HANDLER_YIELD_USEC);
+      }
+
+      void await_suspend(coroutine_handle<void>) noexcept
+      {
+        this_->after_suspend(
+            [](void* arg)
+            {
+              result* r = static_cast<result*>(arg);
+              (defer)(handler_type(r->this_->detach_thread(), r->result_));
+            }, this);
+      }
+
+      void await_resume() const noexcept
+      {
+      }
+    };
+
+    return result{this, {}};
+  }
+
   // This await transformation obtains the associated cancellation state of the
   // thread of execution.
   auto await_transform(this_coro::cancellation_state_t) noexcept
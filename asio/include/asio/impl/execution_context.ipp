@@ -18,13 +18,21 @@
 #include "asio/detail/config.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/detail/service_registry.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 
 execution_context::execution_context()
-  : service_registry_(new asio::detail::service_registry(*this))
+  : memory_resource_(get_default_memory_resource()),
+    service_registry_(new asio::detail::service_registry(*this))
+{
+}
+
+execution_context::execution_context(memory_resource& r)
+  : memory_resource_(&r),
+    service_registry_(new asio::detail::service_registry(*this))
 {
 }
 
@@ -51,9 +59,32 @@ void execution_context::notify_fork(
   service_registry_->notify_fork(event);
 }
 
+execution_context::memory_usage execution_context::get_memory_usage() const
+{
+  memory_usage usage;
+  service_registry_->add_memory_usage(usage);
+  return usage;
+}
+
+void execution_context::trim_memory()
+{
+  service_registry_->trim_memory();
+}
+
+execution_context::memory_limits execution_context::get_memory_limits() const
+{
+  return service_registry_->get_memory_limits();
+}
+
+void execution_context::set_memory_limits(const memory_limits& limits)
+{
+  service_registry_->set_memory_limits(limits);
+}
+
 execution_context::service::service(execution_context& owner)
   : owner_(owner),
-    next_(0)
+    next_(0),
+    destroy_(0)
 {
 }
 
@@ -65,6 +96,31 @@ void execution_context::service::notify_fork(execution_context::fork_event)
 {
 }
 
+void execution_context::service::add_memory_usage(
+    execution_context::memory_usage&) const
+{
+}
+
+void execution_context::service::trim_memory()
+{
+}
+
+void execution_context::service::set_memory_limits(
+    const execution_context::memory_limits&)
+{
+  trim_memory();
+}
+
+std::size_t get_shared_memory_usage()
+{
+  return detail::thread_info_base::shared_cached_bytes();
+}
+
+void trim_shared_memory()
+{
+  detail::thread_info_base::trim_shared();
+}
+
 service_already_exists::service_already_exists()
   : std::logic_error("Service already exists.")
 {
@@ -0,0 +1,120 @@
+//
+// impl/handler_arena.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_HANDLER_ARENA_IPP
+#define ASIO_IMPL_HANDLER_ARENA_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/handler_arena.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+handler_arena::handler_arena(std::size_t slab_size, std::size_t slab_count)
+  : storage_(0),
+    slab_size_((slab_size + ASIO_DEFAULT_ALIGN - 1)
+        / ASIO_DEFAULT_ALIGN * ASIO_DEFAULT_ALIGN),
+    slab_count_(slab_count < max_slabs
+        ? slab_count : static_cast<std::size_t>(max_slabs)),
+    free_slabs_(0)
+{
+  if (slab_size_ > 0 && slab_count_ > 0)
+  {
+    storage_ = static_cast<unsigned char*>(
+        aligned_new(ASIO_DEFAULT_ALIGN, slab_size_ * slab_count_));
+    free_slabs_ = (slab_count_ == max_slabs)
+      ? ~0ULL : (1ULL << slab_count_) - 1;
+  }
+}
+
+handler_arena::~handler_arena()
+{
+  if (storage_)
+    aligned_delete(storage_);
+}
+
+std::size_t handler_arena::slabs_available() const noexcept
+{
+#if defined(ASIO_HAS_THREADS)
+  unsigned long long free_slabs = free_slabs_.load(std::memory_order_relaxed);
+#else // defined(ASIO_HAS_THREADS)
+  unsigned long long free_slabs = free_slabs_;
+#endif // defined(ASIO_HAS_THREADS)
+
+  std::size_t count = 0;
+  for (; free_slabs; free_slabs &= free_slabs - 1)
+    ++count;
+  return count;
+}
+
+void* handler_arena::allocate(std::size_t size, std::size_t align)
+{
+  if (size <= slab_size_ && align <= ASIO_DEFAULT_ALIGN)
+  {
+#if defined(ASIO_HAS_THREADS)
+    unsigned long long free_slabs =
+      free_slabs_.load(std::memory_order_relaxed);
+    while (free_slabs)
+    {
+      unsigned long long slab = free_slabs & (~free_slabs + 1);
+      if (free_slabs_.compare_exchange_weak(free_slabs, free_slabs & ~slab,
+            std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        std::size_t index = 0;
+        while (slab >>= 1)
+          ++index;
+        return storage_ + index * slab_size_;
+      }
+    }
+#else // defined(ASIO_HAS_THREADS)
+    if (free_slabs_)
+    {
+      unsigned long long slab = free_slabs_ & (~free_slabs_ + 1);
+      free_slabs_ &= ~slab;
+      std::size_t index = 0;
+      while (slab >>= 1)
+        ++index;
+      return storage_ + index * slab_size_;
+    }
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  return detail::default_allocate(size, align);
+}
+
+void handler_arena::deallocate(void* pointer, std::size_t size)
+{
+  unsigned char* p = static_cast<unsigned char*>(pointer);
+  if (storage_ && p >= storage_ && p < storage_ + slab_size_ * slab_count_)
+  {
+    unsigned long long slab = 1ULL << ((p - storage_) / slab_size_);
+#if defined(ASIO_HAS_THREADS)
+    free_slabs_.fetch_or(slab, std::memory_order_release);
+#else // defined(ASIO_HAS_THREADS)
+    free_slabs_ |= slab;
+#endif // defined(ASIO_HAS_THREADS)
+  }
+  else
+  {
+    detail::default_deallocate(pointer, size);
+  }
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_HANDLER_ARENA_IPP
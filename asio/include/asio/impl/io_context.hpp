@@ -106,6 +106,60 @@ std::size_t io_context::run_one_until(
   return 0;
 }
 
+template <typename Operation>
+typename detail::run_until_complete_state<io_context::impl_type,
+  completion_signature_of_t<Operation>>::result_type
+io_context::run_until_complete(Operation&& op)
+{
+  detail::run_until_complete_state<impl_type,
+    completion_signature_of_t<Operation>> state(impl_);
+  this->launch_and_run_until_complete(state, static_cast<Operation&&>(op));
+  return state.get_result();
+}
+
+template <typename Operation>
+typename detail::run_until_complete_state<io_context::impl_type,
+  completion_signature_of_t<Operation>>::result_type
+io_context::run_until_complete(Operation&& op, asio::error_code& ec)
+{
+  detail::run_until_complete_state<impl_type,
+    completion_signature_of_t<Operation>> state(impl_);
+  this->launch_and_run_until_complete(state, static_cast<Operation&&>(op));
+  return state.get_result(ec);
+}
+
+template <typename State, typename Operation>
+void io_context::launch_and_run_until_complete(State& state, Operation&& op)
+{
+  static_cast<Operation&&>(op)(
+      detail::run_until_complete_handler<State>(state));
+
+  asio::error_code ec;
+#if !defined(ASIO_NO_EXCEPTIONS)
+  // The completion handler refers to the state, so the wait must not end
+  // before the operation completes. An exception thrown by another handler
+  // is held until then.
+  std::exception_ptr ex;
+  for (;;)
+  {
+    try
+    {
+      impl_.run_until_complete(state.completed(), ec);
+      break;
+    }
+    catch (...)
+    {
+      if (!ex)
+        ex = std::current_exception();
+    }
+  }
+  if (ex)
+    std::rethrow_exception(ex);
+#else // !defined(ASIO_NO_EXCEPTIONS)
+  impl_.run_until_complete(state.completed(), ec);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
 #if !defined(ASIO_NO_DEPRECATED)
 
 inline void io_context::reset()
@@ -19,9 +19,10 @@
 #include "asio/io_context.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/limits.hpp"
-#include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/service_registry.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/timer_scheduler.hpp"
 
 #if defined(ASIO_HAS_IOCP)
 # include "asio/detail/win_iocp_io_context.hpp"
@@ -45,11 +46,29 @@ io_context::io_context(int concurrency_hint)
 {
 }
 
+io_context::io_context(memory_resource& r)
+  : execution_context(r),
+    impl_(add_impl(
+          asio::detail::service_registry::create_service<impl_type>(
+            *this, ASIO_CONCURRENCY_HINT_DEFAULT, false)))
+{
+}
+
+io_context::io_context(int concurrency_hint, memory_resource& r)
+  : execution_context(r),
+    impl_(add_impl(
+          asio::detail::service_registry::create_service<impl_type>(
+            *this, concurrency_hint == 1
+              ? ASIO_CONCURRENCY_HINT_1 : concurrency_hint, false)))
+{
+}
+
 io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
 {
-  asio::detail::scoped_ptr<impl_type> scoped_impl(impl);
-  asio::add_service<impl_type>(*this, scoped_impl.get());
-  return *scoped_impl.release();
+  asio::detail::service_registry::auto_service_ptr scoped_impl = { impl };
+  asio::add_service<impl_type>(*this, impl);
+  scoped_impl.ptr_ = 0;
+  return *impl;
 }
 
 io_context::~io_context()
@@ -132,6 +151,22 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::reserve_descriptors(std::size_t n)
+{
+  // The timer scheduler is also the service that keeps per-descriptor state.
+  asio::use_service<detail::timer_scheduler>(*this).reserve_descriptors(n);
+}
+
+void io_context::reserve_timers(std::size_t n)
+{
+  asio::use_service<detail::timer_scheduler>(*this).reserve_timers(n);
+}
+
+void io_context::reserve_operations(std::size_t n, std::size_t size)
+{
+  detail::thread_info_base::reserve_shared(n, size);
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
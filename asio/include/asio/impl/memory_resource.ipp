@@ -0,0 +1,54 @@
+//
+// impl/memory_resource.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_MEMORY_RESOURCE_IPP
+#define ASIO_IMPL_MEMORY_RESOURCE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/memory_resource.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class new_delete_memory_resource
+  : public memory_resource
+{
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align)
+  {
+    return aligned_new(align, bytes);
+  }
+
+  void do_deallocate(void* p, std::size_t, std::size_t)
+  {
+    aligned_delete(p);
+  }
+};
+
+} // namespace detail
+
+memory_resource* get_default_memory_resource() noexcept
+{
+  static detail::new_delete_memory_resource resource;
+  return &resource;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_MEMORY_RESOURCE_IPP
@@ -0,0 +1,91 @@
+//
+// impl/offload.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_OFFLOAD_HPP
+#define ASIO_IMPL_OFFLOAD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/offload_function_op.hpp"
+#include "asio/detail/offload_service.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/query.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+inline offload_options get_offload_options(execution_context& ctx)
+{
+  return asio::use_service<detail::offload_service>(ctx).get_options();
+}
+
+inline void set_offload_options(execution_context& ctx,
+    const offload_options& options)
+{
+  asio::use_service<detail::offload_service>(ctx).set_options(options);
+}
+
+namespace detail {
+
+template <typename Executor>
+class initiate_async_offload
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_async_offload(const Executor& ex)
+    : ex_(ex)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return ex_;
+  }
+
+  template <typename Handler, typename Function>
+  void operator()(Handler&& handler, Function&& f) const
+  {
+    non_const_lvalue<Handler> handler2(handler);
+    offload_service& service = asio::use_service<offload_service>(
+        asio::query(ex_, execution::context));
+
+    // Allocate and construct an operation to wrap the function and handler.
+    typedef offload_function_op<decay_t<Function>,
+      decay_t<Handler>, Executor> op;
+    typename op::ptr p = { asio::detail::addressof(handler2.value),
+      op::ptr::allocate(handler2.value), 0 };
+    p.p = new (p.v) op(static_cast<Function&&>(f),
+        handler2.value, ex_, service);
+
+    ASIO_HANDLER_CREATION((service.context(), *p.p,
+          "offload", &service, 0, "async_offload"));
+
+    service.start_offload_op(p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  Executor ex_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_OFFLOAD_HPP
@@ -16,12 +16,14 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <algorithm>
+#include "asio/associated_allocator.hpp"
 #include "asio/associator.hpp"
 #include "asio/buffer.hpp"
 #include "asio/detail/array_fwd.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/base_from_completion_cond.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/composed_op_slab.hpp"
 #include "asio/detail/consuming_buffers.hpp"
 #include "asio/detail/dependent_type.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
@@ -324,40 +326,43 @@ namespace detail
       base_from_completion_cond<CompletionCondition>
   {
   public:
+    typedef asio::detail::consuming_buffers<mutable_buffer,
+        MutableBufferSequence, MutableBufferIterator> buffers_type;
+
+    typedef typename composed_op_state<buffers_type,
+        associated_allocator_t<ReadHandler>>::type state_type;
+
+    typedef typename state_type::allocator_type allocator_type;
+
     read_op(AsyncReadStream& stream, const MutableBufferSequence& buffers,
         CompletionCondition& completion_condition, ReadHandler& handler)
       : base_from_cancellation_state<ReadHandler>(
           handler, enable_partial_cancellation()),
         base_from_completion_cond<CompletionCondition>(completion_condition),
         stream_(stream),
-        buffers_(buffers),
+        buffers_((get_associated_allocator)(handler), buffers),
         start_(0),
         handler_(static_cast<ReadHandler&&>(handler))
     {
     }
 
-    read_op(const read_op& other)
-      : base_from_cancellation_state<ReadHandler>(other),
-        base_from_completion_cond<CompletionCondition>(other),
-        stream_(other.stream_),
-        buffers_(other.buffers_),
-        start_(other.start_),
-        handler_(other.handler_)
-    {
-    }
-
     read_op(read_op&& other)
       : base_from_cancellation_state<ReadHandler>(
           static_cast<base_from_cancellation_state<ReadHandler>&&>(other)),
         base_from_completion_cond<CompletionCondition>(
           static_cast<base_from_completion_cond<CompletionCondition>&&>(other)),
         stream_(other.stream_),
-        buffers_(static_cast<buffers_type&&>(other.buffers_)),
+        buffers_(static_cast<state_type&&>(other.buffers_)),
         start_(other.start_),
         handler_(static_cast<ReadHandler&&>(other.handler_))
     {
     }
 
+    allocator_type get_allocator() const noexcept
+    {
+      return buffers_.get_allocator();
+    }
+
     void operator()(asio::error_code ec,
         std::size_t bytes_transferred, int start = 0)
     {
@@ -365,19 +370,19 @@ namespace detail
       switch (start_ = start)
       {
         case 1:
-        max_size = this->check_for_completion(ec, buffers_.total_consumed());
+        max_size = this->check_for_completion(ec, buffers_->total_consumed());
         for (;;)
         {
           {
             ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_read"));
-            stream_.async_read_some(buffers_.prepare(max_size),
+            stream_.async_read_some(buffers_->prepare(max_size),
                 static_cast<read_op&&>(*this));
           }
           return; default:
-          buffers_.consume(bytes_transferred);
-          if ((!ec && bytes_transferred == 0) || buffers_.empty())
+          buffers_->consume(bytes_transferred);
+          if ((!ec && bytes_transferred == 0) || buffers_->empty())
             break;
-          max_size = this->check_for_completion(ec, buffers_.total_consumed());
+          max_size = this->check_for_completion(ec, buffers_->total_consumed());
           if (max_size == 0)
             break;
           if (this->cancelled() != cancellation_type::none)
@@ -387,18 +392,19 @@ namespace detail
           }
         }
 
-        static_cast<ReadHandler&&>(handler_)(
-            static_cast<const asio::error_code&>(ec),
-            static_cast<const std::size_t&>(buffers_.total_consumed()));
+        {
+          // Release the state before the upcall.
+          const std::size_t total_consumed = buffers_->total_consumed();
+          buffers_.reset();
+          static_cast<ReadHandler&&>(handler_)(
+              static_cast<const asio::error_code&>(ec), total_consumed);
+        }
       }
     }
 
   //private:
-    typedef asio::detail::consuming_buffers<mutable_buffer,
-        MutableBufferSequence, MutableBufferIterator> buffers_type;
-
     AsyncReadStream& stream_;
-    buffers_type buffers_;
+    state_type buffers_;
     int start_;
     ReadHandler handler_;
   };
@@ -0,0 +1,170 @@
+//
+// impl/registered_buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
+#define ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <stdexcept>
+#include "asio/registered_buffer_pool.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+registered_buffer_pool::registered_buffer_pool(execution_context& ctx,
+    std::size_t buffer_size, std::size_t buffer_count)
+  : buffer_size_(round_buffer_size(buffer_size)),
+    memory_(region_size(buffer_size_, buffer_count)),
+    registration_(ctx, make_buffers(memory_, buffer_size_, buffer_count)),
+    next_(buffer_count),
+    free_list_count_(1)
+{
+  std::size_t num_threads = detail::thread::hardware_concurrency();
+  while (free_list_count_ < num_threads && free_list_count_ < max_free_lists)
+    free_list_count_ <<= 1;
+
+  for (std::size_t i = 0; i < max_free_lists; ++i)
+    free_lists_[i].head_.store(0, std::memory_order_relaxed);
+
+  // Deal the buffers out across the free lists so that each list starts with
+  // the lowest addresses on top.
+  for (std::size_t i = buffer_count; i > 0; --i)
+    push((i - 1) & (free_list_count_ - 1), i - 1);
+}
+
+registered_buffer_pool::~registered_buffer_pool()
+{
+}
+
+registered_buffer_pool::lease registered_buffer_pool::acquire() noexcept
+{
+  std::size_t list = this_thread_list();
+  for (std::size_t i = 0; i < free_list_count_; ++i)
+  {
+    std::size_t index = 0;
+    if (pop((list + i) & (free_list_count_ - 1), index))
+      return lease(this, index);
+  }
+  return lease();
+}
+
+std::size_t registered_buffer_pool::round_buffer_size(std::size_t buffer_size)
+{
+  if (buffer_size == 0)
+    return ASIO_CACHE_LINE_SIZE;
+  std::size_t remainder = buffer_size % ASIO_CACHE_LINE_SIZE;
+  if (remainder == 0)
+    return buffer_size;
+  if (buffer_size > (std::numeric_limits<std::size_t>::max)()
+      - (ASIO_CACHE_LINE_SIZE - remainder))
+  {
+    std::length_error ex("registered_buffer_pool buffer size");
+    asio::detail::throw_exception(ex);
+  }
+  return buffer_size + (ASIO_CACHE_LINE_SIZE - remainder);
+}
+
+std::size_t registered_buffer_pool::region_size(
+    std::size_t buffer_size, std::size_t buffer_count)
+{
+  // The free lists store indexes in 32 bits, reserving zero for the end of a
+  // list.
+  if (buffer_count >= 0xFFFFFFFFu || (buffer_count > 0
+        && buffer_size > (std::numeric_limits<std::size_t>::max)()
+          / buffer_count))
+  {
+    std::length_error ex("registered_buffer_pool buffer count");
+    asio::detail::throw_exception(ex);
+  }
+  return buffer_size * buffer_count;
+}
+
+std::vector<mutable_buffer> registered_buffer_pool::make_buffers(
+    const detail::huge_page_memory& memory,
+    std::size_t buffer_size, std::size_t buffer_count)
+{
+  std::vector<mutable_buffer> buffers;
+  buffers.reserve(buffer_count);
+  char* data = static_cast<char*>(memory.data());
+  for (std::size_t i = 0; i < buffer_count; ++i)
+    buffers.push_back(mutable_buffer(data + i * buffer_size, buffer_size));
+  return buffers;
+}
+
+void registered_buffer_pool::release(std::size_t index) noexcept
+{
+  push(this_thread_list(), index);
+}
+
+bool registered_buffer_pool::pop(std::size_t list,
+    std::size_t& index) noexcept
+{
+  std::atomic<uint64_t>& head = free_lists_[list].head_;
+  uint64_t old_head = head.load(std::memory_order_acquire);
+  for (;;)
+  {
+    uint32_t first = static_cast<uint32_t>(old_head);
+    if (first == 0)
+      return false;
+
+    // The buffer may be popped and its link changed by another thread before
+    // the exchange below, but the tag ensures the exchange then fails.
+    uint64_t new_head = ((old_head >> 32) + 1) << 32
+      | next_[first - 1].load(std::memory_order_relaxed);
+    if (head.compare_exchange_weak(old_head, new_head,
+          std::memory_order_acquire, std::memory_order_acquire))
+    {
+      index = first - 1;
+      return true;
+    }
+  }
+}
+
+void registered_buffer_pool::push(std::size_t list,
+    std::size_t index) noexcept
+{
+  std::atomic<uint64_t>& head = free_lists_[list].head_;
+  uint64_t old_head = head.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    next_[index].store(static_cast<uint32_t>(old_head),
+        std::memory_order_relaxed);
+    uint64_t new_head = ((old_head >> 32) + 1) << 32
+      | static_cast<uint64_t>(index + 1);
+    if (head.compare_exchange_weak(old_head, new_head,
+          std::memory_order_release, std::memory_order_relaxed))
+      return;
+  }
+}
+
+std::size_t registered_buffer_pool::this_thread_list() const noexcept
+{
+  static thread_local std::size_t index = 0;
+  if (index == 0)
+  {
+    static std::atomic<std::size_t> next_index(1);
+    index = next_index++;
+  }
+  return (index - 1) & (free_list_count_ - 1);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
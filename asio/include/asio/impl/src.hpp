@@ -27,23 +27,30 @@
 #include "asio/impl/error_code.ipp"
 #include "asio/impl/execution_context.ipp"
 #include "asio/impl/executor.ipp"
+#include "asio/impl/handler_arena.ipp"
 #include "asio/impl/io_context.ipp"
+#include "asio/impl/memory_resource.ipp"
 #include "asio/impl/multiple_exceptions.ipp"
+#include "asio/impl/registered_buffer_pool.ipp"
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
 #include "asio/impl/thread_pool.ipp"
 #include "asio/detail/impl/buffer_sequence_adapter.ipp"
 #include "asio/detail/impl/descriptor_ops.ipp"
 #include "asio/detail/impl/dev_poll_reactor.ipp"
+#include "asio/detail/impl/elastic_thread_group.ipp"
 #include "asio/detail/impl/epoll_reactor.ipp"
 #include "asio/detail/impl/eventfd_select_interrupter.ipp"
+#include "asio/detail/impl/fair_executor_service.ipp"
 #include "asio/detail/impl/handler_tracking.ipp"
+#include "asio/detail/impl/huge_page_memory.ipp"
 #include "asio/detail/impl/io_uring_descriptor_service.ipp"
 #include "asio/detail/impl/io_uring_file_service.ipp"
 #include "asio/detail/impl/io_uring_socket_service_base.ipp"
 #include "asio/detail/impl/io_uring_service.ipp"
 #include "asio/detail/impl/kqueue_reactor.ipp"
 #include "asio/detail/impl/null_event.ipp"
+#include "asio/detail/impl/offload_service.ipp"
 #include "asio/detail/impl/pipe_select_interrupter.ipp"
 #include "asio/detail/impl/posix_event.ipp"
 #include "asio/detail/impl/posix_mutex.ipp"
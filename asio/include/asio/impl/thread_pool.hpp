@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/blocking_executor_op.hpp"
+#include "asio/detail/bulk_executor_op.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
@@ -179,6 +180,66 @@ void thread_pool::basic_executor_type<Allocator,
   op.wait();
 }
 
+template <typename Allocator, unsigned int Bits>
+class thread_pool::basic_executor_type<Allocator,
+    Bits>::initiate_bulk_execute
+{
+public:
+  typedef basic_executor_type executor_type;
+
+  explicit initiate_bulk_execute(const basic_executor_type& ex)
+    : ex_(ex)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return ex_;
+  }
+
+  template <typename Handler, typename Function>
+  void operator()(Handler&& handler, std::size_t n, Function&& f) const
+  {
+    detail::non_const_lvalue<Handler> handler2(handler);
+    detail::non_const_lvalue<Function> f2(f);
+    ex_.do_bulk_execute(handler2.value, n, f2.value);
+  }
+
+private:
+  basic_executor_type ex_;
+};
+
+template <typename Allocator, unsigned int Bits>
+template <typename Handler, typename Function>
+void thread_pool::basic_executor_type<Allocator,
+    Bits>::do_bulk_execute(Handler& handler,
+      std::size_t n, Function& f) const
+{
+  typedef decay_t<Handler> handler_type;
+  typedef decay_t<Function> function_type;
+
+  // There is no point in more threads taking part than there are indices.
+  std::size_t max_participants = pool_->num_threads();
+  if (max_participants > n)
+    max_participants = n;
+  if (max_participants == 0)
+    max_participants = 1;
+
+  // Allocate and construct an operation to wrap the function and handler.
+  typedef detail::bulk_executor_op<function_type,
+    handler_type, basic_executor_type> op;
+  typename op::ptr p = { detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+  p.p = new (p.v) op(static_cast<Function&&>(f), handler,
+      *this, pool_->scheduler_, n, max_participants);
+
+  ASIO_HANDLER_CREATION((*pool_, *p.p,
+        "thread_pool", pool_, 0, "bulk_execute"));
+
+  pool_->scheduler_.post_immediate_completion(p.p, false);
+  p.v = p.p = 0;
+}
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 template <typename Allocator, unsigned int Bits>
 inline thread_pool& thread_pool::basic_executor_type<
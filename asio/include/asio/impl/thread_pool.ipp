@@ -60,7 +60,8 @@ inline long default_thread_pool_size()
 
 thread_pool::thread_pool()
   : scheduler_(add_scheduler(new detail::scheduler(*this, 0, false))),
-    num_threads_(detail::default_thread_pool_size())
+    num_threads_(detail::default_thread_pool_size()),
+    elastic_threads_(0)
 {
   scheduler_.work_started();
 
@@ -86,7 +87,8 @@ inline long clamp_thread_pool_size(std::size_t n)
 thread_pool::thread_pool(std::size_t num_threads)
   : scheduler_(add_scheduler(new detail::scheduler(
           *this, num_threads == 1 ? 1 : 0, false))),
-    num_threads_(detail::clamp_thread_pool_size(num_threads))
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    elastic_threads_(0)
 {
   scheduler_.work_started();
 
@@ -94,10 +96,36 @@ thread_pool::thread_pool(std::size_t num_threads)
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 
+thread_pool::thread_pool(std::size_t min_threads, std::size_t max_threads)
+  : thread_pool(min_threads, max_threads, 20000, 10000000)
+{
+}
+
+thread_pool::thread_pool(std::size_t min_threads, std::size_t max_threads,
+    long growth_latency_usec, long idle_timeout_usec)
+  : scheduler_(add_scheduler(new detail::scheduler(
+          *this, max_threads == 1 ? 1 : 0, false))),
+    num_threads_(0),
+    elastic_threads_(0)
+{
+  if (max_threads == 0 || max_threads > 0x7FFFFFFF
+      || min_threads > max_threads)
+  {
+    std::out_of_range ex("thread pool size");
+    asio::detail::throw_exception(ex);
+  }
+
+  scheduler_.work_started();
+
+  elastic_threads_ = new detail::elastic_thread_group(scheduler_,
+      min_threads, max_threads, growth_latency_usec, idle_timeout_usec);
+}
+
 thread_pool::~thread_pool()
 {
   stop();
   join();
+  delete elastic_threads_;
   shutdown();
 }
 
@@ -115,11 +143,14 @@ void thread_pool::attach()
 
 void thread_pool::join()
 {
-  if (num_threads_)
+  if (num_threads_ || elastic_threads_)
     scheduler_.work_finished();
 
   if (!threads_.empty())
     threads_.join();
+
+  if (elastic_threads_)
+    elastic_threads_->join();
 }
 
 detail::scheduler& thread_pool::add_scheduler(detail::scheduler* s)
@@ -133,6 +164,18 @@ void thread_pool::wait()
 {
   scheduler_.work_finished();
   threads_.join();
+
+  if (elastic_threads_)
+    elastic_threads_->join();
+}
+
+std::size_t thread_pool::num_threads() const
+{
+  std::size_t n = static_cast<std::size_t>(
+      static_cast<long>(num_threads_));
+  if (elastic_threads_)
+    n += elastic_threads_->size();
+  return n;
 }
 
 } // namespace asio
@@ -15,12 +15,14 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/associated_allocator.hpp"
 #include "asio/associator.hpp"
 #include "asio/buffer.hpp"
 #include "asio/detail/array_fwd.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/base_from_completion_cond.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/composed_op_slab.hpp"
 #include "asio/detail/consuming_buffers.hpp"
 #include "asio/detail/dependent_type.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
@@ -289,40 +291,43 @@ namespace detail
       base_from_completion_cond<CompletionCondition>
   {
   public:
+    typedef asio::detail::consuming_buffers<const_buffer,
+        ConstBufferSequence, ConstBufferIterator> buffers_type;
+
+    typedef typename composed_op_state<buffers_type,
+        associated_allocator_t<WriteHandler>>::type state_type;
+
+    typedef typename state_type::allocator_type allocator_type;
+
     write_op(AsyncWriteStream& stream, const ConstBufferSequence& buffers,
         CompletionCondition& completion_condition, WriteHandler& handler)
       : base_from_cancellation_state<WriteHandler>(
           handler, enable_partial_cancellation()),
         base_from_completion_cond<CompletionCondition>(completion_condition),
         stream_(stream),
-        buffers_(buffers),
+        buffers_((get_associated_allocator)(handler), buffers),
         start_(0),
         handler_(static_cast<WriteHandler&&>(handler))
     {
     }
 
-    write_op(const write_op& other)
-      : base_from_cancellation_state<WriteHandler>(other),
-        base_from_completion_cond<CompletionCondition>(other),
-        stream_(other.stream_),
-        buffers_(other.buffers_),
-        start_(other.start_),
-        handler_(other.handler_)
-    {
-    }
-
     write_op(write_op&& other)
       : base_from_cancellation_state<WriteHandler>(
           static_cast<base_from_cancellation_state<WriteHandler>&&>(other)),
         base_from_completion_cond<CompletionCondition>(
           static_cast<base_from_completion_cond<CompletionCondition>&&>(other)),
         stream_(other.stream_),
-        buffers_(static_cast<buffers_type&&>(other.buffers_)),
+        buffers_(static_cast<state_type&&>(other.buffers_)),
         start_(other.start_),
         handler_(static_cast<WriteHandler&&>(other.handler_))
     {
     }
 
+    allocator_type get_allocator() const noexcept
+    {
+      return buffers_.get_allocator();
+    }
+
     void operator()(asio::error_code ec,
         std::size_t bytes_transferred, int start = 0)
     {
@@ -330,19 +335,19 @@ namespace detail
       switch (start_ = start)
       {
         case 1:
-        max_size = this->check_for_completion(ec, buffers_.total_consumed());
+        max_size = this->check_for_completion(ec, buffers_->total_consumed());
         for (;;)
         {
           {
             ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_write"));
-            stream_.async_write_some(buffers_.prepare(max_size),
+            stream_.async_write_some(buffers_->prepare(max_size),
                 static_cast<write_op&&>(*this));
           }
           return; default:
-          buffers_.consume(bytes_transferred);
-          if ((!ec && bytes_transferred == 0) || buffers_.empty())
+          buffers_->consume(bytes_transferred);
+          if ((!ec && bytes_transferred == 0) || buffers_->empty())
             break;
-          max_size = this->check_for_completion(ec, buffers_.total_consumed());
+          max_size = this->check_for_completion(ec, buffers_->total_consumed());
           if (max_size == 0)
             break;
           if (this->cancelled() != cancellation_type::none)
@@ -352,18 +357,19 @@ namespace detail
           }
         }
 
-        static_cast<WriteHandler&&>(handler_)(
-            static_cast<const asio::error_code&>(ec),
-            static_cast<const std::size_t&>(buffers_.total_consumed()));
+        {
+          // Release the state before the upcall.
+          const std::size_t total_consumed = buffers_->total_consumed();
+          buffers_.reset();
+          static_cast<WriteHandler&&>(handler_)(
+              static_cast<const asio::error_code&>(ec), total_consumed);
+        }
       }
     }
 
   //private:
-    typedef asio::detail::consuming_buffers<const_buffer,
-        ConstBufferSequence, ConstBufferIterator> buffers_type;
-
     AsyncWriteStream& stream_;
-    buffers_type buffers_;
+    state_type buffers_;
     int start_;
     WriteHandler handler_;
   };
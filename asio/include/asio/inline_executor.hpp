@@ -0,0 +1,247 @@
+//
+// inline_executor.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_INLINE_EXECUTOR_HPP
+#define ASIO_INLINE_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An executor that invokes functions immediately in the calling thread.
+/**
+ * The inline executor runs a submitted function before @c execute() returns,
+ * on the thread that called it, and lets any exception thrown by the function
+ * propagate to the caller.
+ *
+ * Its main use is as the associated executor of a completion handler that is
+ * safe to run directly from the thread that completes an asynchronous
+ * operation, such as a small handler that only forwards its result. Such a
+ * handler is invoked without any dispatch through, or outstanding work on,
+ * another executor. For example:
+ *
+ * @code socket.async_read_some(buffer,
+ *     asio::bind_executor(asio::inline_executor(),
+ *       [&](asio::error_code ec, std::size_t n)
+ *       {
+ *         ++reads;
+ *       })); @endcode
+ *
+ * The handler may then run concurrently with other handlers for the same I/O
+ * object, even if the I/O object's executor is a strand.
+ */
+class inline_executor
+{
+public:
+  /// Default constructor.
+  constexpr inline_executor() noexcept
+  {
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  friend struct asio_require_fn::impl;
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+  /// Obtain an executor with the @c blocking.always property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * For example:
+   * @code asio::inline_executor ex1;
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::blocking.always); @endcode
+   */
+  constexpr inline_executor require(
+      execution::blocking_t::always_t) const noexcept
+  {
+    return *this;
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  friend struct asio_query_fn::impl;
+  friend struct asio::execution::detail::blocking_t<0>;
+  friend struct asio::execution::detail::mapping_t<0>;
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+  /// Query the current value of the @c mapping property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code asio::inline_executor ex;
+   * if (asio::query(ex, asio::execution::mapping)
+   *       == asio::execution::mapping.thread)
+   *   ... @endcode
+   */
+  static constexpr execution::mapping_t query(
+      execution::mapping_t) noexcept
+  {
+    return execution::mapping.thread;
+  }
+
+  /// Query the current value of the @c blocking property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code asio::inline_executor ex;
+   * if (asio::query(ex, asio::execution::blocking)
+   *       == asio::execution::blocking.always)
+   *   ... @endcode
+   */
+  static constexpr execution::blocking_t query(
+      execution::blocking_t) noexcept
+  {
+    return execution::blocking.always;
+  }
+
+public:
+  /// Compare two executors for equality.
+  /**
+   * All inline executors are equal.
+   */
+  friend constexpr bool operator==(const inline_executor&,
+      const inline_executor&) noexcept
+  {
+    return true;
+  }
+
+  /// Compare two executors for inequality.
+  /**
+   * All inline executors are equal.
+   */
+  friend constexpr bool operator!=(const inline_executor&,
+      const inline_executor&) noexcept
+  {
+    return false;
+  }
+
+  /// Execution function.
+  template <typename Function>
+  void execute(Function&& f) const
+  {
+    // Obtain a non-const instance of the function.
+    detail::non_const_lvalue<Function> f2(f);
+    static_cast<decay_t<Function>&&>(f2.value)();
+  }
+};
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+template <>
+struct equality_comparable<asio::inline_executor>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+template <typename Function>
+struct execute_member<asio::inline_executor, Function>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef void result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+template <>
+struct require_member<
+    asio::inline_executor,
+    asio::execution::blocking_t::always_t
+  >
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef asio::inline_executor result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+
+template <typename Property>
+struct query_static_constexpr_member<
+    asio::inline_executor,
+    Property,
+    typename asio::enable_if<
+      asio::is_convertible<
+        Property,
+        asio::execution::mapping_t
+      >::value
+    >::type
+  >
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef asio::execution::mapping_t::thread_t result_type;
+
+  static constexpr result_type value() noexcept
+  {
+    return result_type();
+  }
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+template <typename Property>
+struct query_member<
+    asio::inline_executor,
+    Property,
+    typename asio::enable_if<
+      asio::is_convertible<
+        Property,
+        asio::execution::blocking_t
+      >::value
+    >::type
+  >
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef asio::execution::blocking_t result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+} // namespace traits
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_INLINE_EXECUTOR_HPP
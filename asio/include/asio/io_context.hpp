@@ -23,6 +23,8 @@
 #include "asio/detail/chrono.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/cstdint.hpp"
+#include "asio/detail/is_affine_executor.hpp"
+#include "asio/detail/run_until_complete.hpp"
 #include "asio/detail/wrapped_handler.hpp"
 #include "asio/error_code.hpp"
 #include "asio/execution.hpp"
@@ -62,6 +64,23 @@ namespace detail {
   };
 } // namespace detail
 
+// Forward declarations of the I/O objects named by io_context's aliases.
+template <typename Clock> struct wait_traits;
+template <typename Clock, typename WaitTraits, typename Executor>
+class basic_waitable_timer;
+template <typename Clock, typename WaitTraits, typename Executor>
+class basic_periodic_timer;
+template <typename Executor> class basic_signal_set;
+template <typename Protocol, typename Executor> class basic_stream_socket;
+template <typename Protocol, typename Executor> class basic_datagram_socket;
+template <typename Protocol, typename Executor> class basic_socket_acceptor;
+
+namespace ip {
+class tcp;
+class udp;
+template <typename InternetProtocol, typename Executor> class basic_resolver;
+} // namespace ip
+
 /// Provides core I/O functionality.
 /**
  * The io_context class provides the core I/O functionality for users of the
@@ -225,6 +244,64 @@ public:
 #endif // !defined(ASIO_NO_EXTENSIONS)
        //   && !defined(ASIO_NO_TS_EXECUTORS)
 
+  /// The steady timer type when bound to an io_context's executor.
+  /**
+   * I/O objects that use the io_context's own executor type, rather than the
+   * default asio::any_io_executor, avoid type erasure on every operation.
+   * These aliases name such objects. The header that defines the underlying
+   * I/O object must still be included, and the objects are constructed from
+   * the io_context itself:
+   *
+   * @code asio::io_context ctx;
+   * asio::io_context::steady_timer timer(ctx, std::chrono::seconds(1));
+   * asio::io_context::tcp::socket socket(ctx); @endcode
+   *
+   * Composed operations, such as asio::async_read() and asio::async_connect(),
+   * and stream layers, such as asio::ssl::stream, take their executor type
+   * from the underlying I/O object and so keep the concrete type throughout.
+   */
+  typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, executor_type> steady_timer;
+
+  /// The system timer type when bound to an io_context's executor.
+  typedef basic_waitable_timer<chrono::system_clock,
+      wait_traits<chrono::system_clock>, executor_type> system_timer;
+
+  /// The high resolution timer type when bound to an io_context's executor.
+  typedef basic_waitable_timer<chrono::high_resolution_clock,
+      wait_traits<chrono::high_resolution_clock>, executor_type>
+    high_resolution_timer;
+
+  /// The periodic timer type when bound to an io_context's executor.
+  typedef basic_periodic_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, executor_type> periodic_timer;
+
+  /// The signal set type when bound to an io_context's executor.
+  typedef basic_signal_set<executor_type> signal_set;
+
+  /// TCP I/O object types when bound to an io_context's executor.
+  struct tcp
+  {
+    /// The TCP socket type.
+    typedef basic_stream_socket<ip::tcp, executor_type> socket;
+
+    /// The TCP acceptor type.
+    typedef basic_socket_acceptor<ip::tcp, executor_type> acceptor;
+
+    /// The TCP resolver type.
+    typedef ip::basic_resolver<ip::tcp, executor_type> resolver;
+  };
+
+  /// UDP I/O object types when bound to an io_context's executor.
+  struct udp
+  {
+    /// The UDP socket type.
+    typedef basic_datagram_socket<ip::udp, executor_type> socket;
+
+    /// The UDP resolver type.
+    typedef ip::basic_resolver<ip::udp, executor_type> resolver;
+  };
+
   /// The type used to count the number of handlers executed by the context.
   typedef std::size_t count_type;
 
@@ -240,6 +317,30 @@ public:
    */
   ASIO_DECL explicit io_context(int concurrency_hint);
 
+  /// Constructor.
+  /**
+   * Construct with a memory resource for internal allocations.
+   *
+   * @param r The memory resource used to allocate the io_context's services,
+   * per-descriptor reactor state and strand implementations. The resource
+   * must outlive the io_context and all I/O objects associated with it.
+   */
+  ASIO_DECL explicit io_context(memory_resource& r);
+
+  /// Constructor.
+  /**
+   * Construct with a hint about the required level of concurrency, and a
+   * memory resource for internal allocations.
+   *
+   * @param concurrency_hint A suggestion to the implementation on how many
+   * threads it should allow to run simultaneously.
+   *
+   * @param r The memory resource used to allocate the io_context's services,
+   * per-descriptor reactor state and strand implementations. The resource
+   * must outlive the io_context and all I/O objects associated with it.
+   */
+  ASIO_DECL io_context(int concurrency_hint, memory_resource& r);
+
   /// Destructor.
   /**
    * On destruction, the io_context performs the following sequence of
@@ -434,6 +535,71 @@ public:
   std::size_t run_one_until(
       const chrono::time_point<Clock, Duration>& abs_time);
 
+  /// Run the io_context object's event processing loop until an asynchronous
+  /// operation completes, and return the operation's result.
+  /**
+   * The run_until_complete() function launches the operation by calling
+   * @c op with a completion handler, then runs handlers on the calling thread
+   * until that completion handler has been invoked. The operation's result is
+   * held on the caller's stack, without a promise or shared state.
+   *
+   * @param op A deferred asynchronous operation, such as the result of
+   * <tt>timer.async_wait(asio::deferred)</tt>. An awaitable is run by passing
+   * <tt>asio::co_spawn(ctx, a, asio::deferred)</tt>.
+   *
+   * @returns Nothing if the operation completes with no values other than an
+   * error, the value if it completes with one, and a @c std::tuple if it
+   * completes with several.
+   *
+   * @throws asio::system_error If the first argument of the completion is an
+   * @c error_code that indicates failure, or with
+   * asio::error::operation_aborted if the completion handler is
+   * destroyed without being invoked. If the first argument is a
+   * @c std::exception_ptr that is set, the exception is rethrown.
+   *
+   * @note Unlike <tt>future.get()</tt>, this function may be called from a
+   * handler running on the io_context, including on an io_context with a
+   * concurrency hint of 1. Like a synchronous operation, it returns only once
+   * the operation has completed, and a call to stop() does not interrupt it.
+   * An exception thrown by another handler is held until the operation
+   * completes, and is then rethrown.
+   */
+  template <typename Operation>
+#if defined(GENERATING_DOCUMENTATION)
+  see_below
+#else // defined(GENERATING_DOCUMENTATION)
+  typename detail::run_until_complete_state<impl_type,
+    completion_signature_of_t<Operation>>::result_type
+#endif // defined(GENERATING_DOCUMENTATION)
+  run_until_complete(Operation&& op);
+
+  /// Run the io_context object's event processing loop until an asynchronous
+  /// operation completes, and return the operation's result.
+  /**
+   * The run_until_complete() function launches the operation by calling
+   * @c op with a completion handler, then runs handlers on the calling thread
+   * until that completion handler has been invoked.
+   *
+   * @param op A deferred asynchronous operation whose completion signature
+   * has an @c error_code as its first argument.
+   *
+   * @param ec Set to the error_code passed to the completion handler, or to
+   * asio::error::operation_aborted if the completion handler is destroyed
+   * without being invoked. In that case, an operation that produces other
+   * values throws asio::system_error, as there are no values to return.
+   *
+   * @returns The values that follow the error_code, as for the overload that
+   * throws.
+   */
+  template <typename Operation>
+#if defined(GENERATING_DOCUMENTATION)
+  see_below
+#else // defined(GENERATING_DOCUMENTATION)
+  typename detail::run_until_complete_state<impl_type,
+    completion_signature_of_t<Operation>>::result_type
+#endif // defined(GENERATING_DOCUMENTATION)
+  run_until_complete(Operation&& op, asio::error_code& ec);
+
   /// Run the io_context object's event processing loop to execute ready
   /// handlers.
   /**
@@ -516,6 +682,38 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Pre-allocate the internal state for I/O objects.
+  /**
+   * This function allocates the per-descriptor state for @c n I/O objects in
+   * a single contiguous block, with each object on its own cache line, so that
+   * a burst of new connections after start up does not allocate. The memory is
+   * obtained from the io_context's memory resource and is held until the
+   * io_context is destroyed. This function has no effect on platforms where
+   * the io_context keeps no per-descriptor state.
+   */
+  ASIO_DECL void reserve_descriptors(std::size_t n);
+
+  /// Pre-allocate space for waiting timers.
+  /**
+   * This function ensures that @c n timers of each clock type may wait at the
+   * same time without the io_context allocating memory to queue them. It
+   * applies to timers of clock types that are first used after the call.
+   */
+  ASIO_DECL void reserve_timers(std::size_t n);
+
+  /// Pre-allocate memory for asynchronous operations.
+  /**
+   * This function allocates memory for @c n operations of up to @c size bytes
+   * each, and places it in the cache that threads use to exchange recycled
+   * memory. Threads running the io_context draw on it as they start
+   * operations that use the default recycling allocator.
+   *
+   * @note This cache is shared by all threads in the process. It holds a
+   * limited number of blocks of each size, and operations larger than 4KB are
+   * not cached, so some of the requested memory may not be allocated.
+   */
+  ASIO_DECL void reserve_operations(std::size_t n, std::size_t size);
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -626,6 +824,10 @@ private:
   // Helper function to add the implementation.
   ASIO_DECL impl_type& add_impl(impl_type* impl);
 
+  // Helper function to launch an operation and run until it completes.
+  template <typename State, typename Operation>
+  void launch_and_run_until_complete(State& state, Operation&& op);
+
   // Backwards compatible overload for use with services derived from
   // io_context::service.
   template <typename Service>
@@ -1483,6 +1685,16 @@ struct is_executor<io_context> : false_type
 
 } // namespace execution
 
+namespace detail {
+
+template <typename Allocator, uintptr_t Bits>
+struct is_affine_executor<io_context::basic_executor_type<Allocator, Bits>>
+  : true_type
+{
+};
+
+} // namespace detail
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 } // namespace asio
@@ -114,9 +114,9 @@ public:
    * state.
    */
   strand(const strand& other) noexcept
-    : service_(other.service_),
-      impl_(other.impl_)
+    : service_(other.service_)
   {
+    service_.copy_construct(impl_, other.impl_);
   }
 
   /// Destructor.
@@ -128,6 +128,7 @@ public:
    */
   ~strand()
   {
+    service_.destroy(impl_);
   }
 
   /// Obtain the underlying execution context.
@@ -0,0 +1,217 @@
+//
+// memory_resource.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_MEMORY_RESOURCE_HPP
+#define ASIO_MEMORY_RESOURCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An abstract interface to a source of memory.
+/**
+ * The memory_resource class is modelled on @c std::pmr::memory_resource. An
+ * execution context may be constructed with a memory resource, which is then
+ * used for the context's long-lived internal allocations, such as its
+ * services, per-descriptor reactor state and strand implementations. This
+ * allows those allocations to be placed in a specific region of memory, such
+ * as huge pages or a NUMA-local arena, and to be accounted for per context.
+ *
+ * Memory for asynchronous operations is not obtained from the resource, but
+ * from the completion handler's associated allocator.
+ */
+class memory_resource
+{
+public:
+  /// Destructor.
+  virtual ~memory_resource()
+  {
+  }
+
+  /// Allocate memory.
+  void* allocate(std::size_t bytes, std::size_t align = ASIO_DEFAULT_ALIGN)
+  {
+    return do_allocate(bytes, align);
+  }
+
+  /// Deallocate memory previously obtained from allocate().
+  void deallocate(void* p, std::size_t bytes,
+      std::size_t align = ASIO_DEFAULT_ALIGN)
+  {
+    do_deallocate(p, bytes, align);
+  }
+
+  /// Determine whether memory allocated from one resource may be deallocated
+  /// by another.
+  bool is_equal(const memory_resource& other) const noexcept
+  {
+    return do_is_equal(other);
+  }
+
+  /// Equality operator.
+  friend bool operator==(const memory_resource& a,
+      const memory_resource& b) noexcept
+  {
+    return &a == &b || a.is_equal(b);
+  }
+
+  /// Inequality operator.
+  friend bool operator!=(const memory_resource& a,
+      const memory_resource& b) noexcept
+  {
+    return !(a == b);
+  }
+
+private:
+  /// Allocate memory.
+  virtual void* do_allocate(std::size_t bytes, std::size_t align) = 0;
+
+  /// Deallocate memory.
+  virtual void do_deallocate(void* p,
+      std::size_t bytes, std::size_t align) = 0;
+
+  /// Compare for equality with another resource.
+  virtual bool do_is_equal(const memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+};
+
+/// Get a memory resource that uses the global operator new.
+/**
+ * This is the resource used by an execution context that is constructed
+ * without an explicit memory resource.
+ */
+ASIO_DECL memory_resource* get_default_memory_resource() noexcept;
+
+/// An allocator that obtains memory from a memory_resource.
+template <typename T>
+class memory_resource_allocator
+{
+public:
+  /// The type of object allocated by the allocator.
+  typedef T value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef memory_resource_allocator<U> other;
+  };
+
+  /// Default constructor. Uses the default memory resource.
+  memory_resource_allocator() noexcept
+    : resource_(get_default_memory_resource())
+  {
+  }
+
+  /// Construct an allocator that uses the specified resource.
+  memory_resource_allocator(memory_resource* r) noexcept
+    : resource_(r)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  memory_resource_allocator(const memory_resource_allocator<U>& other) noexcept
+    : resource_(other.resource())
+  {
+  }
+
+  /// Get the memory resource used by the allocator.
+  memory_resource* resource() const noexcept
+  {
+    return resource_;
+  }
+
+  /// Equality operator.
+  friend bool operator==(const memory_resource_allocator& a,
+      const memory_resource_allocator& b) noexcept
+  {
+    return *a.resource_ == *b.resource_;
+  }
+
+  /// Inequality operator.
+  friend bool operator!=(const memory_resource_allocator& a,
+      const memory_resource_allocator& b) noexcept
+  {
+    return *a.resource_ != *b.resource_;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(resource_->allocate(sizeof(T) * n, alignof(T)));
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    resource_->deallocate(p, sizeof(T) * n, alignof(T));
+  }
+
+private:
+  memory_resource* resource_;
+};
+
+namespace detail {
+
+// Holds memory for an object while it is being constructed, returning the
+// memory to the resource if the constructor throws.
+template <typename T>
+struct resource_memory_guard
+{
+  ~resource_memory_guard()
+  {
+    if (pointer_)
+      resource_->deallocate(pointer_, sizeof(T), alignof(T));
+  }
+
+  memory_resource* resource_;
+  void* pointer_;
+};
+
+// Allocate and construct an object using a memory resource.
+template <typename T, typename... Args>
+T* resource_new(memory_resource& r, Args&&... args)
+{
+  resource_memory_guard<T> guard = { &r, r.allocate(sizeof(T), alignof(T)) };
+  T* p = new (guard.pointer_) T(static_cast<Args&&>(args)...);
+  guard.pointer_ = 0;
+  return p;
+}
+
+// Destroy and deallocate an object obtained from resource_new().
+template <typename T>
+void resource_delete(memory_resource& r, T* p)
+{
+  p->~T();
+  r.deallocate(p, sizeof(T), alignof(T));
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/memory_resource.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_MEMORY_RESOURCE_HPP
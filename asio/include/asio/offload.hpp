@@ -0,0 +1,230 @@
+//
+// offload.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_OFFLOAD_HPP
+#define ASIO_OFFLOAD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <exception>
+#include "asio/async_result.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/execution/executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename> class initiate_async_offload;
+
+  template <typename Result>
+  struct offload_signature
+  {
+    typedef void type(std::exception_ptr,
+        asio::error_code, decay_t<Result>);
+  };
+
+  template <>
+  struct offload_signature<void>
+  {
+    typedef void type(std::exception_ptr, asio::error_code);
+  };
+} // namespace detail
+
+/// Limits on the blocking functions that an execution context runs.
+/**
+ * Functions passed to async_offload() run on a group of threads that is
+ * owned by the execution context, and that is separate from the threads
+ * running the context. Threads are started as they are needed, up to @c
+ * max_threads, and remain until the context is destroyed. Functions that
+ * arrive while all threads are busy wait in a queue of at most @c max_queued
+ * entries, beyond which the @c overflow policy applies.
+ */
+struct offload_options
+{
+  /// The action taken when a function is offloaded while the queue is full.
+  enum overflow_policy
+  {
+    /// Complete the operation with asio::error::try_again, without calling
+    /// the function.
+    reject,
+
+    /// Call the function in the thread that started the operation, before
+    /// async_offload() returns. The completion handler is still called as if
+    /// by post().
+    caller_runs
+  };
+
+  /// Construct with the default limits.
+  offload_options() noexcept
+    : max_threads(4),
+      max_queued(1024),
+      overflow(reject)
+  {
+  }
+
+  /// The maximum number of threads that run offloaded functions.
+  std::size_t max_threads;
+
+  /// The maximum number of functions that wait for a thread.
+  std::size_t max_queued;
+
+  /// The action taken when a function does not fit in the queue.
+  overflow_policy overflow;
+};
+
+/// Get the limits on the blocking functions that an execution context runs.
+/**
+ * This function is thread-safe.
+ */
+offload_options get_offload_options(execution_context& ctx);
+
+/// Set the limits on the blocking functions that an execution context runs.
+/**
+ * This function is thread-safe. The new limits apply to functions offloaded
+ * after the call. Lowering @c max_threads does not stop threads that have
+ * already been started.
+ */
+void set_offload_options(execution_context& ctx,
+    const offload_options& options);
+
+/// Run a blocking function away from the threads that run an executor's
+/// execution context.
+/**
+ * This function starts an asynchronous operation that calls @c f() on one of
+ * the threads that the executor's execution context keeps for blocking work,
+ * such as synchronous file system calls or compression. When @c f() returns,
+ * the completion handler is called with its result, using the handler's
+ * associated executor, which defaults to @c ex.
+ *
+ * The number of threads and the length of the queue of waiting functions are
+ * bounded, as set by set_offload_options(). This provides back-pressure when
+ * blocking work arrives faster than it can be performed.
+ *
+ * @param ex The executor on whose behalf the function runs. Its execution
+ * context must be an io_context, a thread_pool or the system_context.
+ *
+ * @param f The blocking function. The function is called with no arguments,
+ * and its result type must be @c void or, once any reference and cv-qualifiers
+ * are removed, default constructible. A returned reference is copied into the
+ * result. If the function exits via an exception, the exception is passed to
+ * the completion handler.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler. If @c f returns @c void, the function signature of the
+ * completion handler must be:
+ * @code void handler(
+ *   std::exception_ptr e, // Set if f() exited via an exception.
+ *   const asio::error_code& error // Result of operation.
+ * ); @endcode
+ * Otherwise, where @c R is the result type of @c f() with any reference and
+ * cv-qualifiers removed, it must be:
+ * @code void handler(
+ *   std::exception_ptr e, // Set if f() exited via an exception.
+ *   const asio::error_code& error, // Result of operation.
+ *   R result // The value returned by f(), if neither e nor error is set.
+ * ); @endcode
+ * If the function is not called because the queue is full, @c error is
+ * asio::error::try_again. On a context that does not permit locking, the
+ * function is never called and @c error is
+ * asio::error::operation_not_supported. Regardless of whether the
+ * asynchronous operation completes immediately or not, the completion handler
+ * will not be invoked from within this function.
+ *
+ * @par Completion Signature
+ * @code void(std::exception_ptr, asio::error_code) @endcode
+ * or
+ * @code void(std::exception_ptr, asio::error_code, R) @endcode
+ *
+ * @par Example
+ * @code asio::async_offload(socket.get_executor(),
+ *     [data]{ return compress(data); },
+ *     [](std::exception_ptr e, asio::error_code ec, std::string compressed)
+ *     {
+ *       // Runs on the socket's executor.
+ *     }); @endcode
+ */
+template <typename Executor, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(typename detail::offload_signature<
+      result_of_t<decay_t<Function>()>>::type) CompletionToken
+        = default_completion_token_t<Executor>>
+inline auto async_offload(const Executor& ex, Function&& f,
+    CompletionToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      execution::is_executor<Executor>::value
+    > = 0)
+  -> decltype(
+    async_initiate<CompletionToken,
+      typename detail::offload_signature<
+        result_of_t<decay_t<Function>()>>::type>(
+          declval<detail::initiate_async_offload<Executor>>(),
+          token, static_cast<Function&&>(f)))
+{
+  return async_initiate<CompletionToken,
+    typename detail::offload_signature<
+      result_of_t<decay_t<Function>()>>::type>(
+        detail::initiate_async_offload<Executor>(ex),
+        token, static_cast<Function&&>(f));
+}
+
+/// Run a blocking function away from the threads that run an execution
+/// context.
+/**
+ * @param ctx An execution context, from which the executor is obtained.
+ *
+ * @param f The blocking function.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler.
+ *
+ * @returns <tt>async_offload(ctx.get_executor(), forward<Function>(f),
+ * forward<CompletionToken>(token))</tt>.
+ */
+template <typename ExecutionContext, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(typename detail::offload_signature<
+      result_of_t<decay_t<Function>()>>::type) CompletionToken
+        = default_completion_token_t<typename ExecutionContext::executor_type>>
+inline auto async_offload(ExecutionContext& ctx, Function&& f,
+    CompletionToken&& token = default_completion_token_t<
+      typename ExecutionContext::executor_type>(),
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+  -> decltype(
+    async_initiate<CompletionToken,
+      typename detail::offload_signature<
+        result_of_t<decay_t<Function>()>>::type>(
+          declval<detail::initiate_async_offload<
+            typename ExecutionContext::executor_type>>(),
+          token, static_cast<Function&&>(f)))
+{
+  return async_initiate<CompletionToken,
+    typename detail::offload_signature<
+      result_of_t<decay_t<Function>()>>::type>(
+        detail::initiate_async_offload<
+          typename ExecutionContext::executor_type>(ctx.get_executor()),
+        token, static_cast<Function&&>(f));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/offload.hpp"
+
+#endif // ASIO_OFFLOAD_HPP
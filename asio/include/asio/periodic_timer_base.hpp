@@ -0,0 +1,53 @@
+//
+// periodic_timer_base.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PERIODIC_TIMER_BASE_HPP
+#define ASIO_PERIODIC_TIMER_BASE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// The periodic_timer_base class is used as a base for the basic_periodic_timer
+/// class template so that we have a common place to define the schedule enum.
+class periodic_timer_base
+{
+public:
+  /// Enumeration used to specify how the next tick of a periodic timer is
+  /// scheduled.
+  enum schedule_type
+  {
+    /// Ticks occur at fixed points in time, each exactly one period after the
+    /// previous tick's scheduled time. Late handlers do not cause drift, and
+    /// ticks that have already been missed are skipped and reported.
+    fixed_rate,
+
+    /// Each tick occurs one period after the wait for it was started.
+    fixed_delay
+  };
+
+protected:
+  /// Protected destructor to prevent deletion through this type.
+  ~periodic_timer_base()
+  {
+  }
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_PERIODIC_TIMER_BASE_HPP
@@ -0,0 +1,304 @@
+//
+// registered_buffer_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_REGISTERED_BUFFER_POOL_HPP
+#define ASIO_REGISTERED_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "asio/buffer.hpp"
+#include "asio/buffer_registration.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/huge_page_memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/is_executor.hpp"
+#include "asio/query.hpp"
+#include "asio/registered_buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of fixed-size buffers that are registered with an execution context.
+/**
+ * The registered_buffer_pool class allocates a single region of memory, carves
+ * it into equally sized buffers, and registers those buffers with an
+ * execution context. Buffers are handed out as leases, each of which refers to
+ * a mutable_registered_buffer and returns the buffer to the pool when it is
+ * destroyed.
+ *
+ * Where the platform allows, the region is backed by explicit huge pages. If
+ * none are available, the region is mapped using normal pages and the kernel
+ * is advised to back it with transparent huge pages. On other platforms the
+ * region is allocated from the heap. Each buffer size is rounded up to a
+ * multiple of the cache line size.
+ *
+ * Free buffers are kept on a set of lock-free stacks. Each thread releases
+ * buffers to, and first acquires buffers from, its own stack, taking buffers
+ * from the other stacks only when its own is empty.
+ *
+ * For portability, applications should assume that only one registration,
+ * whether by a registered_buffer_pool or a buffer_registration, is permitted
+ * per execution context. When io_uring is used, the kernel also limits the
+ * number of buffers and the total size of a registration.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class registered_buffer_pool
+  : private noncopyable
+{
+public:
+  class lease;
+
+  /// Construct a pool and register its buffers with an executor's execution
+  /// context.
+  /**
+   * @param ex The executor whose execution context the buffers are registered
+   * with.
+   *
+   * @param buffer_size The minimum size of each buffer.
+   *
+   * @param buffer_count The number of buffers in the pool.
+   */
+  template <typename Executor>
+  registered_buffer_pool(const Executor& ex,
+      std::size_t buffer_size, std::size_t buffer_count,
+      constraint_t<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      > = 0)
+    : registered_buffer_pool(registered_buffer_pool::get_context(ex),
+        buffer_size, buffer_count)
+  {
+  }
+
+  /// Construct a pool and register its buffers with an execution context.
+  /**
+   * @param ctx The execution context the buffers are registered with.
+   *
+   * @param buffer_size The minimum size of each buffer.
+   *
+   * @param buffer_count The number of buffers in the pool.
+   */
+  ASIO_DECL registered_buffer_pool(execution_context& ctx,
+      std::size_t buffer_size, std::size_t buffer_count);
+
+  /// Destructor. Unregisters the buffers and releases the memory.
+  /**
+   * All leases must have been destroyed or released before the pool is
+   * destroyed.
+   */
+  ASIO_DECL ~registered_buffer_pool();
+
+  /// Get the size of each buffer in the pool.
+  std::size_t buffer_size() const noexcept
+  {
+    return buffer_size_;
+  }
+
+  /// Get the number of buffers in the pool.
+  std::size_t buffer_count() const noexcept
+  {
+    return registration_.size();
+  }
+
+  /// Determine whether the pool's memory is backed by explicit huge pages.
+  bool uses_huge_pages() const noexcept
+  {
+    return memory_.uses_huge_pages();
+  }
+
+  /// Acquire a buffer from the pool.
+  /**
+   * @returns A lease on a free buffer, or an empty lease if all buffers are in
+   * use.
+   */
+  ASIO_DECL lease acquire() noexcept;
+
+private:
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Round the buffer size up to a whole number of cache lines.
+  ASIO_DECL static std::size_t round_buffer_size(std::size_t buffer_size);
+
+  // Get the size of the memory region needed for the buffers. Throws if the
+  // buffer count is too large.
+  ASIO_DECL static std::size_t region_size(
+      std::size_t buffer_size, std::size_t buffer_count);
+
+  // Divide the memory region into buffers.
+  ASIO_DECL static std::vector<mutable_buffer> make_buffers(
+      const detail::huge_page_memory& memory,
+      std::size_t buffer_size, std::size_t buffer_count);
+
+  // Return a buffer to the calling thread's free list.
+  ASIO_DECL void release(std::size_t index) noexcept;
+
+  // Pop a buffer from the specified free list. Returns false if it is empty.
+  ASIO_DECL bool pop(std::size_t list, std::size_t& index) noexcept;
+
+  // Push a buffer on to the specified free list.
+  ASIO_DECL void push(std::size_t list, std::size_t index) noexcept;
+
+  // Get the free list used by the calling thread.
+  ASIO_DECL std::size_t this_thread_list() const noexcept;
+
+  // The maximum number of free lists.
+  enum { max_free_lists = 16 };
+
+  // The head of a free list. The low 32 bits hold one more than the index of
+  // the first free buffer, or zero if the list is empty. The high 32 bits hold
+  // a tag that is incremented on every update to prevent ABA problems. Each
+  // head occupies its own cache line.
+  struct free_list
+  {
+    std::atomic<uint64_t> head_;
+    char padding_[ASIO_CACHE_LINE_SIZE
+      - sizeof(std::atomic<uint64_t>)];
+  };
+
+  // The size of each buffer.
+  std::size_t buffer_size_;
+
+  // The memory from which the buffers are carved.
+  detail::huge_page_memory memory_;
+
+  // The registration of the buffers with the execution context.
+  buffer_registration<std::vector<mutable_buffer>> registration_;
+
+  // The link from each free buffer to the next, stored as for the list heads.
+  std::vector<std::atomic<uint32_t>> next_;
+
+  // The free lists.
+  free_list free_lists_[max_free_lists];
+
+  // The number of free lists in use. Always a power of two.
+  std::size_t free_list_count_;
+};
+
+/// A lease on a buffer from a registered_buffer_pool.
+/**
+ * A lease is movable but not copyable. When a non-empty lease is destroyed or
+ * released, its buffer is returned to the pool.
+ */
+class registered_buffer_pool::lease
+{
+public:
+  /// Construct an empty lease.
+  lease() noexcept
+    : pool_(0),
+      index_(0)
+  {
+  }
+
+  /// Move constructor.
+  lease(lease&& other) noexcept
+    : pool_(other.pool_),
+      index_(other.index_)
+  {
+    other.pool_ = 0;
+  }
+
+  /// Move assignment.
+  lease& operator=(lease&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      pool_ = other.pool_;
+      index_ = other.index_;
+      other.pool_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destructor. Returns the buffer to the pool.
+  ~lease()
+  {
+    release();
+  }
+
+  /// Determine whether the lease refers to a buffer.
+  explicit operator bool() const noexcept
+  {
+    return pool_ != 0;
+  }
+
+  /// Get the leased buffer.
+  /**
+   * @note The lease must not be empty.
+   */
+  mutable_registered_buffer buffer() const noexcept
+  {
+    return pool_->registration_.begin()[index_];
+  }
+
+  /// Return the buffer to the pool, leaving the lease empty.
+  void release() noexcept
+  {
+    if (pool_)
+    {
+      pool_->release(index_);
+      pool_ = 0;
+    }
+  }
+
+private:
+  friend class registered_buffer_pool;
+
+  // Construct a lease on the buffer at the specified index.
+  lease(registered_buffer_pool* pool, std::size_t index) noexcept
+    : pool_(pool),
+      index_(index)
+  {
+  }
+
+  // Disallow copying and assignment.
+  lease(const lease&) = delete;
+  lease& operator=(const lease&) = delete;
+
+  registered_buffer_pool* pool_;
+  std::size_t index_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/registered_buffer_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_REGISTERED_BUFFER_POOL_HPP
@@ -344,6 +344,64 @@ public:
     return detail::strand_executor_service::running_in_this_thread(impl_);
   }
 
+  /// Set the maximum number of handlers run each time the strand is scheduled.
+  /**
+   * Once the strand has run @c max_handlers handlers in a single scheduling
+   * slice, any remaining handlers are rescheduled on the underlying executor
+   * so that other work queued on that executor is given a chance to run. A
+   * value of zero, the default, means that the strand runs all ready handlers
+   * before giving up the underlying executor.
+   *
+   * The budget is shared by all copies of the strand, and takes effect from
+   * the next scheduling slice.
+   */
+  void set_run_budget(std::size_t max_handlers) const
+  {
+    detail::strand_executor_service::set_run_budget(impl_, max_handlers);
+  }
+
+  /// Get the maximum number of handlers run each time the strand is scheduled.
+  /**
+   * @return The number of handlers, or zero if the strand runs all ready
+   * handlers each time it is scheduled.
+   */
+  std::size_t run_budget() const
+  {
+    return detail::strand_executor_service::get_run_budget(impl_);
+  }
+
+  /// Set whether the strand prefers to run on the thread that last ran it.
+  /**
+   * When thread affinity is enabled, and the strand has more handlers to run
+   * at the end of a scheduling slice, the strand is rescheduled on the same
+   * thread rather than being made available to all threads. This keeps the
+   * state touched by the strand's handlers in that thread's cache. If the
+   * thread is overloaded with such work, or is not running the scheduler's
+   * event loop, the strand is instead scheduled normally.
+   *
+   * When an idle strand is given a new handler, it is likewise scheduled on
+   * the thread that last ran it if that thread is the current thread, or is
+   * waiting for events in the scheduler's reactor and so can be woken on its
+   * own. Otherwise, such as when that thread is busy running a handler or is
+   * waiting for work along with other threads, the strand is scheduled
+   * normally so that it does not wait on a busy thread.
+   *
+   * Thread affinity is only supported when the strand's inner executor is an
+   * io_context or thread_pool executor, as rescheduling on the same thread
+   * bypasses the inner executor. It is otherwise ignored.
+   */
+  void set_thread_affinity(bool affinity) const
+  {
+    detail::strand_executor_service::set_thread_affinity(impl_,
+        affinity && detail::is_affine_executor<Executor>::value);
+  }
+
+  /// Get whether the strand prefers to run on the thread that last ran it.
+  bool thread_affinity() const
+  {
+    return detail::strand_executor_service::get_thread_affinity(impl_);
+  }
+
   /// Compare two strands for equality.
   /**
    * Two strands are equal if they refer to the same ordered, non-concurrent
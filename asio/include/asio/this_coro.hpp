@@ -59,6 +59,40 @@ struct cancellation_state_t
  */
 constexpr cancellation_state_t cancellation_state;
 
+/// Awaitable type that yields to other work when the current coroutine has
+/// run for long enough.
+struct yield_if_needed_t
+{
+  constexpr yield_if_needed_t()
+  {
+  }
+};
+
+/// Awaitable object that yields to other work when the current coroutine has
+/// run for long enough.
+/**
+ * Awaiting this object resumes the coroutine immediately, unless
+ * asio::this_thread_should_yield() returns @c true. In that case the
+ * coroutine is resumed through its executor as a continuation, so that the
+ * handlers waiting to run go first.
+ *
+ * The running time is measured from the coroutine's first await of this object
+ * since it was resumed, or from the start of the handler that resumed it if
+ * @c ASIO_ENABLE_HANDLER_YIELD is defined. See
+ * asio::this_thread_should_yield() for details.
+ *
+ * @par Example
+ * @code asio::awaitable<void> process(std::vector<item> batch)
+ * {
+ *   for (item& i : batch)
+ *   {
+ *     process_item(i);
+ *     co_await asio::this_coro::yield_if_needed;
+ *   }
+ * } @endcode
+ */
+constexpr yield_if_needed_t yield_if_needed;
+
 #if defined(GENERATING_DOCUMENTATION)
 
 /// Returns an awaitable object that may be used to reset the cancellation state
@@ -0,0 +1,75 @@
+//
+// this_thread_should_yield.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_THIS_THREAD_SHOULD_YIELD_HPP
+#define ASIO_THIS_THREAD_SHOULD_YIELD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/thread_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Determine whether the handler running on the current thread should yield
+/// to other work.
+/**
+ * A handler that processes a large batch may call this function between
+ * items, and return early after reposting the rest of the batch, for example
+ * using @ref defer(), when it returns @c true. This keeps the thread
+ * responsive without reposting unconditionally.
+ *
+ * @returns @c true if the current handler has run for at least
+ * @c ASIO_HANDLER_YIELD_USEC microseconds (1ms by default) and other handlers
+ * of the same execution context are waiting to run. Returns @c false if the
+ * calling thread is not running a handler of an io_context or thread_pool.
+ *
+ * @note The running time is measured from the handler's first call to this
+ * function, and starts again each time the function returns @c true, so the
+ * clock is read only by handlers that ask. If @c ASIO_ENABLE_HANDLER_YIELD is
+ * defined, the start of each handler is instead recorded using a cheap clock
+ * with a resolution of a few milliseconds, and the running time is measured
+ * from the start of the handler. Time that this clock cannot resolve is not
+ * counted.
+ */
+inline bool this_thread_should_yield()
+{
+  return detail::thread_context::this_thread_should_yield(
+      ASIO_HANDLER_YIELD_USEC);
+}
+
+/// Determine whether the handler running on the current thread should yield
+/// to other work.
+/**
+ * @param rel_time The time for which the handler may run while other work is
+ * waiting.
+ *
+ * @returns @c true if the current handler has run for at least @c rel_time
+ * and other handlers of the same execution context are waiting to run.
+ */
+template <typename Rep, typename Period>
+inline bool this_thread_should_yield(
+    const chrono::duration<Rep, Period>& rel_time)
+{
+  return detail::thread_context::this_thread_should_yield(
+      static_cast<long>(chrono::duration_cast<
+        chrono::microseconds>(rel_time).count()));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_THIS_THREAD_SHOULD_YIELD_HPP
@@ -16,9 +16,14 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <exception>
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/elastic_thread_group.hpp"
+#include "asio/detail/is_affine_executor.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/thread_group.hpp"
+#include "asio/async_result.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
 
@@ -36,11 +41,14 @@ namespace detail {
   };
 } // namespace detail
 
-/// A simple fixed-size thread pool.
+/// A simple thread pool.
 /**
  * The thread pool class is an execution context where functions are permitted
  * to run on one of a fixed number of threads.
  *
+ * An elastic pool may instead be created, where the number of threads varies
+ * between a minimum and a maximum with the load on the pool.
+ *
  * @par Submitting tasks to the pool
  *
  * To submit functions to the thread pool, use the @ref asio::dispatch,
@@ -92,6 +100,51 @@ public:
   /// Constructs a pool with a specified number of threads.
   ASIO_DECL thread_pool(std::size_t num_threads);
 
+  /// Constructs an elastic pool.
+  /**
+   * Equivalent to constructing an elastic pool with a growth latency of 20
+   * milliseconds and an idle timeout of 10 seconds.
+   *
+   * @param min_threads The number of threads that the pool always keeps.
+   *
+   * @param max_threads The maximum number of threads in the pool.
+   *
+   * @throws std::out_of_range Thrown if @c max_threads is zero or less than
+   * @c min_threads.
+   */
+  ASIO_DECL thread_pool(std::size_t min_threads, std::size_t max_threads);
+
+  /// Constructs an elastic pool.
+  /**
+   * The pool starts @c min_threads threads. Whenever submitted functions stay
+   * queued for @c growth_latency without any thread becoming idle, such as
+   * when all threads are busy or blocked, the pool adds a thread, up to @c
+   * max_threads. A thread that has had no work to do for @c idle_timeout
+   * exits, unless the pool would be left with fewer than @c min_threads
+   * threads.
+   *
+   * @param min_threads The number of threads that the pool always keeps.
+   *
+   * @param max_threads The maximum number of threads in the pool.
+   *
+   * @param growth_latency How long functions may wait to run before the pool
+   * adds a thread.
+   *
+   * @param idle_timeout How long a thread may be idle before it exits.
+   *
+   * @throws std::out_of_range Thrown if @c max_threads is zero or less than
+   * @c min_threads.
+   */
+  template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+  thread_pool(std::size_t min_threads, std::size_t max_threads,
+      const chrono::duration<Rep1, Period1>& growth_latency,
+      const chrono::duration<Rep2, Period2>& idle_timeout)
+    : thread_pool(min_threads, max_threads,
+        thread_pool::to_usec(growth_latency),
+        thread_pool::to_usec(idle_timeout))
+  {
+  }
+
   /// Destructor.
   /**
    * Automatically stops and joins the pool, if not explicitly done beforehand.
@@ -135,12 +188,32 @@ public:
    */
   ASIO_DECL void wait();
 
+  /// Get the number of threads in the pool.
+  /**
+   * Includes threads that have been attached to the pool. For an elastic pool,
+   * the number changes as threads are added and exit.
+   */
+  ASIO_DECL std::size_t num_threads() const;
+
 private:
   thread_pool(const thread_pool&) = delete;
   thread_pool& operator=(const thread_pool&) = delete;
 
   struct thread_function;
 
+  // Constructs an elastic pool.
+  ASIO_DECL thread_pool(std::size_t min_threads, std::size_t max_threads,
+      long growth_latency_usec, long idle_timeout_usec);
+
+  // Helper function to convert a duration to microseconds.
+  template <typename Rep, typename Period>
+  static long to_usec(const chrono::duration<Rep, Period>& d)
+  {
+    double usec = chrono::duration<double, std::micro>(d).count();
+    return usec <= 0 ? 0 : usec >= 0x7FFFFFFF
+      ? 0x7FFFFFFFL : static_cast<long>(usec);
+  }
+
   // Helper function to create the underlying scheduler.
   ASIO_DECL detail::scheduler& add_scheduler(detail::scheduler* s);
 
@@ -150,8 +223,11 @@ private:
   // The threads in the pool.
   detail::thread_group threads_;
 
-  // The current number of threads in the pool.
+  // The current number of threads in the pool, not including elastic threads.
   detail::atomic_count num_threads_;
+
+  // The threads of an elastic pool, or null if the pool has a fixed size.
+  detail::elastic_thread_group* elastic_threads_;
 };
 
 /// Executor implementation type used to submit functions to a thread pool.
@@ -542,6 +618,71 @@ public:
         integral_constant<bool, (Bits & blocking_always) != 0>());
   }
 
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  class initiate_bulk_execute;
+
+public:
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+  /// Start an asynchronous operation to call a function for each index in a
+  /// range.
+  /**
+   * This function calls the function object @c f once for each index in the
+   * range <tt>[0, n)</tt>, using the threads of the pool, and completes the
+   * handler once all calls have returned. Unlike submitting @c n separate
+   * function objects, a single operation is allocated and queued for the
+   * whole range. The threads that pick up the operation claim chunks of
+   * indices until the range is exhausted, and the number of threads taking
+   * part is limited to the number of threads in the pool. The function is
+   * never called from the current thread prior to returning from
+   * @c bulk_execute().
+   *
+   * @param n The number of indices. If @c n is zero the handler is completed
+   * without calling the function.
+   *
+   * @param f The function object to be called. It is called concurrently from
+   * the threads of the pool, and its signature must be:
+   * @code void function(std::size_t index); @endcode
+   * If a call to the function exits via an exception, no further indices are
+   * claimed, the calls already under way are allowed to finish, and the first
+   * exception is passed to the completion handler.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when all indices have been
+   * processed. The function signature of the completion handler must be:
+   * @code void handler(
+   *   std::exception_ptr e // The exception thrown by the function, if any.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(std::exception_ptr) @endcode
+   *
+   * @par Example
+   * @code std::vector<block> blocks = ...;
+   * std::vector<std::uint32_t> checksums(blocks.size());
+   * pool.get_executor().bulk_execute(blocks.size(),
+   *     [&](std::size_t i){ checksums[i] = checksum(blocks[i]); },
+   *     [&](std::exception_ptr e){ if (!e) send_checksums(checksums); });
+   * @endcode
+   */
+  template <typename Function,
+      ASIO_COMPLETION_TOKEN_FOR(void(std::exception_ptr)) CompletionToken>
+  auto bulk_execute(std::size_t n, Function&& f, CompletionToken&& token) const
+    -> decltype(
+      async_initiate<CompletionToken, void(std::exception_ptr)>(
+        declval<initiate_bulk_execute>(), token,
+        n, static_cast<Function&&>(f)))
+  {
+    return async_initiate<CompletionToken, void(std::exception_ptr)>(
+        initiate_bulk_execute(*this), token,
+        n, static_cast<Function&&>(f));
+  }
+
 public:
 #if !defined(ASIO_NO_TS_EXECUTORS)
   /// Obtain the underlying execution context.
@@ -651,6 +792,11 @@ private:
   template <typename Function>
   void do_execute(Function&& f, true_type) const;
 
+  /// Bulk execution helper implementation.
+  template <typename Handler, typename Function>
+  void do_bulk_execute(Handler& handler,
+      std::size_t n, Function& f) const;
+
   // The underlying thread pool.
   thread_pool* pool_;
 
@@ -949,6 +1095,16 @@ struct is_executor<thread_pool> : false_type
 
 } // namespace execution
 
+namespace detail {
+
+template <typename Allocator, uintptr_t Bits>
+struct is_affine_executor<thread_pool::basic_executor_type<Allocator, Bits>>
+  : true_type
+{
+};
+
+} // namespace detail
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 } // namespace asio
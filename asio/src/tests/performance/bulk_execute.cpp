@@ -0,0 +1,120 @@
+//
+// bulk_execute.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+// A small block of data to be checksummed.
+struct block
+{
+  unsigned char data[64];
+};
+
+unsigned int checksum(const block& b)
+{
+  unsigned int sum = 0;
+  for (std::size_t i = 0; i < sizeof(b.data); ++i)
+    sum = sum * 31 + b.data[i];
+  return sum;
+}
+
+// Checksums one block.
+struct checksum_item
+{
+  const std::vector<block>* blocks_;
+  std::vector<unsigned int>* checksums_;
+  std::size_t index_;
+
+  void operator()()
+  {
+    (*checksums_)[index_] = checksum((*blocks_)[index_]);
+  }
+};
+
+// Checksums the block at the given index.
+struct checksum_index
+{
+  const std::vector<block>* blocks_;
+  std::vector<unsigned int>* checksums_;
+
+  void operator()(std::size_t i) const
+  {
+    (*checksums_)[i] = checksum((*blocks_)[i]);
+  }
+};
+
+struct bulk_complete
+{
+  void operator()(std::exception_ptr e) const
+  {
+    if (e)
+      std::fprintf(stderr, "bulk_execute failed\n");
+  }
+};
+
+void report(const char* name,
+    std::chrono::steady_clock::duration elapsed, std::size_t items)
+{
+  std::printf("%-20s %8.1f ns per item\n", name,
+      std::chrono::duration<double, std::nano>(elapsed).count() / items);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr, "Usage: bulk_execute <items> <threads>\n");
+    return 1;
+  }
+
+  std::size_t items = std::atoi(argv[1]);
+  std::size_t threads = std::atoi(argv[2]);
+
+  std::vector<block> blocks(items);
+  for (std::size_t i = 0; i < items; ++i)
+    for (std::size_t j = 0; j < sizeof(blocks[i].data); ++j)
+      blocks[i].data[j] = static_cast<unsigned char>(i + j);
+  std::vector<unsigned int> checksums(items);
+
+  {
+    asio::thread_pool pool(threads);
+
+    std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < items; ++i)
+    {
+      checksum_item item = { &blocks, &checksums, i };
+      asio::post(pool, item);
+    }
+    pool.wait();
+
+    report("post per item", std::chrono::steady_clock::now() - start, items);
+  }
+
+  {
+    asio::thread_pool pool(threads);
+
+    std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+
+    checksum_index f = { &blocks, &checksums };
+    pool.executor().bulk_execute(items, f, bulk_complete());
+    pool.wait();
+
+    report("bulk_execute", std::chrono::steady_clock::now() - start, items);
+  }
+
+  return 0;
+}
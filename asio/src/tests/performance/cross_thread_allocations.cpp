@@ -0,0 +1,98 @@
+//
+// cross_thread_allocations.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// A handler that is allocated on the producer thread and freed on the
+// consumer thread, with a payload that gives it a realistic size.
+struct consume_handler
+{
+  std::atomic<int>* consumed_;
+  char payload_[160];
+
+  void operator()()
+  {
+    consumed_->fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+// Posts handlers to the consumer in rounds, waiting for each round to be
+// consumed so that the number of handlers in flight stays bounded.
+struct produce_handler
+{
+  asio::io_context::executor_type consumer_;
+  std::atomic<int>* consumed_;
+  int rounds_;
+  int round_size_;
+
+  void operator()()
+  {
+    for (int i = 0; i < rounds_; ++i)
+    {
+      for (int j = 0; j < round_size_; ++j)
+      {
+        consume_handler handler = { consumed_, { 0 } };
+        asio::post(consumer_, handler);
+      }
+
+      int target = (i + 1) * round_size_;
+      while (consumed_->load(std::memory_order_relaxed) < target)
+        std::this_thread::yield();
+    }
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: cross_thread_allocations <rounds> <round_size>\n");
+    return 1;
+  }
+
+  int rounds = std::atoi(argv[1]);
+  int round_size = std::atoi(argv[2]);
+
+  asio::io_context producer(1);
+  asio::io_context consumer(1);
+  asio::executor_work_guard<asio::io_context::executor_type> work
+    = asio::make_work_guard(consumer);
+  std::thread consumer_thread([&]{ consumer.run(); });
+
+  std::atomic<int> consumed(0);
+  produce_handler handler = { consumer.get_executor(),
+    &consumed, rounds, round_size };
+
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  asio::post(producer, handler);
+  producer.run();
+
+  std::chrono::steady_clock::duration elapsed
+    = std::chrono::steady_clock::now() - start;
+
+  work.reset();
+  consumer_thread.join();
+
+  int total = rounds * round_size;
+  std::printf("%d handlers of %d bytes\n", total,
+      static_cast<int>(sizeof(consume_handler)));
+  std::printf("%.1f ns per handler\n",
+      std::chrono::duration<double, std::nano>(elapsed).count() / total);
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+//
+// executor_erasure.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Posts itself to the executor until the count reaches zero. The io_context
+// is then stopped, as a tracked executor keeps it from running out of work.
+template <typename Executor>
+struct repost_handler
+{
+  Executor ex_;
+  int* remaining_;
+  asio::io_context* io_context_;
+
+  void operator()()
+  {
+    if (--*remaining_ > 0)
+      asio::post(ex_, *this);
+    else
+      io_context_->stop();
+  }
+};
+
+template <typename Executor>
+void run_test(const char* name, asio::io_context& io_context,
+    const Executor& ex, int iterations)
+{
+  int remaining = iterations;
+  repost_handler<Executor> handler = { ex, &remaining, &io_context };
+
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  asio::post(ex, handler);
+  io_context.restart();
+  io_context.run();
+
+  std::chrono::steady_clock::duration elapsed
+    = std::chrono::steady_clock::now() - start;
+
+  std::printf("%-36s %8.1f ns per post\n", name,
+      std::chrono::duration<double, std::nano>(elapsed).count() / iterations);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: executor_erasure <iterations>\n");
+    return 1;
+  }
+
+  int iterations = std::atoi(argv[1]);
+
+  asio::io_context io_context(1);
+  asio::io_context::executor_type ex = io_context.get_executor();
+  asio::strand<asio::io_context::executor_type> s(ex);
+
+  // The base of any_io_executor has the same properties but always performs
+  // type erasure.
+  typedef asio::any_io_executor::base_type erased_executor;
+
+  run_test("io_context::executor_type", io_context, ex, iterations);
+  run_test("any_io_executor(io_context)", io_context,
+      asio::any_io_executor(ex), iterations);
+  run_test("erased any_executor(io_context)", io_context,
+      erased_executor(ex), iterations);
+  run_test("any_io_executor(tracked io_context)", io_context,
+      asio::any_io_executor(asio::prefer(ex,
+          asio::execution::outstanding_work.tracked)), iterations);
+  run_test("strand", io_context, s, iterations);
+  run_test("any_io_executor(strand)", io_context,
+      asio::any_io_executor(s), iterations);
+  run_test("erased any_executor(strand)", io_context,
+      erased_executor(s), iterations);
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+//
+// transfer_allocations.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using asio::ip::tcp;
+
+// Counts the number of allocations and bytes allocated through it.
+struct allocation_stats
+{
+  std::size_t allocations;
+  std::size_t bytes;
+};
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(allocation_stats* stats)
+    : stats_(stats)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : stats_(other.stats_)
+  {
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return stats_ == other.stats_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return stats_ != other.stats_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++stats_->allocations;
+    stats_->bytes += sizeof(T) * n;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  allocation_stats* stats_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: transfer_allocations <buffers> <buffer_size> <transfers>\n");
+    return 1;
+  }
+
+  std::size_t buffer_count = std::atoi(argv[1]);
+  std::size_t buffer_size = std::atoi(argv[2]);
+  int transfers = std::atoi(argv[3]);
+
+  asio::io_context io_context;
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket writer(io_context);
+  writer.connect(acceptor.local_endpoint());
+  tcp::socket reader = acceptor.accept();
+
+  // A small send buffer forces each transfer to take many steps.
+  writer.set_option(tcp::socket::send_buffer_size(16384));
+  writer.set_option(tcp::no_delay(true));
+
+  std::vector<char> write_data(buffer_count * buffer_size, 'x');
+  std::vector<char> read_data(buffer_count * buffer_size);
+  std::vector<asio::const_buffer> write_buffers;
+  std::vector<asio::mutable_buffer> read_buffers;
+  for (std::size_t i = 0; i < buffer_count; ++i)
+  {
+    write_buffers.push_back(
+        asio::buffer(&write_data[i * buffer_size], buffer_size));
+    read_buffers.push_back(
+        asio::buffer(&read_data[i * buffer_size], buffer_size));
+  }
+
+  allocation_stats write_stats = { 0, 0 };
+  allocation_stats read_stats = { 0, 0 };
+  std::size_t total_bytes = 0;
+
+  for (int i = 0; i < transfers; ++i)
+  {
+    asio::async_write(writer, write_buffers,
+        asio::bind_allocator(counting_allocator<void>(&write_stats),
+          [&](asio::error_code ec, std::size_t n)
+          {
+            if (ec) std::fprintf(stderr, "write: %s\n", ec.message().c_str());
+            total_bytes += n;
+          }));
+
+    asio::async_read(reader, read_buffers,
+        asio::bind_allocator(counting_allocator<void>(&read_stats),
+          [&](asio::error_code ec, std::size_t)
+          {
+            if (ec) std::fprintf(stderr, "read: %s\n", ec.message().c_str());
+          }));
+
+    io_context.restart();
+    io_context.run();
+  }
+
+  std::printf("%d transfers of %d bytes in %d buffers\n", transfers,
+      static_cast<int>(buffer_count * buffer_size),
+      static_cast<int>(buffer_count));
+  std::printf("%.1f allocations, %.1f bytes allocated per async_write\n",
+      static_cast<double>(write_stats.allocations) / transfers,
+      static_cast<double>(write_stats.bytes) / transfers);
+  std::printf("%.1f allocations, %.1f bytes allocated per async_read\n",
+      static_cast<double>(read_stats.allocations) / transfers,
+      static_cast<double>(read_stats.bytes) / transfers);
+  std::printf("%d total bytes written\n", static_cast<int>(total_bytes));
+
+  return 0;
+}
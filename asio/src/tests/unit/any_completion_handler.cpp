@@ -19,6 +19,7 @@
 #include "unit_test.hpp"
 
 #include <functional>
+#include <memory>
 #include "asio/bind_allocator.hpp"
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/bind_executor.hpp"
@@ -250,6 +251,177 @@ void any_completion_handler_invocation_test()
   ASIO_CHECK(count == 2);
 }
 
+struct large_handler
+{
+  int* count_;
+  char data_[256];
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+struct throwing_move_handler
+{
+  int* count_;
+
+  throwing_move_handler(int* count)
+    : count_(count)
+  {
+  }
+
+  throwing_move_handler(const throwing_move_handler& other)
+    : count_(other.count_)
+  {
+  }
+
+  throwing_move_handler(throwing_move_handler&& other) noexcept(false)
+    : count_(other.count_)
+  {
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+void inline_any_completion_handler_test()
+{
+  typedef asio::inline_any_completion_handler<64, void()> handler_type;
+
+  int count = 0;
+  int alloc_count = 0;
+  asio::nullptr_t null_ptr = asio::nullptr_t();
+
+  handler_type h1;
+
+  ASIO_CHECK(!h1);
+  ASIO_CHECK(h1 == null_ptr);
+  ASIO_CHECK(!h1.is_inline());
+
+  // Small targets are stored inline, without using the associated allocator.
+  handler_type h2(
+      asio::bind_allocator(handler_allocator<char>(&alloc_count),
+        bindns::bind(&increment, &count)));
+
+  ASIO_CHECK(!!h2);
+  ASIO_CHECK(h2.is_inline());
+  ASIO_CHECK(alloc_count == 0);
+
+  handler_type h3(std::move(h2));
+
+  ASIO_CHECK(!h2);
+  ASIO_CHECK(!!h3);
+  ASIO_CHECK(h3.is_inline());
+
+  // The associated allocator is still available to the operation.
+  ASIO_REBIND_ALLOC(asio::associated_allocator<handler_type>::type,
+      char) alloc1(asio::get_associated_allocator(h3));
+  alloc1.deallocate(alloc1.allocate(1), 1);
+
+  ASIO_CHECK(alloc_count == 1);
+
+  std::move(h3)();
+
+  ASIO_CHECK(!h3);
+  ASIO_CHECK(count == 1);
+
+  // Large targets fall back to the associated allocator.
+  large_handler large = { &count, { 0 } };
+  handler_type h4(
+      asio::bind_allocator(handler_allocator<char>(&alloc_count), large));
+
+  ASIO_CHECK(!!h4);
+  ASIO_CHECK(!h4.is_inline());
+  ASIO_CHECK(alloc_count == 2);
+
+  handler_type h5(bindns::bind(&increment, &count));
+  h5.swap(h4);
+
+  ASIO_CHECK(h4.is_inline());
+  ASIO_CHECK(!h5.is_inline());
+
+  std::move(h4)();
+  std::move(h5)();
+
+  ASIO_CHECK(count == 3);
+
+  // Targets whose move constructor may throw are not stored inline, as the
+  // wrapper's move operations must not throw.
+  throwing_move_handler throwing(&count);
+  handler_type h8(throwing);
+
+  ASIO_CHECK(!!h8);
+  ASIO_CHECK(!h8.is_inline());
+
+  handler_type h9(std::move(h8));
+
+  ASIO_CHECK(!h8);
+  ASIO_CHECK(!h9.is_inline());
+
+  std::move(h9)();
+
+  ASIO_CHECK(count == 4);
+
+  // Targets that are not invoked are destroyed.
+  std::shared_ptr<int> p(new int(0));
+  handler_type h6([p]{});
+  handler_type h7;
+  h7 = std::move(h6);
+
+  ASIO_CHECK(p.use_count() == 2);
+
+  h7 = null_ptr;
+
+  ASIO_CHECK(!h7);
+  ASIO_CHECK(p.use_count() == 1);
+}
+
+void inline_any_completion_handler_associator_test()
+{
+  typedef asio::inline_any_completion_handler<
+    128, void(asio::error_code)> handler_type;
+
+  int count = 0;
+  int cancel_count = 0;
+  asio::error_code ec;
+  asio::thread_pool pool(1);
+  asio::cancellation_signal sig;
+
+  handler_type h1(
+      asio::bind_cancellation_slot(sig.slot(),
+        asio::bind_executor(pool.get_executor(),
+          bindns::bind(&increment_with_error,
+            bindns::placeholders::_1, &ec, &count))));
+
+  ASIO_CHECK(h1.is_inline());
+
+  // The cancellation state remains connected when the target is moved.
+  handler_type h2(std::move(h1));
+
+  asio::associated_cancellation_slot<handler_type>::type slot1
+    = asio::get_associated_cancellation_slot(h2);
+
+  ASIO_CHECK(slot1.is_connected());
+
+  slot1.emplace<cancel_handler>(&cancel_count);
+  sig.emit(asio::cancellation_type::terminal);
+
+  ASIO_CHECK(cancel_count == 1);
+
+  asio::associated_executor<handler_type>::type ex1
+    = asio::get_associated_executor(h2);
+
+  ASIO_CHECK(ex1 == pool.get_executor());
+
+  std::move(h2)(asio::error::eof);
+
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(count == 1);
+}
+
 ASIO_TEST_SUITE
 (
   "any_completion_handler",
@@ -257,4 +429,6 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(any_completion_handler_assignment_test)
   ASIO_TEST_CASE(any_completion_handler_associator_test)
   ASIO_TEST_CASE(any_completion_handler_invocation_test)
+  ASIO_TEST_CASE(inline_any_completion_handler_test)
+  ASIO_TEST_CASE(inline_any_completion_handler_associator_test)
 )
@@ -18,6 +18,8 @@
 
 #include <cstring>
 #include <functional>
+#include "asio/io_context.hpp"
+#include "asio/strand.hpp"
 #include "asio/system_executor.hpp"
 #include "asio/thread_pool.hpp"
 #include "unit_test.hpp"
@@ -148,6 +150,13 @@ void increment(int* count)
   ++(*count);
 }
 
+void increment_in_strand(
+    const asio::strand<asio::io_context::executor_type>* s, int* count)
+{
+  if (s->running_in_this_thread())
+    ++(*count);
+}
+
 void any_io_executor_construction_test()
 {
   thread_pool pool(1);
@@ -503,6 +512,113 @@ void any_io_executor_execute_test()
   ASIO_CHECK(count == 6);
 }
 
+void execute_possibly(const asio::any_io_executor* ex, int* count)
+{
+  // The function is run inline as we are inside the io_context.
+  int before = *count;
+  asio::prefer(*ex, asio::execution::blocking.possibly).execute(
+      bindns::bind(increment, count));
+  if (*count == before + 1)
+    ++(*count);
+}
+
+void any_io_executor_io_context_execute_test()
+{
+  int count = 0;
+  io_context ioc;
+  asio::any_io_executor ex(ioc.get_executor());
+
+  ex.execute(bindns::bind(increment, &count));
+
+  asio::require(ex, asio::execution::blocking.never).execute(
+      bindns::bind(increment, &count));
+
+  asio::require(
+      asio::prefer(ex, asio::execution::outstanding_work.tracked),
+      asio::execution::blocking.never
+    ).execute(bindns::bind(increment, &count));
+
+  asio::require(
+      asio::prefer(ex,
+        asio::execution::outstanding_work.untracked,
+        asio::execution::relationship.continuation),
+      asio::execution::blocking.never
+    ).execute(bindns::bind(increment, &count));
+
+  ex.execute(bindns::bind(execute_possibly, &ex, &count));
+
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 6);
+
+  count = 0;
+  asio::strand<io_context::executor_type> s(ioc.get_executor());
+  asio::any_io_executor ex2(s);
+
+  ex2.execute(bindns::bind(increment_in_strand, &s, &count));
+
+  asio::require(
+      asio::prefer(ex2, asio::execution::outstanding_work.tracked),
+      asio::execution::blocking.never
+    ).execute(bindns::bind(increment_in_strand, &s, &count));
+
+  ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+
+  typedef io_context::basic_executor_type<std::allocator<void>,
+    asio::detail::io_context_bits::outstanding_work_tracked> tracked_type;
+
+  count = 0;
+  {
+    asio::any_io_executor ex4 = asio::prefer(
+        ex, asio::execution::outstanding_work.tracked);
+
+    ASIO_CHECK(ex4.target<tracked_type>() != 0);
+    ASIO_CHECK(asio::prefer(ex4, asio::execution::outstanding_work.untracked)
+        .target<io_context::executor_type>() != 0);
+    ASIO_CHECK(asio::require(ex4, asio::execution::blocking.never)
+        .target<tracked_type>() != 0);
+
+    ex4.execute(bindns::bind(increment, &count));
+
+    asio::strand<tracked_type> s2(*ex4.target<tracked_type>());
+    asio::any_io_executor ex5(s2);
+
+    ex5.execute(bindns::bind(increment, &count));
+
+    asio::prefer(ex5, asio::execution::relationship.continuation).execute(
+        bindns::bind(increment, &count));
+
+    ASIO_CHECK(asio::prefer(ex5, asio::execution::outstanding_work.untracked)
+        .target<asio::strand<io_context::executor_type>>() != 0);
+  }
+
+  ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+
+  asio::any_io_executor ex3;
+  bool caught = false;
+  try
+  {
+    ex3.execute(bindns::bind(increment, &count));
+  }
+  catch (const asio::execution::bad_executor&)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+}
+
 ASIO_TEST_SUITE
 (
   "any_io_executor",
@@ -512,4 +628,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(any_io_executor_swap_test)
   ASIO_TEST_CASE(any_io_executor_query_test)
   ASIO_TEST_CASE(any_io_executor_execute_test)
+  ASIO_TEST_CASE(any_io_executor_io_context_execute_test)
 )
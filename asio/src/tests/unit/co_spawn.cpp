@@ -20,10 +20,17 @@
 
 #if defined(ASIO_HAS_CO_AWAIT)
 
+#include <atomic>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 #include "asio/any_completion_handler.hpp"
 #include "asio/bind_cancellation_slot.hpp"
+#include "asio/detail/coroutine_frame_stack.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/use_awaitable.hpp"
 
 asio::awaitable<void> void_returning_coroutine()
 {
@@ -115,11 +122,158 @@ void test_co_spawn_immediate_cancel()
   ASIO_CHECK(result != nullptr);
 }
 
+asio::awaitable<int> nested_coroutine(int depth)
+{
+  if (depth == 0)
+  {
+    co_await asio::post(co_await asio::this_coro::executor,
+        asio::use_awaitable);
+    co_return 1;
+  }
+
+  char local_data[64] = { 0 };
+  int result = co_await nested_coroutine(depth - 1);
+  co_await asio::post(co_await asio::this_coro::executor,
+      asio::use_awaitable);
+  co_return result + 1 + local_data[depth];
+}
+
+void test_co_spawn_interleaved_nested_frames()
+{
+  asio::io_context ctx;
+
+  // Many interleaved coroutines free their frames out of order, and running
+  // the context on several threads frees frames on threads other than the one
+  // that allocated them.
+  const int num_coroutines = 200;
+  std::atomic<int> total(0);
+  for (int i = 0; i < num_coroutines; ++i)
+  {
+    asio::co_spawn(ctx, nested_coroutine(i % 10),
+        [&](std::exception_ptr e, int result)
+        {
+          ASIO_CHECK(!e);
+          total += result;
+        });
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&]{ ctx.run(); });
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  int expected = 0;
+  for (int i = 0; i < num_coroutines; ++i)
+    expected += i % 10 + 1;
+  ASIO_CHECK(total == expected);
+}
+
+// Allocate a frame from the stack, or from the heap if the stack cannot hold
+// it.
+void* allocate_frame(asio::detail::coroutine_frame_stack& stack,
+    std::size_t size)
+{
+  using asio::detail::coroutine_frame_stack;
+
+  if (void* frame = coroutine_frame_stack::allocate(&stack, size))
+    return frame;
+
+  return coroutine_frame_stack::unowned_frame(
+      ::operator new(coroutine_frame_stack::unowned_frame_size(size)));
+}
+
+void deallocate_frame(asio::detail::coroutine_frame_stack& stack,
+    void* frame, std::size_t size)
+{
+  using asio::detail::coroutine_frame_stack;
+
+  if (void* memory = coroutine_frame_stack::deallocate(&stack, frame, size))
+    ::operator delete(memory);
+}
+
+void test_co_spawn_long_lived_frames()
+{
+  using asio::detail::coroutine_frame_stack;
+
+  coroutine_frame_stack stack;
+  std::vector<void*> long_lived;
+  const std::size_t frame_size = 1024;
+
+  // Short-lived frames freed out of order leave holes below the top of the
+  // current chunk, and each long-lived frame pins the chunk it is allocated
+  // from. The stack must not hold on to more than two chunks.
+  for (int i = 0; i < 2000; ++i)
+  {
+    if (i % 10 == 0)
+      long_lived.push_back(allocate_frame(stack, frame_size));
+
+    void* a = allocate_frame(stack, frame_size);
+    void* b = allocate_frame(stack, frame_size);
+    deallocate_frame(stack, a, frame_size);
+    deallocate_frame(stack, b, frame_size);
+
+    ASIO_CHECK(stack.bytes_reserved() <= 2 * coroutine_frame_stack::chunk_size);
+  }
+
+  for (std::size_t i = 0; i < long_lived.size(); ++i)
+    deallocate_frame(stack, long_lived[i], frame_size);
+
+  // Once the long-lived frames are gone, frames come from a chunk again.
+  void* p = coroutine_frame_stack::allocate(&stack, frame_size);
+  ASIO_CHECK(p != 0);
+  ASIO_CHECK(stack.bytes_in_use() > 0);
+  deallocate_frame(stack, p, frame_size);
+
+  stack.trim();
+  ASIO_CHECK(stack.bytes_reserved() == 0);
+}
+
+void test_co_spawn_pinned_frame_allocations()
+{
+  using asio::detail::coroutine_frame_stack;
+  using asio::detail::thread_info_base;
+
+  thread_info_base this_thread;
+  std::vector<void*> long_lived;
+  const std::size_t frame_size = 1024;
+
+  // Fill both of the thread's chunks with long-lived frames.
+  while (long_lived.size() * frame_size < 2 * coroutine_frame_stack::chunk_size)
+  {
+    long_lived.push_back(
+        thread_info_base::allocate_frame(&this_thread, frame_size));
+  }
+
+  // While the chunks are pinned, frames are recycled through the thread's
+  // cache, so only the first frames allocate from the heap.
+  std::size_t misses = this_thread.statistics().misses;
+  for (int i = 0; i < 1000; ++i)
+  {
+    void* a = thread_info_base::allocate_frame(&this_thread, frame_size);
+    void* b = thread_info_base::allocate_frame(&this_thread, frame_size);
+    thread_info_base::deallocate_frame(&this_thread, a, frame_size);
+    thread_info_base::deallocate_frame(&this_thread, b, frame_size);
+  }
+  ASIO_CHECK(this_thread.statistics().misses - misses <= 2);
+  ASIO_CHECK(this_thread.statistics().hits >= 1998);
+  ASIO_CHECK(this_thread.statistics().oversized == 0);
+
+  for (std::size_t i = 0; i < long_lived.size(); ++i)
+  {
+    thread_info_base::deallocate_frame(
+        &this_thread, long_lived[i], frame_size);
+  }
+}
+
 ASIO_TEST_SUITE
 (
   "co_spawn",
   ASIO_TEST_CASE(test_co_spawn_with_any_completion_handler)
   ASIO_TEST_CASE(test_co_spawn_immediate_cancel)
+  ASIO_TEST_CASE(test_co_spawn_interleaved_nested_frames)
+  ASIO_TEST_CASE(test_co_spawn_long_lived_frames)
+  ASIO_TEST_CASE(test_co_spawn_pinned_frame_allocations)
 )
 
 #else // defined(ASIO_HAS_CO_AWAIT)
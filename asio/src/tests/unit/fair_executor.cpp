@@ -0,0 +1,157 @@
+//
+// fair_executor.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/fair_executor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+
+namespace bindns = std;
+
+typedef fair_executor<io_context::executor_type> fair_io_executor;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void check_running(const fair_io_executor* ex, int* count)
+{
+  ASIO_CHECK(ex->running_in_this_thread());
+  ++(*count);
+}
+
+void record(std::string* order, char c)
+{
+  *order += c;
+}
+
+void fair_executor_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  fair_io_executor ex = make_fair_executor(ioc);
+  ASIO_CHECK(ex.weight() == 1);
+  ASIO_CHECK(ex.concurrency() == 1);
+  ASIO_CHECK(!ex.running_in_this_thread());
+  ASIO_CHECK(ex == ex);
+  ASIO_CHECK(ex != make_fair_executor(ioc));
+
+  ASIO_CHECK(
+      asio::query(ex, execution::blocking) == execution::blocking.never);
+  ASIO_CHECK(&asio::query(ex, execution::context) == &ioc);
+
+  ex.execute(bindns::bind(increment, &count));
+  asio::post(ex, bindns::bind(check_running, &ex, &count));
+  asio::prefer(ex, execution::outstanding_work.tracked).execute(
+      bindns::bind(increment, &count));
+
+  // No function is run inside execute().
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+}
+
+void fair_executor_round_robin_test()
+{
+  io_context ioc;
+  std::string order;
+
+  // A burst of work from one fair executor does not delay another.
+  fair_io_executor ex1 = make_fair_executor(ioc);
+  fair_io_executor ex2 = make_fair_executor(ioc);
+  for (int i = 0; i < 6; ++i)
+    asio::post(ex1, bindns::bind(record, &order, 'a'));
+  for (int i = 0; i < 2; ++i)
+    asio::post(ex2, bindns::bind(record, &order, 'b'));
+
+  ioc.run();
+
+  ASIO_CHECK(order == "ababaaaa");
+
+  // A weighted fair executor runs several functions per turn.
+  order.clear();
+  ioc.restart();
+  fair_io_executor ex3 = make_fair_executor(ioc.get_executor(), 3);
+  ASIO_CHECK(ex3.weight() == 3);
+  for (int i = 0; i < 6; ++i)
+    asio::post(ex3, bindns::bind(record, &order, 'c'));
+  for (int i = 0; i < 3; ++i)
+    asio::post(ex1, bindns::bind(record, &order, 'a'));
+
+  ioc.run();
+
+  ASIO_CHECK(order == "cccacccaa");
+}
+
+void track_concurrency(std::atomic<int>* active,
+    std::atomic<int>* max_active, std::atomic<int>* count)
+{
+  int n = ++(*active);
+  int m = max_active->load();
+  while (n > m && !max_active->compare_exchange_weak(m, n)) {}
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  --(*active);
+  ++(*count);
+}
+
+void fair_executor_concurrency_test()
+{
+  thread_pool pool(4);
+  std::atomic<int> active(0);
+  std::atomic<int> max_active(0);
+  std::atomic<int> count(0);
+
+  fair_executor<thread_pool::executor_type> ex
+    = make_fair_executor(pool, 1, 2);
+  ASIO_CHECK(ex.concurrency() == 2);
+
+  for (int i = 0; i < 50; ++i)
+    asio::post(ex, bindns::bind(track_concurrency,
+          &active, &max_active, &count));
+
+  pool.join();
+
+  ASIO_CHECK(count == 50);
+  ASIO_CHECK(max_active <= 2);
+}
+
+ASIO_TEST_SUITE
+(
+  "fair_executor",
+  ASIO_TEST_CASE(fair_executor_test)
+  ASIO_TEST_CASE(fair_executor_round_robin_test)
+  ASIO_TEST_CASE(fair_executor_concurrency_test)
+)
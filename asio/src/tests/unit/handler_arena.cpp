@@ -0,0 +1,248 @@
+//
+// handler_arena.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/handler_arena.hpp"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "asio/bind_allocator.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+namespace bindns = std;
+
+typedef asio::io_context::basic_executor_type<
+    asio::arena_allocator<void>, 0> arena_executor;
+
+arena_executor make_arena_executor(
+    asio::io_context& ioc, asio::handler_arena* arena)
+{
+  return asio::require(ioc.get_executor(),
+      asio::execution::allocator(asio::arena_allocator<void>(arena)));
+}
+
+void handler_arena_test()
+{
+  asio::handler_arena arena(256, 2);
+
+  ASIO_CHECK(arena.slab_size() == 256);
+  ASIO_CHECK(arena.slab_count() == 2);
+  ASIO_CHECK(arena.slabs_available() == 2);
+
+  void* p1 = arena.allocate(100);
+  void* p2 = arena.allocate(256);
+  ASIO_CHECK(p1 != 0);
+  ASIO_CHECK(p2 != 0);
+  ASIO_CHECK(p1 != p2);
+  ASIO_CHECK(arena.slabs_available() == 0);
+
+  // Allocations fall back to the heap when no slab is free, or when they are
+  // too large for a slab.
+  void* p3 = arena.allocate(100);
+  void* p4 = arena.allocate(1000);
+  ASIO_CHECK(p3 != 0);
+  ASIO_CHECK(p4 != 0);
+  arena.deallocate(p3, 100);
+  arena.deallocate(p4, 1000);
+  ASIO_CHECK(arena.slabs_available() == 0);
+
+  arena.deallocate(p1, 100);
+  ASIO_CHECK(arena.slabs_available() == 1);
+
+  // A freed slab is reused.
+  void* p5 = arena.allocate(200);
+  ASIO_CHECK(p5 == p1);
+
+  arena.deallocate(p5, 200);
+  arena.deallocate(p2, 256);
+  ASIO_CHECK(arena.slabs_available() == 2);
+
+  asio::arena_allocator<int> a1(arena);
+  asio::arena_allocator<void> a2(a1);
+  asio::arena_allocator<void> a3;
+  ASIO_CHECK(a2.arena() == &arena);
+  ASIO_CHECK(a3.arena() == 0);
+  ASIO_CHECK(a2 != a3);
+  ASIO_CHECK(a2 == asio::arena_allocator<void>(arena));
+
+  int* i = a1.allocate(4);
+  ASIO_CHECK(arena.slabs_available() == 1);
+  a1.deallocate(i, 4);
+  ASIO_CHECK(arena.slabs_available() == 2);
+}
+
+void record_completion(bool* called, std::size_t* slabs_available,
+    asio::handler_arena* arena, const asio::error_code&)
+{
+  *called = true;
+  *slabs_available = arena->slabs_available();
+}
+
+void record_io_completion(bool* called, std::size_t* slabs_available,
+    asio::handler_arena* arena, const asio::error_code&, std::size_t)
+{
+  *called = true;
+  *slabs_available = arena->slabs_available();
+}
+
+void handler_arena_timer_test()
+{
+  using bindns::placeholders::_1;
+
+  asio::io_context ioc;
+  asio::handler_arena arena(512, 4);
+  bool called = false;
+  std::size_t slabs_available = 0;
+
+  asio::steady_timer::rebind_executor<arena_executor>::other t(
+      make_arena_executor(ioc, 0), asio::chrono::seconds(10));
+  ASIO_CHECK(t.arena() == 0);
+  t.set_arena(arena);
+  ASIO_CHECK(t.arena() == &arena);
+
+  t.async_wait(bindns::bind(record_completion,
+        &called, &slabs_available, &arena, _1));
+  ASIO_CHECK(arena.slabs_available() == 3);
+
+  t.cancel();
+  ioc.run();
+  ASIO_CHECK(called);
+
+  // The operation's memory is released before the handler is invoked.
+  ASIO_CHECK(slabs_available == 4);
+
+  // Handlers with their own allocator do not use the arena.
+  called = false;
+  t.expires_after(asio::chrono::seconds(10));
+  t.async_wait(
+      asio::bind_allocator(asio::recycling_allocator<void>(),
+        bindns::bind(record_completion,
+          &called, &slabs_available, &arena, _1)));
+  ASIO_CHECK(arena.slabs_available() == 4);
+
+  t.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+
+  // Once the arena is cleared, operations no longer use it.
+  t.clear_arena();
+  ASIO_CHECK(t.arena() == 0);
+  called = false;
+  t.expires_after(asio::chrono::seconds(10));
+  t.async_wait(bindns::bind(record_completion,
+        &called, &slabs_available, &arena, _1));
+  ASIO_CHECK(arena.slabs_available() == 4);
+
+  t.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+}
+
+struct arena_test_handler
+{
+  void operator()(const asio::error_code&) {}
+};
+
+template <typename Executor>
+bool is_bound_to_arena()
+{
+  typedef asio::detail::arena_bound_handler<
+    arena_test_handler, Executor> bound_handler;
+  return !std::is_same<
+      typename std::decay<
+        decltype(std::declval<bound_handler&>().value)>::type,
+      arena_test_handler>::value;
+}
+
+void handler_arena_default_executor_test()
+{
+  // Handlers are only wrapped when the I/O object's executor carries an
+  // arena, so other I/O objects keep their handler types.
+  ASIO_CHECK(!is_bound_to_arena<asio::any_io_executor>());
+  ASIO_CHECK(!is_bound_to_arena<asio::io_context::executor_type>());
+  ASIO_CHECK(is_bound_to_arena<arena_executor>());
+}
+
+void handler_arena_socket_test()
+{
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  asio::handler_arena arena(512, 4);
+
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  typedef asio::ip::tcp::socket::rebind_executor<arena_executor>::other
+    arena_socket;
+  arena_socket client(make_arena_executor(ioc, &arena));
+  arena_socket server(make_arena_executor(ioc, 0));
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  ASIO_CHECK(client.arena() == &arena);
+  server.set_arena(arena);
+
+  char read_data[16];
+  bool read_called = false;
+  std::size_t read_slabs_available = 0;
+
+  // The intermediate operations of a composed operation use the arena.
+  asio::async_read(server, asio::buffer(read_data),
+      bindns::bind(record_io_completion,
+        &read_called, &read_slabs_available, &arena, _1, _2));
+  ASIO_CHECK(arena.slabs_available() == 3);
+
+  const char write_data[16] = "0123456789abcde";
+  bool write_called = false;
+  std::size_t write_slabs_available = 0;
+
+  asio::async_write(client, asio::buffer(write_data),
+      bindns::bind(record_io_completion,
+        &write_called, &write_slabs_available, &arena, _1, _2));
+
+  ioc.run();
+
+  ASIO_CHECK(read_called);
+  ASIO_CHECK(write_called);
+  ASIO_CHECK(arena.slabs_available() == 4);
+
+  // The arena follows the socket when it is moved.
+  arena_socket moved(std::move(server));
+  ASIO_CHECK(moved.arena() == &arena);
+}
+
+ASIO_TEST_SUITE
+(
+  "handler_arena",
+  ASIO_TEST_CASE(handler_arena_test)
+  ASIO_TEST_CASE(handler_arena_timer_test)
+  ASIO_TEST_CASE(handler_arena_default_executor_test)
+  ASIO_TEST_CASE(handler_arena_socket_test)
+)
@@ -0,0 +1,138 @@
+//
+// inline_executor.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/inline_executor.hpp"
+
+#include <functional>
+#include "asio/bind_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/strand.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+
+namespace bindns = std;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void inline_executor_query_test()
+{
+  inline_executor ex;
+
+  ASIO_CHECK(
+      asio::query(ex, asio::execution::blocking)
+        == asio::execution::blocking.always);
+
+  ASIO_CHECK(
+      asio::query(ex, asio::execution::mapping)
+        == asio::execution::mapping.thread);
+
+  ASIO_CHECK(
+      asio::query(asio::require(ex, asio::execution::blocking.always),
+        asio::execution::blocking) == asio::execution::blocking.always);
+
+  ASIO_CHECK(ex == inline_executor());
+  ASIO_CHECK(!(ex != inline_executor()));
+}
+
+void inline_executor_execute_test()
+{
+  int count = 0;
+  inline_executor ex;
+
+  ex.execute(bindns::bind(increment, &count));
+  ASIO_CHECK(count == 1);
+
+  asio::prefer(ex,
+      asio::execution::outstanding_work.tracked
+    ).execute(bindns::bind(increment, &count));
+  ASIO_CHECK(count == 2);
+}
+
+void check_not_in_strand(
+    const strand<io_context::executor_type>* s,
+    int* count, bool* in_strand, const asio::error_code&)
+{
+  *in_strand = s->running_in_this_thread();
+  ++(*count);
+}
+
+void check_in_context(io_context* ctx, int* count, const asio::error_code&)
+{
+  ASIO_CHECK(ctx->get_executor().running_in_this_thread());
+  ++(*count);
+}
+
+void inline_executor_completion_test()
+{
+  io_context ctx;
+  int count = 0;
+
+  // A handler bound to the inline executor does not go through the I/O
+  // object's strand.
+  strand<io_context::executor_type> s(ctx.get_executor());
+  basic_waitable_timer<chrono::steady_clock,
+    asio::wait_traits<chrono::steady_clock>,
+    strand<io_context::executor_type>> t1(s);
+  bool in_strand = true;
+  t1.expires_after(chrono::milliseconds(0));
+  t1.async_wait(
+      asio::bind_executor(inline_executor(),
+        bindns::bind(check_not_in_strand, &s, &count,
+          &in_strand, bindns::placeholders::_1)));
+
+  // A handler bound to the I/O object's own executor runs in its io_context.
+  steady_timer t2(ctx);
+  t2.expires_after(chrono::milliseconds(0));
+  t2.async_wait(
+      asio::bind_executor(ctx.get_executor(),
+        bindns::bind(check_in_context, &ctx,
+          &count, bindns::placeholders::_1)));
+
+  // A handler bound to another io_context's executor keeps that io_context
+  // running until it has been dispatched there.
+  io_context ctx2;
+  steady_timer t3(ctx);
+  t3.expires_after(chrono::milliseconds(0));
+  t3.async_wait(
+      asio::bind_executor(ctx2.get_executor(),
+        bindns::bind(check_in_context, &ctx2,
+          &count, bindns::placeholders::_1)));
+
+  ctx.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!in_strand);
+
+  ctx2.run();
+  ASIO_CHECK(count == 3);
+}
+
+ASIO_TEST_SUITE
+(
+  "inline_executor",
+  ASIO_TEST_CASE(inline_executor_query_test)
+  ASIO_TEST_CASE(inline_executor_execute_test)
+  ASIO_TEST_CASE(inline_executor_completion_test)
+)
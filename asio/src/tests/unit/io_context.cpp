@@ -16,12 +16,26 @@
 // Test that header file is self-contained.
 #include "asio/io_context.hpp"
 
+#include <atomic>
 #include <functional>
 #include <sstream>
+#include <tuple>
+#include <string>
 #include "asio/bind_executor.hpp"
+#include "asio/connect.hpp"
+#include "asio/deferred.hpp"
 #include "asio/dispatch.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
 #include "asio/post.hpp"
+#include "asio/read.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/strand.hpp"
+#include "asio/system_error.hpp"
 #include "asio/thread.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/write.hpp"
 #include "unit_test.hpp"
 
 #if defined(ASIO_HAS_BOOST_DATE_TIME)
@@ -556,6 +570,371 @@ void io_context_executor_execute_test()
   ASIO_CHECK(count == 1);
 }
 
+void record_memory_usage(io_context* ioc,
+    execution_context::memory_usage* usage)
+{
+  *usage = ioc->get_memory_usage();
+}
+
+void io_context_memory_usage_test()
+{
+  io_context ioc;
+  execution_context::memory_usage usage1, usage2, usage3;
+  int count = 0;
+
+  ASIO_CHECK(ioc.get_memory_usage().thread_cache_bytes == 0);
+  ASIO_CHECK(ioc.get_memory_limits().thread_cache_bytes
+      == (std::numeric_limits<std::size_t>::max)());
+  ASIO_CHECK(ioc.get_memory_limits().thread_cache_depth
+      == ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE);
+
+  // Memory recycled by a thread running the context is reported, and is
+  // released by the thread when asked to trim.
+  post(ioc, bindns::bind(increment, &count));
+  post(ioc, bindns::bind(record_memory_usage, &ioc, &usage1));
+  post(ioc, bindns::bind(&io_context::trim_memory, &ioc));
+  post(ioc, bindns::bind(record_memory_usage, &ioc, &usage2));
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(usage1.thread_cache_bytes > 0);
+  ASIO_CHECK(usage2.thread_cache_bytes == 0);
+  ASIO_CHECK(ioc.get_memory_usage().thread_cache_bytes == 0);
+
+  // A thread does not cache memory beyond the limit.
+  execution_context::memory_limits limits;
+  limits.thread_cache_bytes = 0;
+  limits.thread_cache_depth = 16;
+  ioc.set_memory_limits(limits);
+  ASIO_CHECK(ioc.get_memory_limits().thread_cache_bytes == 0);
+  ASIO_CHECK(ioc.get_memory_limits().thread_cache_depth == 16);
+
+  ioc.restart();
+  post(ioc, bindns::bind(increment, &count));
+  post(ioc, bindns::bind(record_memory_usage, &ioc, &usage3));
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(usage3.thread_cache_bytes == 0);
+
+  // The per-descriptor state of a closed socket is kept for reuse.
+  ip::tcp::socket socket(ioc);
+  socket.open(ip::tcp::v4());
+  socket.close();
+  ASIO_CHECK(ioc.get_memory_usage().object_pool_bytes > 0);
+}
+
+void fan_out(io_context* ioc, std::atomic<int>* count, int depth)
+{
+  ++(*count);
+  if (depth > 0)
+  {
+    asio::post(*ioc, bindns::bind(fan_out, ioc, count, depth - 1));
+    asio::post(*ioc, bindns::bind(fan_out, ioc, count, depth - 1));
+  }
+}
+
+void wait_then_fan_out(io_context* ioc, std::atomic<int>* count,
+    int depth, const asio::error_code&)
+{
+  fan_out(ioc, count, depth);
+}
+
+void io_context_multithreaded_post_test()
+{
+  io_context ioc;
+  std::atomic<int> count(0);
+
+  // Handlers posted from other handlers keep all threads running until the
+  // last of them has finished, including those started after a wait.
+  asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 10));
+  steady_timer t(ioc, chrono::milliseconds(10));
+  t.async_wait(bindns::bind(wait_then_fan_out,
+        &ioc, &count, 10, bindns::placeholders::_1));
+
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2 * ((1 << 11) - 1));
+
+  // Work may be added to the count again after it was last deferred.
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 4));
+  ioc.run();
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == (1 << 5) - 1);
+}
+
+void io_context_reserve_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // Reserved descriptor state is used by the first I/O objects.
+  std::size_t bytes0 = ioc.get_memory_usage().object_pool_bytes;
+  ioc.reserve_descriptors(4);
+  std::size_t bytes1 = ioc.get_memory_usage().object_pool_bytes;
+#if !defined(ASIO_WINDOWS_RUNTIME) && !defined(ASIO_HAS_IOCP) \
+  && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+    || defined(ASIO_HAS_EPOLL) || defined(ASIO_HAS_KQUEUE))
+  ASIO_CHECK(bytes1 > bytes0);
+  ASIO_CHECK((bytes1 - bytes0) % 4 == 0);
+#else
+  ASIO_CHECK(bytes1 == bytes0);
+#endif
+  std::size_t state_size = (bytes1 - bytes0) / 4;
+
+  ip::tcp::socket s1(ioc), s2(ioc), s3(ioc), s4(ioc);
+  s1.open(ip::tcp::v4());
+  s2.open(ip::tcp::v4());
+  s3.open(ip::tcp::v4());
+  s4.open(ip::tcp::v4());
+  ASIO_CHECK(ioc.get_memory_usage().object_pool_bytes == bytes0);
+
+  s1.close();
+  s2.close();
+  ASIO_CHECK(ioc.get_memory_usage().object_pool_bytes
+      == bytes0 + 2 * state_size);
+
+  // Timers may be reserved before and after a clock type is first used.
+  ioc.reserve_timers(16);
+  steady_timer t1(ioc, chrono::seconds(0));
+  ioc.reserve_timers(32);
+  t1.async_wait(bindns::bind(increment, &count));
+
+  // Operation memory is placed in the shared cache, which is not trimmed by
+  // any one context.
+  ioc.reserve_operations(32, 100);
+  ASIO_CHECK(asio::get_shared_memory_usage() > 0);
+  ioc.trim_memory();
+  ASIO_CHECK(asio::get_shared_memory_usage() > 0);
+
+  for (int i = 0; i < 32; ++i)
+    post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+  ASIO_CHECK(count == 33);
+
+  asio::trim_shared_memory();
+  ASIO_CHECK(asio::get_shared_memory_usage() == 0);
+}
+
+void cancel_timer(steady_timer* t)
+{
+  t->cancel();
+}
+
+void wait_inside_handler(io_context* ioc, int* count)
+{
+  // The handler posted first has to run before the wait can complete.
+  asio::post(*ioc, bindns::bind(increment, count));
+  ioc->run_until_complete(asio::post(*ioc, deferred));
+  ASIO_CHECK(*count == 1);
+  ++(*count);
+}
+
+void post_to_strand(strand<io_context::executor_type>* s, int* count)
+{
+  asio::post(*s, bindns::bind(increment, count));
+}
+
+void wait_inside_handler_with_strand(io_context* ioc, int* count)
+{
+  // The inline strand handler posts another, so the strand is resumed from
+  // this thread's affine queue, which the wait must not hold back.
+  strand<io_context::executor_type> s(ioc->get_executor());
+  s.set_thread_affinity(true);
+  asio::dispatch(s, bindns::bind(post_to_strand, &s, count));
+  ioc->run_until_complete(asio::post(s, deferred));
+  ASIO_CHECK(*count == 1);
+  ++(*count);
+}
+
+// An operation that destroys its completion handler without invoking it.
+struct abandon_handler
+{
+  template <typename Handler>
+  void operator()(Handler&&) const
+  {
+  }
+};
+
+void io_context_run_until_complete_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // The values of an operation that completes immediately are returned.
+  int i = ioc.run_until_complete(deferred.values(42));
+  ASIO_CHECK(i == 42);
+  std::tuple<int, char> t = ioc.run_until_complete(deferred.values(1, 'a'));
+  ASIO_CHECK(std::get<0>(t) == 1);
+  ASIO_CHECK(std::get<1>(t) == 'a');
+
+  // Other handlers run on the calling thread while it waits.
+  asio::post(ioc, bindns::bind(increment, &count));
+  steady_timer t1(ioc, chrono::milliseconds(10));
+  ioc.run_until_complete(t1.async_wait(deferred));
+  ASIO_CHECK(count == 1);
+
+  // An error is returned through the error_code overload.
+  t1.expires_after(chrono::seconds(10));
+  asio::post(ioc, bindns::bind(cancel_timer, &t1));
+  asio::error_code ec;
+  ioc.run_until_complete(t1.async_wait(deferred), ec);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // Values that follow the error_code are returned.
+  t1.expires_after(chrono::milliseconds(1));
+  int j = ioc.run_until_complete(t1.async_wait(
+        deferred([](asio::error_code e)
+          {
+            return deferred.values(e, 7);
+          })));
+  ASIO_CHECK(j == 7);
+
+  // Stopping the io_context does not interrupt the wait.
+  ioc.stop();
+  t1.expires_after(chrono::milliseconds(1));
+  ioc.run_until_complete(t1.async_wait(deferred));
+  ASIO_CHECK(ioc.stopped());
+
+  // Waits may be nested inside handlers, including on an io_context that is
+  // run by a single thread.
+  io_context ioc2(1);
+  count = 0;
+  asio::post(ioc2, bindns::bind(wait_inside_handler, &ioc2, &count));
+  ioc2.run();
+  ASIO_CHECK(count == 2);
+
+  // A nested wait on an io_context run by several threads may depend on
+  // handlers on the outer call's affine queue.
+  io_context ioc6;
+  count = 0;
+  asio::post(ioc6,
+      bindns::bind(wait_inside_handler_with_strand, &ioc6, &count));
+  ioc6.run();
+  ASIO_CHECK(count == 2);
+
+  // The wait ends if the completion handler is destroyed without being
+  // invoked.
+  ioc.restart();
+  ioc.run_until_complete(
+      asio::async_initiate<const deferred_t, void(asio::error_code)>(
+        abandon_handler(), deferred), ec);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // The waiting thread is woken when the operation completes on a thread
+  // that runs the same io_context.
+  io_context ioc3;
+  executor_work_guard<io_context::executor_type> work
+    = make_work_guard(ioc3);
+  thread thread1(bindns::bind(io_context_run, &ioc3));
+  steady_timer t3(ioc3);
+  for (int n = 0; n < 20; ++n)
+  {
+    t3.expires_after(chrono::milliseconds(1));
+    ioc3.run_until_complete(t3.async_wait(deferred));
+  }
+  work.reset();
+  thread1.join();
+
+  // The waiting thread is woken when the operation completes on another
+  // execution context.
+  thread_pool pool(1);
+  io_context ioc4;
+  steady_timer t4(pool, chrono::milliseconds(10));
+  ioc4.run_until_complete(t4.async_wait(deferred));
+  pool.join();
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  // An exception from another handler is thrown once the operation is done.
+  io_context ioc5;
+  asio::post(ioc5, throw_exception);
+  steady_timer t5(ioc5, chrono::milliseconds(10));
+  bool caught = false;
+  try
+  {
+    ioc5.run_until_complete(t5.async_wait(deferred));
+  }
+  catch (int)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+  ASIO_CHECK(t5.expiry() <= steady_timer::clock_type::now());
+
+  // A destroyed completion handler is reported as operation_aborted.
+  caught = false;
+  try
+  {
+    ioc.run_until_complete(
+        asio::async_initiate<const deferred_t, void(int)>(
+          abandon_handler(), deferred));
+  }
+  catch (asio::system_error& e)
+  {
+    caught = e.code() == asio::error::operation_aborted;
+  }
+  ASIO_CHECK(caught);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+void io_context_static_types_test()
+{
+  static_assert(is_same<io_context::steady_timer::executor_type,
+      io_context::executor_type>::value, "timer executor type");
+  static_assert(is_same<io_context::tcp::socket::executor_type,
+      io_context::executor_type>::value, "socket executor type");
+  static_assert(is_same<io_context::tcp::acceptor::executor_type,
+      io_context::executor_type>::value, "acceptor executor type");
+  static_assert(is_same<io_context::tcp::resolver::executor_type,
+      io_context::executor_type>::value, "resolver executor type");
+  static_assert(is_same<io_context::udp::socket::executor_type,
+      io_context::executor_type>::value, "udp socket executor type");
+
+  io_context ioc;
+
+  io_context::steady_timer t1(ioc, chrono::milliseconds(1));
+  ioc.run_until_complete(t1.async_wait(deferred));
+  ASIO_CHECK(t1.expiry() <= io_context::steady_timer::clock_type::now());
+
+  io_context::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  io_context::tcp::resolver resolver(ioc);
+  io_context::tcp::socket client(ioc);
+
+  // Composed operations keep the I/O object's executor type.
+  ip::tcp::resolver::results_type endpoints = ioc.run_until_complete(
+      resolver.async_resolve("127.0.0.1",
+        std::to_string(acceptor.local_endpoint().port()),
+        ip::resolver_base::numeric_host | ip::resolver_base::numeric_service,
+        deferred));
+  ioc.run_until_complete(asio::async_connect(client, endpoints, deferred));
+
+  // The accepted socket has the acceptor's executor type.
+  static_assert(is_same<
+      decltype(ioc.run_until_complete(acceptor.async_accept(deferred))),
+      io_context::tcp::socket>::value, "accepted socket type");
+  io_context::tcp::socket server
+    = ioc.run_until_complete(acceptor.async_accept(deferred));
+
+  const char write_data[] = "static";
+  char read_data[sizeof(write_data)] = "";
+  std::size_t n = ioc.run_until_complete(
+      asio::async_write(client, asio::buffer(write_data), deferred));
+  ASIO_CHECK(n == sizeof(write_data));
+  n = ioc.run_until_complete(
+      asio::async_read(server, asio::buffer(read_data), deferred));
+  ASIO_CHECK(n == sizeof(read_data));
+  ASIO_CHECK(std::string(read_data) == write_data);
+}
+
 ASIO_TEST_SUITE
 (
   "io_context",
@@ -563,4 +942,9 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(io_context_service_test)
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
+  ASIO_TEST_CASE(io_context_memory_usage_test)
+  ASIO_TEST_CASE(io_context_reserve_test)
+  ASIO_TEST_CASE(io_context_multithreaded_post_test)
+  ASIO_TEST_CASE(io_context_run_until_complete_test)
+  ASIO_TEST_CASE(io_context_static_types_test)
 )
@@ -18,6 +18,7 @@
 
 #include <functional>
 #include <sstream>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
@@ -308,9 +309,96 @@ void strand_wrap_test()
 #endif // !defined(ASIO_NO_DEPRECATED)
 }
 
+void dispatch_to_other_strands(io_context::strand* s,
+    std::vector<io_context::strand>* others, int* count)
+{
+  ASIO_CHECK(s->running_in_this_thread());
+
+  for (std::size_t i = 0; i < others->size(); ++i)
+  {
+    ASIO_CHECK(!(*others)[i].running_in_this_thread());
+
+    // Each strand has its own state, so holding one strand's lock must not
+    // prevent another strand's handler from running immediately.
+    int original_count = *count;
+    dispatch((*others)[i], bindns::bind(increment, count));
+    ASIO_CHECK(*count == original_count + 1);
+  }
+}
+
+void strand_independence_test()
+{
+  io_context ioc;
+  io_context::strand s(ioc);
+  std::vector<io_context::strand> others;
+  for (int i = 0; i < 1000; ++i)
+    others.push_back(io_context::strand(ioc));
+  int count = 0;
+
+  post(s, bindns::bind(dispatch_to_other_strands, &s, &others, &count));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1000);
+
+  // A strand may outlive its io_context.
+  io_context* ioc2 = new io_context;
+  io_context::strand* s2 = new io_context::strand(*ioc2);
+  post(*s2, bindns::bind(increment, &count));
+  delete ioc2;
+  delete s2;
+}
+
+void destroy_strand(io_context::strand** s, int* count)
+{
+  delete *s;
+  *s = 0;
+  ++(*count);
+}
+
+void post_and_destroy_strand(io_context::strand** s, int* count)
+{
+  post(**s, bindns::bind(increment, count));
+  destroy_strand(s, count);
+}
+
+void dispatch_to_strand(io_context::strand** s,
+    void (*f)(io_context::strand**, int*), int* count)
+{
+  (*s)->dispatch(bindns::bind(f, s, count), std::allocator<void>());
+}
+
+void strand_destroy_in_handler_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // A strand may be destroyed by a handler that is run immediately by
+  // dispatch().
+  io_context::strand* s = new io_context::strand(ioc);
+  post(ioc, bindns::bind(dispatch_to_strand, &s, destroy_strand, &count));
+  ioc.run();
+
+  ASIO_CHECK(s == 0);
+  ASIO_CHECK(count == 1);
+
+  // Handlers that are still waiting in the strand are run.
+  count = 0;
+  s = new io_context::strand(ioc);
+  post(ioc, bindns::bind(dispatch_to_strand,
+        &s, post_and_destroy_strand, &count));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(s == 0);
+  ASIO_CHECK(count == 2);
+}
+
 ASIO_TEST_SUITE
 (
   "strand",
   ASIO_TEST_CASE(strand_test)
   ASIO_TEST_CASE(strand_wrap_test)
+  ASIO_TEST_CASE(strand_independence_test)
+  ASIO_TEST_CASE(strand_destroy_in_handler_test)
 )
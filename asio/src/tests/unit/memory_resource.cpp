@@ -0,0 +1,166 @@
+//
+// memory_resource.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/memory_resource.hpp"
+
+#include <functional>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/io_context_strand.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "unit_test.hpp"
+
+namespace bindns = std;
+
+class counting_resource
+  : public asio::memory_resource
+{
+public:
+  counting_resource()
+    : allocations_(0),
+      bytes_in_use_(0)
+  {
+  }
+
+  std::size_t allocations() const
+  {
+    return allocations_;
+  }
+
+  std::size_t bytes_in_use() const
+  {
+    return bytes_in_use_;
+  }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align)
+  {
+    ++allocations_;
+    bytes_in_use_ += bytes;
+    return asio::get_default_memory_resource()->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align)
+  {
+    bytes_in_use_ -= bytes;
+    asio::get_default_memory_resource()->deallocate(p, bytes, align);
+  }
+
+  std::size_t allocations_;
+  std::size_t bytes_in_use_;
+};
+
+void memory_resource_test()
+{
+  asio::memory_resource* r1 = asio::get_default_memory_resource();
+  ASIO_CHECK(r1 != 0);
+  ASIO_CHECK(r1 == asio::get_default_memory_resource());
+
+  void* p = r1->allocate(100);
+  ASIO_CHECK(p != 0);
+  r1->deallocate(p, 100);
+
+  counting_resource r2;
+  ASIO_CHECK(*r1 == *r1);
+  ASIO_CHECK(*r1 != r2);
+
+  asio::memory_resource_allocator<int> a1(&r2);
+  asio::memory_resource_allocator<char> a2(a1);
+  asio::memory_resource_allocator<int> a3;
+  ASIO_CHECK(a2.resource() == &r2);
+  ASIO_CHECK(a3.resource() == r1);
+  ASIO_CHECK(a1 != a3);
+
+  {
+    std::vector<int, asio::memory_resource_allocator<int> > v(a1);
+    v.resize(10);
+    ASIO_CHECK(r2.allocations() > 0);
+    ASIO_CHECK(r2.bytes_in_use() >= 10 * sizeof(int));
+  }
+
+  ASIO_CHECK(r2.bytes_in_use() == 0);
+}
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void io_context_memory_resource_test()
+{
+  counting_resource r;
+
+  {
+    asio::io_context ioc(r);
+    ASIO_CHECK(&ioc.get_memory_resource() == &r);
+
+    // The io_context's implementation is allocated from the resource.
+    std::size_t allocations = r.allocations();
+    ASIO_CHECK(allocations > 0);
+
+    // So is the per-descriptor state of the reactor.
+    asio::ip::tcp::socket socket(ioc);
+    socket.open(asio::ip::tcp::v4());
+    ASIO_CHECK(r.allocations() > allocations);
+
+    // And strand implementations. The first strand of each kind also creates
+    // the corresponding service.
+    asio::io_context::strand s1(ioc);
+    allocations = r.allocations();
+    asio::io_context::strand s2(ioc);
+    ASIO_CHECK(r.allocations() == allocations + 1);
+
+    asio::strand<asio::io_context::executor_type> s3 =
+      asio::make_strand(ioc);
+    allocations = r.allocations();
+    asio::strand<asio::io_context::executor_type> s4 =
+      asio::make_strand(ioc);
+    ASIO_CHECK(r.allocations() == allocations + 1);
+
+    int count = 0;
+    asio::post(s2, bindns::bind(increment, &count));
+    asio::post(s4, bindns::bind(increment, &count));
+    ioc.run();
+    ASIO_CHECK(count == 2);
+  }
+
+  // All memory is returned to the resource when the io_context is destroyed.
+  ASIO_CHECK(r.bytes_in_use() == 0);
+
+  {
+    asio::io_context ioc(1, r);
+    ASIO_CHECK(&ioc.get_memory_resource() == &r);
+  }
+
+  ASIO_CHECK(r.bytes_in_use() == 0);
+
+  asio::io_context ioc;
+  ASIO_CHECK(&ioc.get_memory_resource() == asio::get_default_memory_resource());
+}
+
+ASIO_TEST_SUITE
+(
+  "memory_resource",
+  ASIO_TEST_CASE(memory_resource_test)
+  ASIO_TEST_CASE(io_context_memory_resource_test)
+)
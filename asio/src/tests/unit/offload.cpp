@@ -0,0 +1,382 @@
+//
+// offload.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/offload.hpp"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "asio/io_context.hpp"
+#include "asio/strand.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+
+namespace bindns = std;
+
+std::thread::id current_thread_id()
+{
+  return std::this_thread::get_id();
+}
+
+int return_42()
+{
+  return 42;
+}
+
+struct unassignable_result
+{
+  unassignable_result() : value(0) {}
+  explicit unassignable_result(int v) : value(v) {}
+  unassignable_result(const unassignable_result& other) : value(other.value) {}
+  unassignable_result& operator=(const unassignable_result&) = delete;
+  const int value;
+};
+
+unassignable_result return_unassignable()
+{
+  return unassignable_result(42);
+}
+
+const std::string& return_reference()
+{
+  static const std::string s("offload");
+  return s;
+}
+
+void record_thread_id(std::thread::id* id)
+{
+  *id = std::this_thread::get_id();
+}
+
+void wait_for(std::shared_future<void> f)
+{
+  f.wait();
+}
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+int throw_int()
+{
+  throw std::runtime_error("offload");
+}
+
+void throw_void(std::thread::id* id)
+{
+  *id = std::this_thread::get_id();
+  throw std::runtime_error("offload");
+}
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+
+void check_int_result(io_context* ioc, int* count,
+    std::exception_ptr e, const asio::error_code& ec, int result)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == 42);
+  ASIO_CHECK(ioc->get_executor().running_in_this_thread());
+  ++(*count);
+}
+
+void check_thread_id_result(std::thread::id caller_id, int* count,
+    std::exception_ptr e, const asio::error_code& ec, std::thread::id result)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result != caller_id);
+  ++(*count);
+}
+
+void check_unassignable_result(int* count, std::exception_ptr e,
+    const asio::error_code& ec, unassignable_result result)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result.value == 42);
+  ++(*count);
+}
+
+void check_reference_result(int* count, std::exception_ptr e,
+    const asio::error_code& ec, std::string result)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == "offload");
+  ASIO_CHECK(&result != &return_reference());
+  ++(*count);
+}
+
+void check_in_strand(const strand<io_context::executor_type>* s,
+    int* count, std::exception_ptr e, const asio::error_code& ec)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(s->running_in_this_thread());
+  ++(*count);
+}
+
+void check_error(asio::error_code expected_ec,
+    int* count, std::exception_ptr e, const asio::error_code& ec)
+{
+  ASIO_CHECK(!e);
+  ASIO_CHECK(ec == expected_ec);
+  ++(*count);
+}
+
+void check_exception(io_context* ioc, int* count,
+    std::exception_ptr e, const asio::error_code& ec)
+{
+  ASIO_CHECK(e != std::exception_ptr());
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(ioc->get_executor().running_in_this_thread());
+  ++(*count);
+}
+
+void check_int_exception(io_context* ioc, int* count,
+    std::exception_ptr e, const asio::error_code& ec, int result)
+{
+  check_exception(ioc, count, e, ec);
+  ASIO_CHECK(result == 0);
+}
+
+void offload_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // The function runs on another thread and the handler on the io_context.
+  async_offload(ioc, return_42,
+      bindns::bind(check_int_result, &ioc, &count, bindns::placeholders::_1,
+        bindns::placeholders::_2, bindns::placeholders::_3));
+  async_offload(ioc.get_executor(), current_thread_id,
+      bindns::bind(check_thread_id_result,
+        std::this_thread::get_id(), &count, bindns::placeholders::_1,
+        bindns::placeholders::_2, bindns::placeholders::_3));
+
+  // The handler resumes on the executor that started the operation.
+  strand<io_context::executor_type> s(ioc.get_executor());
+  std::thread::id id;
+  async_offload(s, bindns::bind(record_thread_id, &id),
+      bindns::bind(check_in_strand, &s, &count,
+        bindns::placeholders::_1, bindns::placeholders::_2));
+
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(id != std::this_thread::get_id());
+}
+
+void offload_options_test()
+{
+  io_context ioc;
+
+  offload_options options = get_offload_options(ioc);
+  ASIO_CHECK(options.max_threads > 0);
+  ASIO_CHECK(options.overflow == offload_options::reject);
+
+  options.max_threads = 2;
+  options.max_queued = 8;
+  options.overflow = offload_options::caller_runs;
+  set_offload_options(ioc, options);
+
+  options = get_offload_options(ioc);
+  ASIO_CHECK(options.max_threads == 2);
+  ASIO_CHECK(options.max_queued == 8);
+  ASIO_CHECK(options.overflow == offload_options::caller_runs);
+}
+
+void offload_result_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // A result that cannot be assigned is constructed in place.
+  async_offload(ioc, return_unassignable,
+      bindns::bind(check_unassignable_result, &count, bindns::placeholders::_1,
+        bindns::placeholders::_2, bindns::placeholders::_3));
+
+  // A returned reference is copied into the result.
+  async_offload(ioc, return_reference,
+      bindns::bind(check_reference_result, &count, bindns::placeholders::_1,
+        bindns::placeholders::_2, bindns::placeholders::_3));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+}
+
+void offload_overflow_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  offload_options options;
+  options.max_threads = 1;
+  options.max_queued = 0;
+  options.overflow = offload_options::reject;
+  set_offload_options(ioc, options);
+
+  // Occupy the only thread.
+  std::promise<void> release;
+  std::shared_future<void> released(release.get_future());
+  async_offload(ioc, bindns::bind(wait_for, released),
+      bindns::bind(check_error, asio::error_code(),
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+
+  // There is no room in the queue, so the function is rejected.
+  std::thread::id id;
+  async_offload(ioc, bindns::bind(record_thread_id, &id),
+      bindns::bind(check_error, asio::error::try_again,
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+  ASIO_CHECK(id == std::thread::id());
+
+  // With the caller runs policy, the function is called before returning.
+  options.overflow = offload_options::caller_runs;
+  set_offload_options(ioc, options);
+  async_offload(ioc, bindns::bind(record_thread_id, &id),
+      bindns::bind(check_error, asio::error_code(),
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+  ASIO_CHECK(id == std::this_thread::get_id());
+
+  // No handler is called from within async_offload.
+  ASIO_CHECK(count == 0);
+
+  release.set_value();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+}
+
+void signal_and_wait_for(std::promise<void>* started,
+    std::shared_future<void> f)
+{
+  started->set_value();
+  f.wait();
+}
+
+void offload_signal_and_wait_for(io_context* ioc, int* count,
+    std::promise<void>* started, std::shared_future<void> f)
+{
+  async_offload(*ioc, bindns::bind(signal_and_wait_for, started, f),
+      bindns::bind(check_error, asio::error_code(),
+        count, bindns::placeholders::_1, bindns::placeholders::_2));
+}
+
+void offload_caller_runs_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  offload_options options;
+  options.max_threads = 1;
+  options.max_queued = 0;
+  options.overflow = offload_options::caller_runs;
+  set_offload_options(ioc, options);
+
+  // Occupy the only thread.
+  std::promise<void> release;
+  std::shared_future<void> released(release.get_future());
+  async_offload(ioc, bindns::bind(wait_for, released),
+      bindns::bind(check_error, asio::error_code(),
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+
+  // Block another caller inside a function that it runs itself, so that
+  // there are more running functions than threads.
+  std::promise<void> started;
+  std::thread caller(bindns::bind(offload_signal_and_wait_for,
+        &ioc, &count, &started, released));
+  started.get_future().wait();
+
+  // The service is still saturated, so the function is called before
+  // returning.
+  std::thread::id id;
+  async_offload(ioc, bindns::bind(record_thread_id, &id),
+      bindns::bind(check_error, asio::error_code(),
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+  ASIO_CHECK(id == std::this_thread::get_id());
+
+  release.set_value();
+  caller.join();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+}
+
+void offload_exception_test()
+{
+#if !defined(ASIO_NO_EXCEPTIONS)
+  io_context ioc;
+  int count = 0;
+
+  // An exception from a function run on the service's thread is passed to
+  // the handler.
+  async_offload(ioc, throw_int,
+      bindns::bind(check_int_exception, &ioc, &count, bindns::placeholders::_1,
+        bindns::placeholders::_2, bindns::placeholders::_3));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+
+  offload_options options;
+  options.max_threads = 1;
+  options.max_queued = 0;
+  options.overflow = offload_options::caller_runs;
+  set_offload_options(ioc, options);
+  ioc.restart();
+
+  // Occupy the only thread so that the next function runs in the caller.
+  std::promise<void> release;
+  std::shared_future<void> released(release.get_future());
+  async_offload(ioc, bindns::bind(wait_for, released),
+      bindns::bind(check_error, asio::error_code(),
+        &count, bindns::placeholders::_1, bindns::placeholders::_2));
+
+  // An exception from a function run by the caller does not escape from
+  // async_offload, and is passed to the handler.
+  std::thread::id id;
+  async_offload(ioc, bindns::bind(throw_void, &id),
+      bindns::bind(check_exception, &ioc, &count,
+        bindns::placeholders::_1, bindns::placeholders::_2));
+  ASIO_CHECK(id == std::this_thread::get_id());
+  ASIO_CHECK(count == 1);
+
+  release.set_value();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+ASIO_TEST_SUITE
+(
+  "offload",
+  ASIO_TEST_CASE(offload_test)
+  ASIO_TEST_CASE(offload_options_test)
+  ASIO_TEST_CASE(offload_result_test)
+  ASIO_TEST_CASE(offload_overflow_test)
+  ASIO_TEST_CASE(offload_caller_runs_test)
+  ASIO_TEST_CASE(offload_exception_test)
+)
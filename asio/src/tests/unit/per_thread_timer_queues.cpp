@@ -0,0 +1,168 @@
+//
+// per_thread_timer_queues.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Give each thread that arms a timer inside a run function its own queue.
+#define ASIO_ENABLE_PER_THREAD_TIMER_QUEUES 1
+
+#include "asio/steady_timer.hpp"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+namespace bindns = std;
+
+void increment_if_not_cancelled(int* count, const asio::error_code& ec)
+{
+  if (!ec)
+    ++(*count);
+}
+
+void increment_if_cancelled(int* count, const asio::error_code& ec)
+{
+  if (ec == asio::error::operation_aborted)
+    ++(*count);
+}
+
+void arm_timer(steady_timer* t, chrono::milliseconds d, int* count)
+{
+  t->expires_after(d);
+  t->async_wait(bindns::bind(increment_if_not_cancelled,
+        count, bindns::placeholders::_1));
+}
+
+void arm_long_timer(steady_timer* t, int* count, std::atomic<bool>* armed)
+{
+  t->expires_after(chrono::seconds(10));
+  t->async_wait(bindns::bind(increment_if_cancelled,
+        count, bindns::placeholders::_1));
+  *armed = true;
+}
+
+void io_context_run(io_context* ioc)
+{
+  ioc->run();
+}
+
+void run_one_handler(io_context* ioc)
+{
+  ioc->restart();
+  ioc->run_one();
+}
+
+void per_thread_timer_queues_test()
+{
+  io_context ioc;
+  int count1 = 0, count2 = 0, count3 = 0;
+
+  // Timers armed from inside run functions on different threads.
+  steady_timer t1(ioc), t2(ioc), t3(ioc);
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  thread th1(bindns::bind(io_context_run, &ioc));
+  thread th2(bindns::bind(io_context_run, &ioc));
+  post(ioc, bindns::bind(arm_timer, &t1, chrono::milliseconds(10), &count1));
+  post(ioc, bindns::bind(arm_timer, &t2, chrono::milliseconds(20), &count2));
+  std::atomic<bool> armed(false);
+  post(ioc, bindns::bind(arm_long_timer, &t3, &count3, &armed));
+
+  // Wait until the last timer is armed, and then cancel it from outside.
+  while (!armed)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  t3.cancel();
+
+  work.reset();
+  th1.join();
+  th2.join();
+
+  ASIO_CHECK(count1 == 1);
+  ASIO_CHECK(count2 == 1);
+  ASIO_CHECK(count3 == 1);
+
+  // A timer armed on one thread may be moved and then cancelled on another.
+  ioc.restart();
+  count3 = 0;
+  steady_timer* t4 = new steady_timer(ioc);
+  post(ioc, bindns::bind(arm_long_timer, t4, &count3, &armed));
+  thread th3(bindns::bind(run_one_handler, &ioc));
+  th3.join();
+  steady_timer t5(std::move(*t4));
+  delete t4;
+  t5.cancel();
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count3 == 1);
+}
+
+void arm_timer_in_new_thread(io_context* ioc, int* count)
+{
+  steady_timer t(*ioc);
+  post(*ioc, bindns::bind(arm_timer, &t, chrono::milliseconds(1), count));
+  ioc->restart();
+  ioc->run();
+}
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+typedef asio::detail::thread_timer_queue<
+    asio::detail::chrono_time_traits<chrono::steady_clock,
+      asio::wait_traits<chrono::steady_clock>>> thread_queue_type;
+
+void check_thread_index(bool* has_index)
+{
+  *has_index = thread_queue_type::this_thread_index()
+    < thread_queue_type::max_threads;
+}
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+
+void per_thread_timer_queues_churn_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // Many short-lived threads arm timers, one after another.
+  for (int i = 0; i < 100; ++i)
+  {
+    thread th(bindns::bind(arm_timer_in_new_thread, &ioc, &count));
+    th.join();
+  }
+
+  ASIO_CHECK(count == 100);
+
+#if defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+  // The queues of the threads that have exited are reused.
+  bool has_index = false;
+  thread th(bindns::bind(check_thread_index, &has_index));
+  th.join();
+  ASIO_CHECK(has_index);
+#endif // defined(ASIO_HAS_PER_THREAD_TIMER_QUEUES)
+}
+
+ASIO_TEST_SUITE
+(
+  "per_thread_timer_queues",
+  ASIO_TEST_CASE(per_thread_timer_queues_test)
+  ASIO_TEST_CASE(per_thread_timer_queues_churn_test)
+)
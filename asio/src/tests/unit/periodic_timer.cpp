@@ -0,0 +1,321 @@
+//
+// periodic_timer.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/periodic_timer.hpp"
+
+#include <functional>
+#include <memory>
+#include "asio/bind_allocator.hpp"
+#include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+namespace bindns = std;
+
+typedef asio::periodic_timer::time_point time_point;
+
+time_point now()
+{
+  return asio::periodic_timer::clock_type::now();
+}
+
+void record_ticks(asio::periodic_timer* t, int* count,
+    time_point* last_expiry, std::size_t* missed_total,
+    const asio::error_code& ec, std::size_t missed)
+{
+  if (ec)
+    return;
+
+  // Each tick must occur after its scheduled time.
+  ASIO_CHECK(!(now() < t->expiry()));
+
+  // In fixed_rate mode consecutive ticks are scheduled a whole number of
+  // periods apart, regardless of when the handler runs.
+  if (*count > 0)
+  {
+    ASIO_CHECK(t->expiry() - *last_expiry
+        == t->period() * static_cast<int>(missed + 1));
+  }
+
+  *last_expiry = t->expiry();
+  *missed_total += missed;
+
+  if (++(*count) < 5)
+  {
+    t->async_wait(bindns::bind(record_ticks, t, count,
+          last_expiry, missed_total, bindns::placeholders::_1,
+          bindns::placeholders::_2));
+  }
+}
+
+void periodic_timer_fixed_rate_test()
+{
+  using asio::chrono::milliseconds;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  int count = 0;
+  time_point last_expiry;
+  std::size_t missed_total = 0;
+
+  asio::periodic_timer t(ioc, milliseconds(20));
+  ASIO_CHECK(t.period() == milliseconds(20));
+  ASIO_CHECK(t.schedule() == asio::periodic_timer::fixed_rate);
+
+  time_point start = now();
+  t.async_wait(bindns::bind(record_ticks, &t, &count,
+        &last_expiry, &missed_total, _1, _2));
+  ioc.run();
+
+  ASIO_CHECK(count == 5);
+  ASIO_CHECK(!(now() < start + milliseconds(100)));
+}
+
+void set_missed(std::size_t* result, asio::error_code* result_ec,
+    const asio::error_code& ec, std::size_t missed)
+{
+  *result_ec = ec;
+  *result = missed;
+}
+
+void periodic_timer_missed_ticks_test()
+{
+  using asio::chrono::milliseconds;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  asio::error_code ec;
+  std::size_t missed = 0;
+
+  asio::periodic_timer t(ioc, milliseconds(20));
+
+  // The first tick is never late.
+  ASIO_CHECK(t.wait() == 0);
+  time_point first = t.expiry();
+
+  // Fall behind by at least three periods.
+  asio::steady_timer delay(ioc, milliseconds(70));
+  delay.wait();
+
+  // The next wait completes immediately, on the most recent tick that has
+  // already passed, and reports the ticks skipped before it.
+  t.async_wait(bindns::bind(set_missed, &missed, &ec, _1, _2));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(missed >= 2);
+  ASIO_CHECK(t.expiry() - first
+      == t.period() * static_cast<int>(missed + 1));
+  ASIO_CHECK(t.expiry() < now());
+
+  // Subsequent ticks stay on the original schedule.
+  ASIO_CHECK(t.wait() == 0);
+  ASIO_CHECK(t.expiry() - first
+      == t.period() * static_cast<int>(missed + 2));
+}
+
+void periodic_timer_fixed_delay_test()
+{
+  using asio::chrono::milliseconds;
+
+  asio::io_context ioc;
+
+  asio::periodic_timer t(ioc, milliseconds(20),
+      asio::periodic_timer::fixed_delay);
+  ASIO_CHECK(t.schedule() == asio::periodic_timer::fixed_delay);
+
+  ASIO_CHECK(t.wait() == 0);
+
+  asio::steady_timer delay(ioc, milliseconds(50));
+  delay.wait();
+
+  // A late wait is never reported as having missed ticks. The next tick is
+  // scheduled one period after the wait starts.
+  time_point start = now();
+  ASIO_CHECK(t.wait() == 0);
+  ASIO_CHECK(!(t.expiry() < start + milliseconds(20)));
+  ASIO_CHECK(!(now() < start + milliseconds(20)));
+}
+
+void periodic_timer_cancel_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::seconds;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  asio::error_code ec;
+  std::size_t missed = 0;
+
+  asio::periodic_timer t(ioc, seconds(10));
+  t.async_wait(bindns::bind(set_missed, &missed, &ec, _1, _2));
+  time_point first = t.expiry();
+
+  ASIO_CHECK(t.cancel() == 1);
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // Cancelling does not change the schedule.
+  t.async_wait(bindns::bind(set_missed, &missed, &ec, _1, _2));
+  ASIO_CHECK(t.expiry() == first + seconds(10));
+
+  // Restarting discards the schedule.
+  t.set_period(milliseconds(10));
+  ASIO_CHECK(t.restart() == 1);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  time_point start = now();
+  t.async_wait(bindns::bind(set_missed, &missed, &ec, _1, _2));
+  ASIO_CHECK(t.expiry() < first);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(missed == 0);
+  ASIO_CHECK(!(now() < start + milliseconds(10)));
+}
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(int* allocations, int* in_use)
+    : allocations_(allocations),
+      in_use_(in_use)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : allocations_(other.allocations_),
+      in_use_(other.in_use_)
+  {
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return allocations_ == other.allocations_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return allocations_ != other.allocations_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++*allocations_;
+    ++*in_use_;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --*in_use_;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  int* allocations_;
+  int* in_use_;
+};
+
+struct counted_tick_handler
+{
+  asio::periodic_timer* t;
+  int* count;
+  int* allocations;
+  int* in_use;
+  asio::error_code* last_ec;
+
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    *last_ec = ec;
+    if (!ec && ++*count < 100)
+    {
+      t->async_wait(asio::bind_allocator(
+            counting_allocator<void>(allocations, in_use), *this));
+    }
+  }
+};
+
+void periodic_timer_allocation_test()
+{
+  using asio::chrono::microseconds;
+  using asio::chrono::seconds;
+
+  asio::io_context ioc;
+  int count = 0;
+  int allocations = 0;
+  int in_use = 0;
+  asio::error_code ec;
+
+  // The wait operation for every tick is held in the timer's own memory, so
+  // the handler's allocator is never used.
+  asio::periodic_timer t(ioc, microseconds(100));
+  counted_tick_handler h = { &t, &count, &allocations, &in_use, &ec };
+  t.async_wait(asio::bind_allocator(
+        counting_allocator<void>(&allocations, &in_use), h));
+  ioc.run();
+
+  ASIO_CHECK(count == 100);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(allocations == 0);
+  ASIO_CHECK(in_use == 0);
+
+  // A wait started while another is pending cancels it. The new wait cannot
+  // use the timer's memory until the cancelled operation has released it.
+  t.set_period(seconds(10));
+  count = 100;
+  asio::error_code ec2;
+  counted_tick_handler h2 = { &t, &count, &allocations, &in_use, &ec2 };
+  t.async_wait(asio::bind_allocator(
+        counting_allocator<void>(&allocations, &in_use), h));
+  t.async_wait(asio::bind_allocator(
+        counting_allocator<void>(&allocations, &in_use), h2));
+  ASIO_CHECK(allocations == 1);
+  ASIO_CHECK(in_use == 1);
+
+  // The timer's memory outlives the timer while an operation still uses it.
+  {
+    asio::periodic_timer t2(std::move(t));
+  }
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+  ASIO_CHECK(in_use == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "periodic_timer",
+  ASIO_TEST_CASE(periodic_timer_fixed_rate_test)
+  ASIO_TEST_CASE(periodic_timer_missed_ticks_test)
+  ASIO_TEST_CASE(periodic_timer_fixed_delay_test)
+  ASIO_TEST_CASE(periodic_timer_cancel_test)
+  ASIO_TEST_CASE(periodic_timer_allocation_test)
+)
@@ -18,8 +18,13 @@
 
 #include "unit_test.hpp"
 #include <vector>
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/type_traits.hpp"
 
+#if defined(ASIO_HAS_THREADS)
+# include <thread>
+#endif // defined(ASIO_HAS_THREADS)
+
 void recycling_allocator_test()
 {
   ASIO_CHECK((
@@ -73,8 +78,135 @@ void recycling_allocator_test()
   ASIO_CHECK(v.size() == 42);
 }
 
+void recycling_allocator_size_class_test()
+{
+  using asio::detail::thread_info_base;
+
+  thread_info_base this_thread;
+
+  // Blocks are reused by allocations of any size in the same size class.
+  void* p1 = thread_info_base::allocate(&this_thread, 100);
+  ASIO_CHECK(this_thread.statistics().misses == 1);
+  thread_info_base::deallocate(&this_thread, p1, 100);
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 128);
+
+  void* p2 = thread_info_base::allocate(&this_thread, 120);
+  ASIO_CHECK(p2 == p1);
+  ASIO_CHECK(this_thread.statistics().hits == 1);
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 0);
+
+  // A block in one size class is not used for another.
+  thread_info_base::deallocate(&this_thread, p2, 120);
+  void* p3 = thread_info_base::allocate(&this_thread, 200);
+  ASIO_CHECK(p3 != p2);
+  ASIO_CHECK(this_thread.statistics().misses == 2);
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 128);
+
+  // Blocks with different purposes are held in separate bins.
+  void* p4 = thread_info_base::allocate(
+      thread_info_base::executor_function_tag(), &this_thread, 100);
+  ASIO_CHECK(p4 != p2);
+  ASIO_CHECK(this_thread.statistics().misses == 3);
+  thread_info_base::deallocate(
+      thread_info_base::executor_function_tag(), &this_thread, p4, 100);
+  thread_info_base::deallocate(&this_thread, p3, 200);
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 128 + 128 + 256);
+
+  // Oversized blocks are never cached.
+  void* p5 = thread_info_base::allocate(&this_thread, 8192);
+  ASIO_CHECK(this_thread.statistics().oversized == 1);
+  thread_info_base::deallocate(&this_thread, p5, 8192);
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 128 + 128 + 256);
+
+  this_thread.trim();
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 0);
+}
+
+void recycling_allocator_cache_depth_test()
+{
+  using asio::detail::thread_info_base;
+
+  thread_info_base this_thread;
+  ASIO_CHECK(this_thread.cache_depth() == ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE);
+
+  // The depth of each bin is set per thread at runtime.
+  this_thread.set_cache_depth(8);
+  ASIO_CHECK(this_thread.cache_depth() == 8);
+
+  void* blocks[8];
+  for (int i = 0; i < 8; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 100);
+  for (int i = 0; i < 8; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 100);
+  ASIO_CHECK(this_thread.statistics().batches_returned == 0);
+  ASIO_CHECK(this_thread.statistics().releases == 0);
+
+  for (int i = 0; i < 8; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 100);
+  ASIO_CHECK(this_thread.statistics().hits == 8);
+  for (int i = 0; i < 8; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 100);
+
+  this_thread.trim();
+  ASIO_CHECK(this_thread.statistics().cached_bytes == 0);
+}
+
+#if defined(ASIO_HAS_THREADS)
+
+const int cross_thread_blocks = 64;
+
+void free_blocks(void** blocks)
+{
+  using asio::detail::thread_info_base;
+
+  thread_info_base this_thread;
+  for (int i = 0; i < cross_thread_blocks; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 100);
+
+  ASIO_CHECK(this_thread.statistics().batches_returned > 0);
+}
+
+void recycling_allocator_cross_thread_test()
+{
+  using asio::detail::thread_info_base;
+
+  thread_info_base::trim_shared();
+  ASIO_CHECK(thread_info_base::shared_cached_bytes() == 0);
+
+  thread_info_base this_thread;
+  void* blocks[cross_thread_blocks];
+  for (int i = 0; i < cross_thread_blocks; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 100);
+  ASIO_CHECK(this_thread.statistics().misses == cross_thread_blocks);
+
+  // Blocks freed on another thread are handed to the shared cache in batches.
+  std::thread consumer(free_blocks, blocks);
+  consumer.join();
+  ASIO_CHECK(thread_info_base::shared_cached_bytes() > 0);
+
+  // The allocating thread takes the batches back rather than using the heap.
+  for (int i = 0; i < cross_thread_blocks; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 100);
+  ASIO_CHECK(this_thread.statistics().batches_received > 0);
+  ASIO_CHECK(this_thread.statistics().hits > 0);
+  ASIO_CHECK(this_thread.statistics().misses < 2 * cross_thread_blocks);
+  ASIO_CHECK(thread_info_base::shared_cached_bytes() == 0);
+
+  for (int i = 0; i < cross_thread_blocks; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 100);
+  this_thread.trim();
+  thread_info_base::trim_shared();
+}
+
+#endif // defined(ASIO_HAS_THREADS)
+
 ASIO_TEST_SUITE
 (
   "recycling_allocator",
   ASIO_TEST_CASE(recycling_allocator_test)
+  ASIO_TEST_CASE(recycling_allocator_size_class_test)
+  ASIO_TEST_CASE(recycling_allocator_cache_depth_test)
+#if defined(ASIO_HAS_THREADS)
+  ASIO_TEST_CASE(recycling_allocator_cross_thread_test)
+#endif // defined(ASIO_HAS_THREADS)
 )
@@ -0,0 +1,149 @@
+//
+// registered_buffer_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/registered_buffer_pool.hpp"
+
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/thread.hpp"
+#include "unit_test.hpp"
+
+void registered_buffer_pool_test()
+{
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc.get_executor(), 1000, 8);
+
+  // Buffer sizes are rounded up to whole cache lines.
+  ASIO_CHECK(pool.buffer_size() >= 1000);
+  ASIO_CHECK(pool.buffer_size() % ASIO_CACHE_LINE_SIZE == 0);
+  ASIO_CHECK(pool.buffer_count() == 8);
+
+  std::vector<asio::registered_buffer_pool::lease> leases;
+  for (int i = 0; i < 8; ++i)
+  {
+    asio::registered_buffer_pool::lease l = pool.acquire();
+    ASIO_CHECK(!!l);
+    ASIO_CHECK(l.buffer().size() == pool.buffer_size());
+    std::memset(l.buffer().data(), i, l.buffer().size());
+    leases.push_back(static_cast<asio::registered_buffer_pool::lease&&>(l));
+    ASIO_CHECK(!l);
+  }
+
+  // Each lease refers to a distinct buffer.
+  for (std::size_t i = 0; i < leases.size(); ++i)
+  {
+    ASIO_CHECK(!!leases[i]);
+    unsigned char* p = static_cast<unsigned char*>(leases[i].buffer().data());
+    ASIO_CHECK(p[0] == i);
+    ASIO_CHECK(p[pool.buffer_size() - 1] == i);
+  }
+
+  // The pool is exhausted.
+  asio::registered_buffer_pool::lease l1 = pool.acquire();
+  ASIO_CHECK(!l1);
+
+  // Releasing a lease makes its buffer available again.
+  void* data = leases[3].buffer().data();
+  leases[3].release();
+  ASIO_CHECK(!leases[3]);
+  l1 = pool.acquire();
+  ASIO_CHECK(!!l1);
+  ASIO_CHECK(l1.buffer().data() == data);
+
+  // So does destroying a lease.
+  leases.pop_back();
+  asio::registered_buffer_pool::lease l2 = pool.acquire();
+  ASIO_CHECK(!!l2);
+  ASIO_CHECK(!pool.acquire());
+
+  // Move assignment returns the target's buffer to the pool.
+  l1 = static_cast<asio::registered_buffer_pool::lease&&>(l2);
+  ASIO_CHECK(!!l1);
+  ASIO_CHECK(!l2);
+  ASIO_CHECK(!!pool.acquire());
+}
+
+void registered_buffer_pool_context_test()
+{
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc, 0, 0);
+
+  ASIO_CHECK(pool.buffer_size() == ASIO_CACHE_LINE_SIZE);
+  ASIO_CHECK(pool.buffer_count() == 0);
+  ASIO_CHECK(!pool.acquire());
+}
+
+struct acquire_release
+{
+  asio::registered_buffer_pool* pool_;
+  int* failures_;
+
+  void operator()()
+  {
+    for (int i = 0; i < 10000; ++i)
+    {
+      asio::registered_buffer_pool::lease l1 = pool_->acquire();
+      asio::registered_buffer_pool::lease l2 = pool_->acquire();
+      if (!l1 || !l2 || l1.buffer().data() == l2.buffer().data())
+        ++*failures_;
+    }
+  }
+};
+
+void registered_buffer_pool_thread_test()
+{
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc, 64, 8);
+
+  // Each thread holds at most two buffers at a time, so no acquisition fails
+  // even when buffers must be taken from other threads' free lists.
+  int failures[4] = { 0, 0, 0, 0 };
+  acquire_release f0 = { &pool, &failures[0] };
+  acquire_release f1 = { &pool, &failures[1] };
+  acquire_release f2 = { &pool, &failures[2] };
+  acquire_release f3 = { &pool, &failures[3] };
+  asio::thread t0(f0);
+  asio::thread t1(f1);
+  asio::thread t2(f2);
+  asio::thread t3(f3);
+  t0.join();
+  t1.join();
+  t2.join();
+  t3.join();
+
+  ASIO_CHECK(failures[0] == 0);
+  ASIO_CHECK(failures[1] == 0);
+  ASIO_CHECK(failures[2] == 0);
+  ASIO_CHECK(failures[3] == 0);
+
+  // All buffers have been returned.
+  std::vector<asio::registered_buffer_pool::lease> leases;
+  for (int i = 0; i < 8; ++i)
+  {
+    leases.push_back(pool.acquire());
+    ASIO_CHECK(!!leases.back());
+  }
+  ASIO_CHECK(!pool.acquire());
+}
+
+ASIO_TEST_SUITE
+(
+  "registered_buffer_pool",
+  ASIO_TEST_CASE(registered_buffer_pool_test)
+  ASIO_TEST_CASE(registered_buffer_pool_context_test)
+  ASIO_TEST_CASE(registered_buffer_pool_thread_test)
+)
@@ -88,6 +88,17 @@ void test()
     ssl::stream<ip::tcp::socket>::executor_type ex = stream1.get_executor();
     (void)ex;
 
+    // ssl::stream over a socket bound to the io_context's executor.
+
+    ssl::stream<io_context::tcp::socket> stream6(ioc, context);
+    io_context::executor_type ex2 = stream6.get_executor();
+    (void)ex2;
+
+    stream6.async_handshake(ssl::stream_base::client, handshake_handler);
+    stream6.async_read_some(buffer(mutable_char_buffer), read_some_handler);
+    stream6.async_write_some(buffer(const_char_buffer), write_some_handler);
+    stream6.async_shutdown(shutdown_handler);
+
     // ssl::stream functions.
 
     SSL* ssl1 = stream1.native_handle();
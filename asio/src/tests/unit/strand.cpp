@@ -16,11 +16,15 @@
 // Test that header file is self-contained.
 #include "asio/strand.hpp"
 
+#include <atomic>
 #include <functional>
 #include <sstream>
+#include <thread>
 #include "asio/executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/fair_executor.hpp"
 #include "asio/post.hpp"
 #include "asio/thread.hpp"
 #include "unit_test.hpp"
@@ -448,6 +452,267 @@ void strand_execute_test()
   ASIO_CHECK(count == 1);
 }
 
+void record_count(int* count, int* recorded)
+{
+  *recorded = *count;
+}
+
+void increment_and_record(io_context* ioc, int* count, int* recorded)
+{
+  ++(*count);
+  post(*ioc, bindns::bind(record_count, count, recorded));
+}
+
+void post_increments(io_context* ioc,
+    strand<io_context::executor_type>* s, int* count, int* recorded)
+{
+  // The strand is locked, so these handlers are all run in the next slice.
+  post(*s, bindns::bind(increment_and_record, ioc, count, recorded));
+  post(*s, bindns::bind(increment, count));
+  post(*s, bindns::bind(increment, count));
+}
+
+void strand_run_budget_test()
+{
+  io_context ioc;
+  strand<io_context::executor_type> s = make_strand(ioc);
+  int count = 0;
+  int recorded = -1;
+
+  ASIO_CHECK(s.run_budget() == 0);
+
+  // Without a budget, the strand runs all ready handlers in a single slice.
+  post(s, bindns::bind(post_increments, &ioc, &s, &count, &recorded));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(recorded == 3);
+
+  // With a budget, the strand yields to other work between slices.
+  s.set_run_budget(2);
+  ASIO_CHECK(s.run_budget() == 2);
+
+  count = 0;
+  recorded = -1;
+  post(s, bindns::bind(post_increments, &ioc, &s, &count, &recorded));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(recorded == 2);
+
+  // An uncontended strand dispatched from within the io_context runs inline.
+  count = 0;
+  post(ioc, bindns::bind(increment_without_lock, &s, &count));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+}
+
+void affine_step(strand<io_context::executor_type>* s,
+    std::thread::id* id, int remaining, bool* same_thread)
+{
+  if (*id == std::thread::id())
+    *id = std::this_thread::get_id();
+  else if (*id != std::this_thread::get_id())
+    *same_thread = false;
+
+  if (remaining > 0)
+    post(*s, bindns::bind(affine_step, s, id, remaining - 1, same_thread));
+}
+
+void strand_thread_affinity_test()
+{
+  io_context ioc(4);
+  strand<io_context::executor_type> s = make_strand(ioc);
+  std::thread::id id;
+  bool same_thread = true;
+
+  ASIO_CHECK(!s.thread_affinity());
+  s.set_thread_affinity(true);
+  ASIO_CHECK(s.thread_affinity());
+
+  post(s, bindns::bind(affine_step, &s, &id, 1000, &same_thread));
+
+  // The strand continually reschedules itself, and so should remain on the
+  // thread that first ran it.
+  thread t1(bindns::bind(io_context_run, &ioc));
+  thread t2(bindns::bind(io_context_run, &ioc));
+  thread t3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  t1.join();
+  t2.join();
+  t3.join();
+
+  ASIO_CHECK(id != std::thread::id());
+  ASIO_CHECK(same_thread);
+
+  s.set_thread_affinity(false);
+  ASIO_CHECK(!s.thread_affinity());
+
+  // Affinity would bypass an inner executor that adds its own scheduling,
+  // and so is ignored.
+  strand<fair_executor<io_context::executor_type>> s2(make_fair_executor(ioc));
+  s2.set_thread_affinity(true);
+  ASIO_CHECK(!s2.thread_affinity());
+}
+
+void spin_until_set(std::atomic<bool>* flag, bool* was_set)
+{
+  chrono::steady_clock::time_point end
+    = chrono::steady_clock::now() + chrono::seconds(2);
+  while (!*flag && chrono::steady_clock::now() < end)
+    std::this_thread::yield();
+  *was_set = *flag;
+}
+
+void set_flag(std::atomic<bool>* flag)
+{
+  *flag = true;
+}
+
+void post_to_strand(strand<io_context::executor_type>* s,
+    const std::function<void()>& f)
+{
+  post(*s, f);
+}
+
+void start_affine_strands(strand<io_context::executor_type>* s1,
+    strand<io_context::executor_type>* s2,
+    std::atomic<bool>* flag, bool* was_set)
+{
+  // Each dispatch runs inline, and the handler it posts leaves the strand to
+  // be rescheduled on this thread.
+  dispatch(*s1, bindns::bind(post_to_strand, s1,
+        std::function<void()>(bindns::bind(spin_until_set, flag, was_set))));
+  dispatch(*s2, bindns::bind(post_to_strand, s2,
+        std::function<void()>(bindns::bind(set_flag, flag))));
+}
+
+void wait_for_idle_threads(io_context& ioc,
+    std::size_t idle_threads, bool task_waiting)
+{
+#if !defined(ASIO_HAS_IOCP)
+  asio::detail::io_context_impl& impl
+    = use_service<asio::detail::io_context_impl>(ioc);
+  for (;;)
+  {
+    asio::detail::io_context_impl::load_sample sample = impl.sample_load();
+    if (sample.idle_threads == idle_threads
+        && sample.task_waiting == task_waiting)
+      break;
+    std::this_thread::yield();
+  }
+#else // !defined(ASIO_HAS_IOCP)
+  (void)ioc;
+  (void)idle_threads;
+  (void)task_waiting;
+#endif // !defined(ASIO_HAS_IOCP)
+}
+
+void strand_thread_affinity_sharing_test()
+{
+  io_context ioc(3);
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  thread t1(bindns::bind(io_context_run, &ioc));
+  thread t2(bindns::bind(io_context_run, &ioc));
+  thread t3(bindns::bind(io_context_run, &ioc));
+
+  // Wait for the threads to become idle. The io_context has no I/O objects,
+  // and so no thread runs the reactor.
+  wait_for_idle_threads(ioc, 3, false);
+
+  strand<io_context::executor_type> s1 = make_strand(ioc);
+  strand<io_context::executor_type> s2 = make_strand(ioc);
+  s1.set_thread_affinity(true);
+  s2.set_thread_affinity(true);
+
+  // While the first strand's long handler runs, the second strand is picked
+  // up by another thread rather than waiting on the busy thread.
+  std::atomic<bool> flag(false);
+  bool was_set = false;
+  post(ioc, bindns::bind(start_affine_strands, &s1, &s2, &flag, &was_set));
+
+  work.reset();
+  t1.join();
+  t2.join();
+  t3.join();
+
+  ASIO_CHECK(was_set);
+}
+
+void record_affine_thread(std::thread::id* id,
+    bool* same_thread, std::atomic<int>* count)
+{
+  if (*id == std::thread::id())
+    *id = std::this_thread::get_id();
+  else if (*id != std::this_thread::get_id())
+    *same_thread = false;
+  ++*count;
+}
+
+void block_until_set(std::atomic<bool>* blocked, std::atomic<bool>* flag)
+{
+  *blocked = true;
+  while (!*flag)
+    std::this_thread::yield();
+}
+
+void strand_thread_affinity_wake_test()
+{
+  io_context ioc(2);
+
+  // Creating a timer starts the reactor, which one thread runs while the
+  // other is idle or busy.
+  timer t(ioc);
+
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  thread t1(bindns::bind(io_context_run, &ioc));
+  thread t2(bindns::bind(io_context_run, &ioc));
+
+  strand<io_context::executor_type> s = make_strand(ioc);
+  s.set_thread_affinity(true);
+
+  std::thread::id id;
+  bool same_thread = true;
+  std::atomic<int> count(0);
+
+  // While one thread is blocked in a handler, the strand first runs on the
+  // other thread, which then runs the reactor.
+  std::atomic<bool> blocked(false);
+  std::atomic<bool> unblock(false);
+  post(ioc, bindns::bind(block_until_set, &blocked, &unblock));
+  while (!blocked)
+    std::this_thread::yield();
+  post(s, bindns::bind(record_affine_thread, &id, &same_thread, &count));
+  while (count != 1)
+    std::this_thread::yield();
+  wait_for_idle_threads(ioc, 0, true);
+  unblock = true;
+
+  for (int i = 1; i < 20; ++i)
+  {
+    // The idle strand is given a handler from outside the io_context. If the
+    // thread that last ran the strand is waiting in the reactor, it is woken
+    // to run the strand rather than the idle thread.
+    wait_for_idle_threads(ioc, 1, true);
+    post(s, bindns::bind(record_affine_thread, &id, &same_thread, &count));
+    while (count != i + 1)
+      std::this_thread::yield();
+  }
+
+  work.reset();
+  t1.join();
+  t2.join();
+
+  ASIO_CHECK(id != std::thread::id());
+  ASIO_CHECK(same_thread);
+}
+
 ASIO_TEST_SUITE
 (
   "strand",
@@ -455,4 +720,8 @@ ASIO_TEST_SUITE
   ASIO_COMPILE_TEST_CASE(strand_conversion_test)
   ASIO_TEST_CASE(strand_query_test)
   ASIO_TEST_CASE(strand_execute_test)
+  ASIO_TEST_CASE(strand_run_budget_test)
+  ASIO_TEST_CASE(strand_thread_affinity_test)
+  ASIO_TEST_CASE(strand_thread_affinity_sharing_test)
+  ASIO_TEST_CASE(strand_thread_affinity_wake_test)
 )
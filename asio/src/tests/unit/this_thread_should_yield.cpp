@@ -0,0 +1,244 @@
+//
+// this_thread_should_yield.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/this_thread_should_yield.hpp"
+
+#include <functional>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CO_AWAIT)
+# include "asio/co_spawn.hpp"
+# include "asio/detached.hpp"
+# include "asio/this_coro.hpp"
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+using namespace asio;
+
+namespace bindns = std;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+// Runs until asked to yield, or for at most one second.
+void run_until_should_yield(int* count, bool* yielded, int* count_on_yield)
+{
+  chrono::steady_clock::time_point end
+    = chrono::steady_clock::now() + chrono::seconds(1);
+
+  // A handler that has only just started has time left.
+  ASIO_CHECK(!this_thread_should_yield(chrono::milliseconds(1)));
+
+  while (chrono::steady_clock::now() < end)
+  {
+    if (this_thread_should_yield(chrono::milliseconds(1)))
+    {
+      *yielded = true;
+      *count_on_yield = *count;
+      return;
+    }
+  }
+}
+
+// Spins for the given time, recording whether it was asked to yield.
+void spin_checking_should_yield(chrono::steady_clock::duration d,
+    bool* yielded)
+{
+  chrono::steady_clock::time_point end = chrono::steady_clock::now() + d;
+  do
+  {
+    if (this_thread_should_yield(chrono::milliseconds(1)))
+      *yielded = true;
+  } while (chrono::steady_clock::now() < end);
+}
+
+// Posts a handler, then spins without asking.
+void post_and_spin_without_asking(io_context* ioc, int* count)
+{
+  asio::post(*ioc, bindns::bind(increment, count));
+  chrono::steady_clock::time_point end
+    = chrono::steady_clock::now() + chrono::milliseconds(5);
+  while (chrono::steady_clock::now() < end) {}
+}
+
+// Asks once, recording whether it was asked to yield.
+void check_should_yield_once(bool* yielded)
+{
+  *yielded = this_thread_should_yield(chrono::milliseconds(1));
+}
+
+// Spins for long enough that any clock used to record the start of a handler
+// shows the time allowed has passed, and only then asks.
+void spin_then_check_should_yield_once(bool* yielded)
+{
+  chrono::steady_clock::time_point end
+    = chrono::steady_clock::now() + chrono::milliseconds(2);
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+  end += 2 * chrono::microseconds(
+      static_cast<long long>(asio::detail::coarse_clock::resolution()));
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+  while (chrono::steady_clock::now() < end) {}
+  check_should_yield_once(yielded);
+}
+
+void post_and_spin(io_context* ioc, int* count, bool* yielded)
+{
+  asio::post(*ioc, bindns::bind(increment, count));
+  spin_checking_should_yield(chrono::milliseconds(5), yielded);
+}
+
+void this_thread_should_yield_test()
+{
+  // There is no handler to yield outside of a thread context.
+  ASIO_CHECK(!this_thread_should_yield());
+
+  // A handler is asked to yield once its time has run out while another
+  // handler is waiting.
+  io_context ioc;
+  int count = 0;
+  bool yielded = false;
+  int count_on_yield = -1;
+  asio::post(ioc, bindns::bind(run_until_should_yield,
+        &count, &yielded, &count_on_yield));
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+
+  ASIO_CHECK(yielded);
+  ASIO_CHECK(count_on_yield == 0);
+  ASIO_CHECK(count == 1);
+
+  // A handler is not asked to yield when nothing else is waiting.
+  ioc.restart();
+  yielded = false;
+  asio::post(ioc, bindns::bind(run_until_should_yield,
+        &count, &yielded, &count_on_yield));
+  ioc.run();
+
+  ASIO_CHECK(!yielded);
+
+  // The reactor task is not waiting work, even though it is queued while a
+  // handler runs.
+  ioc.restart();
+  ip::tcp::socket socket(ioc);
+  socket.open(ip::tcp::v4());
+  yielded = false;
+  asio::post(ioc, bindns::bind(spin_checking_should_yield,
+        chrono::milliseconds(5), &yielded));
+  ioc.run();
+
+  ASIO_CHECK(!yielded);
+
+  // A handler posted by the running handler to a single-threaded io_context
+  // is waiting work.
+  io_context ioc2(1);
+  count = 0;
+  yielded = false;
+  asio::post(ioc2, bindns::bind(post_and_spin, &ioc2, &count, &yielded));
+  ioc2.run();
+
+  ASIO_CHECK(yielded);
+  ASIO_CHECK(count == 1);
+
+  // Handlers run one after another by a strand are measured separately. The
+  // last two handlers are run by the same invoker.
+  ioc.restart();
+  count = 0;
+  strand<io_context::executor_type> s(ioc.get_executor());
+  yielded = true;
+  asio::post(s, bindns::bind(increment, &count));
+  asio::post(s, bindns::bind(post_and_spin_without_asking, &ioc, &count));
+  asio::post(s, bindns::bind(check_should_yield_once, &yielded));
+  ioc.run();
+
+  ASIO_CHECK(!yielded);
+  ASIO_CHECK(count == 2);
+
+  // Unless the start of each handler is recorded, the running time is
+  // measured from the handler's first call.
+  ioc.restart();
+  count = 0;
+  yielded = false;
+  asio::post(ioc, bindns::bind(spin_then_check_should_yield_once, &yielded));
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+
+#if defined(ASIO_HAS_HANDLER_START_TIME)
+  if (asio::detail::coarse_clock::now() != 0)
+    ASIO_CHECK(yielded);
+#else // defined(ASIO_HAS_HANDLER_START_TIME)
+  ASIO_CHECK(!yielded);
+#endif // defined(ASIO_HAS_HANDLER_START_TIME)
+  ASIO_CHECK(count == 1);
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+awaitable<void> process_batch(int* count, int* count_at_end)
+{
+  // Each item takes long enough that the coroutine yields several times.
+  for (int i = 0; i < 20; ++i)
+  {
+    chrono::steady_clock::time_point end
+      = chrono::steady_clock::now() + chrono::microseconds(500);
+    while (chrono::steady_clock::now() < end) {}
+
+    co_await this_coro::yield_if_needed;
+  }
+
+  *count_at_end = *count;
+}
+
+void yield_if_needed_test()
+{
+  io_context ioc;
+  int count = 0;
+  int count_at_end = -1;
+
+  co_spawn(ioc, process_batch(&count, &count_at_end), detached);
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+
+  // The waiting handler ran before the batch was finished.
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(count_at_end == 1);
+
+  // Without other work the batch is still completed.
+  ioc.restart();
+  co_spawn(ioc, process_batch(&count, &count_at_end), detached);
+  ioc.run();
+
+  ASIO_CHECK(count_at_end == 1);
+}
+
+#else // defined(ASIO_HAS_CO_AWAIT)
+
+void yield_if_needed_test()
+{
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+ASIO_TEST_SUITE
+(
+  "this_thread_should_yield",
+  ASIO_TEST_CASE(this_thread_should_yield_test)
+  ASIO_TEST_CASE(yield_if_needed_test)
+)
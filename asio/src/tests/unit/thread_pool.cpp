@@ -16,8 +16,14 @@
 // Test that header file is self-contained.
 #include "asio/thread_pool.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <stdexcept>
+#include <thread>
+#include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
+#include "asio/io_context.hpp"
 #include "asio/post.hpp"
 #include "unit_test.hpp"
 
@@ -273,6 +279,252 @@ void thread_pool_executor_execute_test()
   ASIO_CHECK(count == 10);
 }
 
+// Blocks until the specified number of functions are running at once, or until
+// a timeout expires.
+void wait_for_running(std::atomic<int>* running, int target, bool* all_ran)
+{
+  ++(*running);
+  std::chrono::steady_clock::time_point deadline
+    = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (*running < target && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  if (*running >= target)
+    *all_ran = true;
+}
+
+// Waits until the pool has the specified number of threads, or until a
+// timeout expires.
+bool wait_for_num_threads(thread_pool& pool, std::size_t n)
+{
+  std::chrono::steady_clock::time_point deadline
+    = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (pool.num_threads() != n
+      && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return pool.num_threads() == n;
+}
+
+void thread_pool_elastic_test()
+{
+  thread_pool pool(1, 4, std::chrono::milliseconds(5),
+      std::chrono::milliseconds(50));
+
+  ASIO_CHECK(pool.num_threads() == 1);
+
+  // Each function blocks until all four are running, so the pool must grow
+  // for any of them to complete.
+  std::atomic<int> running(0);
+  bool all_ran[4] = { false, false, false, false };
+  for (int i = 0; i < 4; ++i)
+    asio::post(pool, bindns::bind(wait_for_running, &running, 4, &all_ran[i]));
+
+  ASIO_CHECK(wait_for_num_threads(pool, 4));
+
+  // The added threads exit once they have been idle for the timeout.
+  ASIO_CHECK(wait_for_num_threads(pool, 1));
+
+  pool.join();
+
+  ASIO_CHECK(all_ran[0]);
+  ASIO_CHECK(all_ran[1]);
+  ASIO_CHECK(all_ran[2]);
+  ASIO_CHECK(all_ran[3]);
+  ASIO_CHECK(pool.num_threads() == 0);
+}
+
+void thread_pool_elastic_limits_test()
+{
+  // A pool without a minimum number of threads adds one to run queued work.
+  thread_pool pool1(0, 2, std::chrono::milliseconds(5),
+      std::chrono::milliseconds(50));
+  ASIO_CHECK(pool1.num_threads() == 0);
+
+  int count = 0;
+  asio::post(pool1, bindns::bind(increment, &count));
+  pool1.join();
+  ASIO_CHECK(count == 1);
+
+  // The pool never grows beyond the maximum number of threads.
+  thread_pool pool2(1, 2, std::chrono::milliseconds(5),
+      std::chrono::seconds(10));
+
+  std::atomic<int> running(0);
+  bool all_ran[3] = { false, false, false };
+  for (int i = 0; i < 2; ++i)
+    asio::post(pool2, bindns::bind(wait_for_running, &running, 2, &all_ran[i]));
+  asio::post(pool2, bindns::bind(wait_for_running, &running, 0, &all_ran[2]));
+
+  ASIO_CHECK(wait_for_num_threads(pool2, 2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASIO_CHECK(pool2.num_threads() == 2);
+
+  pool2.join();
+  ASIO_CHECK(all_ran[0]);
+  ASIO_CHECK(all_ran[1]);
+  ASIO_CHECK(all_ran[2]);
+
+  // Stopping the pool does not wait for queued work.
+  thread_pool pool3(1, 2);
+  pool3.stop();
+  asio::post(pool3, bindns::bind(increment, &count));
+  pool3.join();
+  ASIO_CHECK(count == 1);
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  bool caught = false;
+  try
+  {
+    thread_pool pool4(2, 1);
+  }
+  catch (const std::out_of_range&)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    thread_pool pool5(0, 0);
+  }
+  catch (const std::out_of_range&)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+void set_flag(std::atomic<int>* flags, std::size_t i)
+{
+  flags[i] += 1;
+}
+
+void record_completion(thread_pool* pool, bool* in_pool,
+    int* count, std::exception_ptr e)
+{
+  ASIO_CHECK(!e);
+  *in_pool = pool->get_executor().running_in_this_thread();
+  ++(*count);
+}
+
+void increment_without_exception(int* count, std::exception_ptr e)
+{
+  ASIO_CHECK(!e);
+  ++(*count);
+}
+
+void thread_pool_bulk_execute_test()
+{
+  thread_pool pool(4);
+
+  std::atomic<int> flags[1000];
+  for (int i = 0; i < 1000; ++i)
+    flags[i] = 0;
+  bool in_pool = false;
+  int completions = 0;
+
+  pool.executor().bulk_execute(1000,
+      bindns::bind(set_flag, flags, bindns::placeholders::_1),
+      bindns::bind(record_completion, &pool,
+        &in_pool, &completions, bindns::placeholders::_1));
+
+  // An empty range completes the handler without calling the function.
+  std::atomic<int> unused_flag(0);
+  bool empty_in_pool = false;
+  int empty_completions = 0;
+  pool.executor().bulk_execute(0,
+      bindns::bind(set_flag, &unused_flag, bindns::placeholders::_1),
+      bindns::bind(record_completion, &pool, &empty_in_pool,
+        &empty_completions, bindns::placeholders::_1));
+
+  // The handler is completed using its associated executor.
+  asio::io_context ctx(1);
+  std::atomic<int> other_flags[10];
+  for (int i = 0; i < 10; ++i)
+    other_flags[i] = 0;
+  int ctx_completions = 0;
+  pool.executor().bulk_execute(10,
+      bindns::bind(set_flag, other_flags, bindns::placeholders::_1),
+      asio::bind_executor(ctx,
+        bindns::bind(increment_without_exception,
+          &ctx_completions, bindns::placeholders::_1)));
+
+  pool.wait();
+
+  bool all_once = true;
+  for (int i = 0; i < 1000; ++i)
+    if (flags[i] != 1)
+      all_once = false;
+  ASIO_CHECK(all_once);
+  ASIO_CHECK(in_pool);
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(unused_flag == 0);
+  ASIO_CHECK(empty_in_pool);
+  ASIO_CHECK(empty_completions == 1);
+
+  all_once = true;
+  for (int i = 0; i < 10; ++i)
+    if (other_flags[i] != 1)
+      all_once = false;
+  ASIO_CHECK(all_once);
+  ASIO_CHECK(ctx_completions == 0);
+
+  ctx.run();
+  ASIO_CHECK(ctx_completions == 1);
+}
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+
+void set_flag_or_throw(std::atomic<int>* flags, std::size_t i)
+{
+  if (i == 100)
+    throw std::runtime_error("bulk");
+  flags[i] += 1;
+}
+
+void record_exception(std::exception_ptr* out, int* count, std::exception_ptr e)
+{
+  *out = e;
+  ++(*count);
+}
+
+void thread_pool_bulk_execute_exception_test()
+{
+  thread_pool pool(4);
+
+  std::atomic<int> flags[1000];
+  for (int i = 0; i < 1000; ++i)
+    flags[i] = 0;
+  std::exception_ptr ex;
+  int completions = 0;
+
+  // An exception stops the remaining indices from being claimed, and is
+  // passed to the handler once the calls under way have returned.
+  pool.executor().bulk_execute(1000,
+      bindns::bind(set_flag_or_throw, flags, bindns::placeholders::_1),
+      bindns::bind(record_exception, &ex,
+        &completions, bindns::placeholders::_1));
+
+  pool.wait();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(flags[100] == 0);
+
+  bool caught = false;
+  try
+  {
+    std::rethrow_exception(ex);
+  }
+  catch (const std::runtime_error&)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+}
+
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+
 ASIO_TEST_SUITE
 (
   "thread_pool",
@@ -280,4 +532,10 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(thread_pool_service_test)
   ASIO_TEST_CASE(thread_pool_executor_query_test)
   ASIO_TEST_CASE(thread_pool_executor_execute_test)
+  ASIO_TEST_CASE(thread_pool_elastic_test)
+  ASIO_TEST_CASE(thread_pool_elastic_limits_test)
+  ASIO_TEST_CASE(thread_pool_bulk_execute_test)
+#if !defined(ASIO_NO_EXCEPTIONS)
+  ASIO_TEST_CASE(thread_pool_bulk_execute_exception_test)
+#endif // !defined(ASIO_NO_EXCEPTIONS)
 )
@@ -21,6 +21,7 @@
 #include <functional>
 #include <vector>
 #include "archetypes/async_result.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/io_context.hpp"
 #include "asio/post.hpp"
 #include "asio/streambuf.hpp"
@@ -4794,6 +4795,116 @@ void test_4_arg_streambuf_async_write()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(int* allocations, int* in_use)
+    : allocations_(allocations),
+      in_use_(in_use)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : allocations_(other.allocations_),
+      in_use_(other.in_use_)
+  {
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return allocations_ == other.allocations_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return allocations_ != other.allocations_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++*allocations_;
+    ++*in_use_;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --*in_use_;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  int* allocations_;
+  int* in_use_;
+};
+
+void test_async_write_allocations()
+{
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  std::vector<asio::const_buffer> buffers;
+  for (int i = 0; i < 64; ++i)
+    buffers.push_back(asio::buffer(write_data + i % 40, 10));
+
+  // The first write of this type learns how much memory the intermediate
+  // operations need, and caches it for reuse across all steps.
+  int allocations = 0;
+  int in_use = 0;
+  s.reset();
+  s.next_write_length(7);
+  bool called = false;
+  asio::async_write(s, buffers,
+      asio::bind_allocator(counting_allocator<void>(&allocations, &in_use),
+        bindns::bind(async_write_handler,
+          _1, _2, 640, &called)));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 640));
+  ASIO_CHECK(allocations == 2);
+  ASIO_CHECK(in_use == 0);
+
+  // Later writes make a single allocation for the whole transfer.
+  allocations = 0;
+  s.reset();
+  s.next_write_length(7);
+  called = false;
+  asio::async_write(s, buffers,
+      asio::bind_allocator(counting_allocator<void>(&allocations, &in_use),
+        bindns::bind(async_write_handler,
+          _1, _2, 640, &called)));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 640));
+  ASIO_CHECK(allocations == 1);
+  ASIO_CHECK(in_use == 0);
+
+  // Memory is released if the operation is abandoned.
+  {
+    asio::io_context ioc2;
+    test_stream s2(ioc2);
+    s2.reset();
+    s2.next_write_length(7);
+    called = false;
+    asio::async_write(s2, buffers,
+        asio::bind_allocator(counting_allocator<void>(&allocations, &in_use),
+          bindns::bind(async_write_handler,
+            _1, _2, 640, &called)));
+    ioc2.run_one();
+    ASIO_CHECK(!called);
+    ASIO_CHECK(in_use > 0);
+  }
+  ASIO_CHECK(in_use == 0);
+}
+
 ASIO_TEST_SUITE
 (
   "write",
@@ -4829,4 +4940,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_4_arg_vector_buffers_async_write)
   ASIO_TEST_CASE(test_4_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_4_arg_streambuf_async_write)
+  ASIO_TEST_CASE(test_async_write_allocations)
 )